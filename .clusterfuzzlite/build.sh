@@ -11,3 +11,11 @@ $CXX $CFLAGS $LIB_FUZZING_ENGINE -stdlib=libc++ \
   -o $OUT/parser_fuzzer \
   -I$SRC/openddl-parser/include \
   $SRC/openddl-parser/build/lib/libopenddlparser.a
+
+$CXX $CXXFLAGS $LIB_FUZZING_ENGINE -stdlib=libc++ \
+  $SRC/openddl-parser/.clusterfuzzlite/parser_budget_fuzzer.cpp \
+  $SRC/openddl-parser/bench/ParseBudget.cpp \
+  -o $OUT/parser_budget_fuzzer \
+  -I$SRC/openddl-parser/include \
+  -I$SRC/openddl-parser/bench \
+  $SRC/openddl-parser/build/lib/libopenddlparser.a
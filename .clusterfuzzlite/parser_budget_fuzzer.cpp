@@ -0,0 +1,46 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2023 Openddl-parser authors.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+
+#include "ParseBudget.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+USE_ODDLPARSER_NS;
+
+// fails for inputs, which need super-linear time or allocations, see openddlparser_fuzzreplay
+extern "C" int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static const ParseBudget budget;
+    ParseBudget::Measurement measurement(budget.measure((const char *)data, size));
+    if (budget.isExceeded(measurement)) {
+        // measure again, so a busy machine does not cause a finding
+        measurement = budget.measure((const char *)data, size, 3);
+        if (budget.isExceeded(measurement)) {
+            fprintf(stderr, "Parse budget exceeded: %s\n", budget.describe(measurement).c_str());
+            abort();
+        }
+    }
+
+    return 0;
+}
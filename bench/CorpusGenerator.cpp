@@ -0,0 +1,295 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "CorpusGenerator.h"
+
+#include <openddlparser/OpenDDLFormat.h>
+#include <openddlparser/OpenDDLStream.h>
+
+#include <cstring>
+
+BEGIN_ODDLPARSER_NS
+
+static const char *ShapeNames[CorpusGenerator::NumShapes] = {
+    "mixed",
+    "deep",
+    "wide",
+    "arrays",
+    "small",
+    "comments",
+    "references",
+    "strings"
+};
+
+// the number of references to earlier structures
+static const size_t NumReferenceTargets = 64;
+
+const size_t CorpusGenerator::BlockSize;
+
+CorpusGenerator::CorpusGenerator(uint64 seed) :
+        m_seed(seed),
+        m_state(seed),
+        m_maxDepth(64),
+        m_size(0),
+        m_written(0),
+        m_numStructures(0),
+        m_stream(nullptr),
+        m_error(false),
+        m_buffer() {
+    // empty
+}
+
+void CorpusGenerator::setMaxDepth(size_t depth) {
+    m_maxDepth = depth > 0 ? depth : 1;
+}
+
+bool CorpusGenerator::generate(Shape shape, uint64 size, IOStreamBase &stream) {
+    m_state = m_seed;
+    m_size = size;
+    m_written = 0;
+    m_numStructures = 0;
+    m_stream = &stream;
+    m_error = false;
+    m_buffer.clear();
+    m_buffer.reserve(BlockSize + BlockSize / 4);
+
+    // the parser expects the text to start with an identifier
+    write("// generated by openddlparser_corpusgen\n");
+    for (size_t i = 0; i < NumReferenceTargets; ++i) {
+        write("Metric $target");
+        writeNumber(i);
+        write(" (key = \"target\") {float {");
+        writeFloat();
+        write("}}\n");
+    }
+    while (!m_error && !isFull()) {
+        generateBlock(shape);
+    }
+    flush();
+    m_stream = nullptr;
+
+    return !m_error;
+}
+
+uint64 CorpusGenerator::getBytesWritten() const {
+    return m_written;
+}
+
+const char *CorpusGenerator::getShapeName(Shape shape) {
+    if (shape >= NumShapes) {
+        return "";
+    }
+
+    return ShapeNames[shape];
+}
+
+bool CorpusGenerator::findShape(const std::string &name, Shape &shape) {
+    for (size_t i = 0; i < NumShapes; ++i) {
+        if (name == ShapeNames[i]) {
+            shape = static_cast<Shape>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CorpusGenerator::generateBlock(Shape shape) {
+    const bool mixed(Mixed == shape);
+    if (mixed) {
+        shape = static_cast<Shape>(1 + nextRandom(NumShapes - 1));
+    }
+
+    ++m_numStructures;
+    switch (shape) {
+        case Deep:
+            writeDeep(0);
+            break;
+        case Wide:
+            // in a mix the big structures are kept smaller
+            writeWide(mixed ? 10 + nextRandom(1000) : 1000 + nextRandom(9000));
+            break;
+        case Arrays:
+            writeArray(mixed ? 100 + nextRandom(5000) : 10000 + nextRandom(990000));
+            break;
+        case Comments:
+            writeCommented();
+            break;
+        case References:
+            writeReferences();
+            break;
+        case Strings:
+            writeString();
+            break;
+        default:
+            writeSmall();
+            break;
+    }
+}
+
+void CorpusGenerator::writeDeep(size_t depth) {
+    // the parser does not support data and structures side by side, the data gets an own structure
+    writeIndent(depth);
+    write("Node $deep");
+    writeNumber(m_numStructures);
+    write("_");
+    writeNumber(depth);
+    write("\n");
+    writeIndent(depth);
+    write("{\n");
+    writeIndent(depth + 1);
+    write("Level {int32 {");
+    writeNumber(depth);
+    write("}}\n");
+    if (depth + 1 < m_maxDepth) {
+        writeDeep(depth + 1);
+    }
+    writeIndent(depth);
+    write("}\n");
+}
+
+void CorpusGenerator::writeWide(size_t numChildren) {
+    // the children are limited by the size, so one structure does not exceed it much
+    write("Group $wide");
+    writeNumber(m_numStructures);
+    write("\n{\n");
+    for (size_t i = 0; i < numChildren && !isFull(); ++i) {
+        write("\tItem {unsigned_int32 {");
+        writeNumber(i);
+        write("}}\n");
+    }
+    write("}\n");
+}
+
+void CorpusGenerator::writeArray(size_t numVertices) {
+    write("VertexArray (attrib = \"position\")\n{\n\tfloat[3]\n\t{\n\t\t");
+    for (size_t i = 0; i < numVertices && !isFull(); ++i) {
+        if (0 != i) {
+            // the parser expects the comma right behind the closing bracket
+            write(7 == i % 8 ? ",\n\t\t" : ", ");
+        }
+        write("{");
+        writeFloat();
+        write(", ");
+        writeFloat();
+        write(", ");
+        writeFloat();
+        write("}");
+    }
+    write("\n\t}\n}\n");
+}
+
+void CorpusGenerator::writeSmall() {
+    write("Metric (key = \"distance\") {float {");
+    writeFloat();
+    write("}}\n");
+}
+
+void CorpusGenerator::writeCommented() {
+    write("/* block comment ");
+    writeNumber(m_numStructures);
+    write("\n   spanning several lines\n   of text */\n");
+    write("Metric (key = \"angle\") {float {");
+    writeFloat();
+    write("}} // trailing comment\n");
+    write("// a comment line before the next structure\n");
+}
+
+void CorpusGenerator::writeReferences() {
+    write("GeometryNode $node");
+    writeNumber(m_numStructures);
+    write("\n{\n\tObjectRef {ref {$target");
+    writeNumber(nextRandom(NumReferenceTargets));
+    write("}}\n\tMaterialRef (index = 0) {ref {");
+    const size_t numRefs(1 + nextRandom(8));
+    for (size_t i = 0; i < numRefs; ++i) {
+        write(0 == i ? "$target" : ", $target");
+        writeNumber(nextRandom(NumReferenceTargets));
+    }
+    write("}}\n}\n");
+}
+
+void CorpusGenerator::writeString() {
+    static const char Alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .-_";
+    write("Name {string {\"");
+    const size_t len(100 + nextRandom(4000));
+    for (size_t i = 0; i < len; ++i) {
+        m_buffer.push_back(Alphabet[nextRandom(sizeof(Alphabet) - 1)]);
+    }
+    write("\"}}\n");
+}
+
+void CorpusGenerator::write(const char *text) {
+    m_buffer.append(text);
+    if (m_buffer.size() >= BlockSize) {
+        flush();
+    }
+}
+
+void CorpusGenerator::writeNumber(uint64 value) {
+    char buffer[FormatBufferSize];
+    m_buffer.append(buffer, formatUInt64(value, buffer));
+}
+
+void CorpusGenerator::writeFloat() {
+    // two decimals between -1000 and 1000
+    const float value(static_cast<float>(static_cast<int>(nextRandom(200000)) - 100000) / 100.0f);
+    char buffer[FormatBufferSize];
+    m_buffer.append(buffer, formatFloat(value, buffer));
+}
+
+void CorpusGenerator::writeIndent(size_t level) {
+    m_buffer.append(level, '\t');
+}
+
+bool CorpusGenerator::isFull() const {
+    return m_written + m_buffer.size() >= m_size;
+}
+
+bool CorpusGenerator::flush() {
+    if (m_buffer.empty() || m_error) {
+        return !m_error;
+    }
+
+    if (m_stream->write(m_buffer.c_str(), m_buffer.size()) != m_buffer.size()) {
+        m_error = true;
+    }
+    m_written += m_buffer.size();
+    m_buffer.clear();
+
+    return !m_error;
+}
+
+uint64 CorpusGenerator::nextRandom() {
+    // splitmix64, the sequence is the same on all platforms
+    uint64 z(m_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+    return z ^ (z >> 31);
+}
+
+size_t CorpusGenerator::nextRandom(size_t limit) {
+    return static_cast<size_t>(nextRandom() % limit);
+}
+
+END_ODDLPARSER_NS
@@ -0,0 +1,117 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+#include <string>
+
+BEGIN_ODDLPARSER_NS
+
+class IOStreamBase;
+
+//-------------------------------------------------------------------------------------------------
+///	@brief  Generates synthetic OpenDDL documents for benchmarks.
+///
+/// The output only depends on the seed, the shape and the size. It is written in blocks into a
+/// stream, so documents much bigger than the memory can be generated.
+//-------------------------------------------------------------------------------------------------
+class CorpusGenerator {
+public:
+    ///	@brief  The shapes of the generated documents.
+    enum Shape {
+        Mixed = 0, ///< A mix of all other shapes
+        Deep, ///< Deeply nested structures
+        Wide, ///< Structures with very many children
+        Arrays, ///< Huge float[3] arrays
+        Small, ///< Many small structures
+        Comments, ///< Small structures with heavy comments
+        References, ///< Many references between structures
+        Strings, ///< Long strings
+        NumShapes
+    };
+
+    ///	@brief  The size of the blocks written into the stream.
+    static const size_t BlockSize = 256 * 1024;
+
+    ///	@brief  The class constructor.
+    /// @param  seed        [in] The seed of the random numbers.
+    explicit CorpusGenerator(uint64 seed);
+
+    ///	@brief  Sets the deepest nesting of the deep shape.
+    /// @param  depth       [in] The nesting depth, at least 1.
+    void setMaxDepth(size_t depth);
+
+    ///	@brief  Generates a document, it gets at least the requested size.
+    /// @param  shape       [in] The shape of the document.
+    /// @param  size        [in] The size in bytes, the last structure is completed.
+    /// @param  stream      [in] The stream to write into.
+    /// @return true in case of success, false if the stream failed.
+    bool generate(Shape shape, uint64 size, IOStreamBase &stream);
+
+    ///	@brief  Returns the bytes written by the last generate call.
+    /// @return The written bytes.
+    uint64 getBytesWritten() const;
+
+    ///	@brief  Returns the name of a shape.
+    /// @param  shape       [in] The shape.
+    /// @return The name.
+    static const char *getShapeName(Shape shape);
+
+    ///	@brief  Looks up a shape by its name.
+    /// @param  name        [in] The name.
+    /// @param  shape       [out] The shape.
+    /// @return true, if the name is known.
+    static bool findShape(const std::string &name, Shape &shape);
+
+private:
+    void generateBlock(Shape shape);
+    void writeDeep(size_t depth);
+    void writeWide(size_t numChildren);
+    void writeArray(size_t numVertices);
+    void writeSmall();
+    void writeCommented();
+    void writeReferences();
+    void writeString();
+    void write(const char *text);
+    void writeNumber(uint64 value);
+    void writeFloat();
+    void writeIndent(size_t level);
+    bool isFull() const;
+    bool flush();
+    uint64 nextRandom();
+    size_t nextRandom(size_t limit);
+
+private:
+    uint64 m_seed;
+    uint64 m_state;
+    size_t m_maxDepth;
+    uint64 m_size;
+    uint64 m_written;
+    uint64 m_numStructures;
+    IOStreamBase *m_stream;
+    bool m_error;
+    std::string m_buffer;
+};
+
+END_ODDLPARSER_NS
@@ -0,0 +1,132 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "ParseBudget.h"
+
+#include <openddlparser/OpenDDLParser.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+BEGIN_ODDLPARSER_NS
+
+ParseBudget::ParseBudget() :
+        m_baseSeconds(0.01),
+        m_nsPerByte(2000.0),
+        m_baseAllocations(64),
+        m_allocationsPerByte(2.0) {
+    // empty
+}
+
+void ParseBudget::setTimeBudget(double baseSeconds, double nsPerByte) {
+    m_baseSeconds = baseSeconds;
+    m_nsPerByte = nsPerByte;
+}
+
+void ParseBudget::setAllocationBudget(size_t baseAllocations, double perByte) {
+    m_baseAllocations = baseAllocations;
+    m_allocationsPerByte = perByte;
+}
+
+ParseBudget::Measurement ParseBudget::measure(const char *data, size_t len, size_t repetitions) const {
+    Measurement measurement;
+    measurement.m_size = len;
+    measurement.m_seconds = 0.0;
+    measurement.m_allocations = 0;
+    measurement.m_parsed = false;
+
+    OpenDDLParser parser;
+    parser.setParseStatsEnabled(true);
+    for (size_t i = 0; i < repetitions || 0 == i; ++i) {
+        const std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+        parser.setBuffer(data, len);
+        measurement.m_parsed = parser.parse();
+        const double seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        if (0 == i || seconds < measurement.m_seconds) {
+            measurement.m_seconds = seconds;
+        }
+        measurement.m_allocations = parser.getParseStats().getTotalCount();
+    }
+
+    return measurement;
+}
+
+bool ParseBudget::isTimeExceeded(const Measurement &measurement) const {
+    return measurement.m_seconds > m_baseSeconds + static_cast<double>(measurement.m_size) * m_nsPerByte * 1e-9;
+}
+
+bool ParseBudget::isAllocationExceeded(const Measurement &measurement) const {
+    return static_cast<double>(measurement.m_allocations) >
+           static_cast<double>(m_baseAllocations) + static_cast<double>(measurement.m_size) * m_allocationsPerByte;
+}
+
+bool ParseBudget::isExceeded(const Measurement &measurement) const {
+    return isTimeExceeded(measurement) || isAllocationExceeded(measurement);
+}
+
+bool ParseBudget::isFailing(const std::vector<char> &input, size_t repetitions, bool time, bool allocations) const {
+    const Measurement measurement(measure(input.empty() ? nullptr : &input[0], input.size(), repetitions));
+    return (time && isTimeExceeded(measurement)) || (allocations && isAllocationExceeded(measurement));
+}
+
+size_t ParseBudget::minimize(std::vector<char> &input, size_t repetitions) const {
+    // only the budgets exceeded by the original input have to stay exceeded
+    const Measurement original(measure(input.empty() ? nullptr : &input[0], input.size(), repetitions));
+    const bool time(isTimeExceeded(original)), allocations(isAllocationExceeded(original));
+    size_t numCandidates(1);
+    if (!time && !allocations) {
+        return numCandidates;
+    }
+
+    // remove chunks, starting with halves down to single bytes
+    std::vector<char> candidate;
+    for (size_t chunk = input.size() / 2; chunk > 0; chunk /= 2) {
+        size_t pos(0);
+        while (pos < input.size()) {
+            const size_t len(std::min(chunk, input.size() - pos));
+            candidate.assign(input.begin(), input.begin() + pos);
+            candidate.insert(candidate.end(), input.begin() + pos + len, input.end());
+            ++numCandidates;
+            if (isFailing(candidate, repetitions, time, allocations)) {
+                input.swap(candidate);
+            } else {
+                pos += len;
+            }
+        }
+    }
+
+    return numCandidates;
+}
+
+std::string ParseBudget::describe(const Measurement &measurement) const {
+    char text[256];
+    snprintf(text, sizeof(text), "%llu bytes, %s, %.3f ms (budget %.3f ms), %llu allocations (budget %.0f)",
+            static_cast<unsigned long long>(measurement.m_size), measurement.m_parsed ? "valid" : "invalid",
+            measurement.m_seconds * 1000.0, (m_baseSeconds + static_cast<double>(measurement.m_size) * m_nsPerByte * 1e-9) * 1000.0,
+            static_cast<unsigned long long>(measurement.m_allocations),
+            static_cast<double>(m_baseAllocations) + static_cast<double>(measurement.m_size) * m_allocationsPerByte);
+
+    return text;
+}
+
+END_ODDLPARSER_NS
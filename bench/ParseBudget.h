@@ -0,0 +1,100 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+#include <string>
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+//-------------------------------------------------------------------------------------------------
+///	@brief  Checks, that parsing an input stays linear in time and allocations.
+///
+/// Every input gets a fixed allowance plus an allowance per byte, so inputs which trigger
+/// super-linear work exceed the budget as soon as they get big enough. The allocations are the
+/// objects counted by the parse statistics ( @see ParseStats ), so they do not depend on the
+/// machine. Used by the budget fuzzer and by openddlparser_fuzzreplay.
+//-------------------------------------------------------------------------------------------------
+class ParseBudget {
+public:
+    ///	@brief  The result of parsing one input.
+    struct Measurement {
+        size_t m_size; ///< The size of the input.
+        double m_seconds; ///< The time of the fastest parse.
+        size_t m_allocations; ///< The number of allocated objects.
+        bool m_parsed; ///< true, if the input was valid.
+    };
+
+    ///	@brief  The default constructor, sets the default budget.
+    ParseBudget();
+
+    ///	@brief  Sets the time budget.
+    /// @param  baseSeconds     [in] The time allowed for every input.
+    /// @param  nsPerByte       [in] The time allowed per input byte in nanoseconds.
+    void setTimeBudget(double baseSeconds, double nsPerByte);
+
+    ///	@brief  Sets the allocation budget.
+    /// @param  baseAllocations [in] The allocations allowed for every input.
+    /// @param  perByte         [in] The allocations allowed per input byte.
+    void setAllocationBudget(size_t baseAllocations, double perByte);
+
+    ///	@brief  Parses an input and measures it.
+    /// @param  data            [in] The input.
+    /// @param  len             [in] The size of the input.
+    /// @param  repetitions     [in] The number of parses, the fastest one is reported.
+    /// @return The measurement.
+    Measurement measure(const char *data, size_t len, size_t repetitions = 1) const;
+
+    ///	@brief  Returns true, if the time budget was exceeded.
+    bool isTimeExceeded(const Measurement &measurement) const;
+
+    ///	@brief  Returns true, if the allocation budget was exceeded.
+    bool isAllocationExceeded(const Measurement &measurement) const;
+
+    ///	@brief  Returns true, if any budget was exceeded.
+    bool isExceeded(const Measurement &measurement) const;
+
+    ///	@brief  Removes parts of an input, as long as it still exceeds the budget.
+    /// @param  input           [inout] The input, will be replaced by the smallest one found.
+    /// @param  repetitions     [in] The number of parses per measurement.
+    /// @return The number of measured candidates.
+    size_t minimize(std::vector<char> &input, size_t repetitions) const;
+
+    ///	@brief  Describes a measurement and the budget for it.
+    /// @param  measurement     [in] The measurement.
+    /// @return The description.
+    std::string describe(const Measurement &measurement) const;
+
+private:
+    bool isFailing(const std::vector<char> &input, size_t repetitions, bool time, bool allocations) const;
+
+private:
+    double m_baseSeconds;
+    double m_nsPerByte;
+    size_t m_baseAllocations;
+    double m_allocationsPerByte;
+};
+
+END_ODDLPARSER_NS
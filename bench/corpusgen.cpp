@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "CorpusGenerator.h"
+
+#include <openddlparser/OpenDDLParser.h>
+#include <openddlparser/OpenDDLStream.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+USE_ODDLPARSER_NS
+
+static const char *OutputOption = "--output";
+static const char *SizeOption = "--size";
+static const char *ShapeOption = "--shape";
+static const char *SeedOption = "--seed";
+static const char *DepthOption = "--depth";
+static const char *HelpOption = "--help";
+static const int Error = -1;
+
+static void showhelp() {
+    std::cout << "OpenDDL Parser Corpus Generator version " << OpenDDLParser::getVersion() << std::endl
+              << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << "\topenddlparser_corpusgen --output <filename> [--size <size>] [--shape <shape>] [--seed <n>] [--depth <n>]" << std::endl
+              << std::endl;
+    std::cout << "Parameter:" << std::endl;
+    std::cout << "\t--output : The file to write, - writes to stdout." << std::endl;
+    std::cout << "\t--size   : The size of the document with the suffix K, M or G, default is 1M." << std::endl;
+    std::cout << "\t--shape  : The shape of the document, default is mixed. One of:" << std::endl;
+    std::cout << "\t          ";
+    for (size_t i = 0; i < CorpusGenerator::NumShapes; ++i) {
+        std::cout << " " << CorpusGenerator::getShapeName(static_cast<CorpusGenerator::Shape>(i));
+    }
+    std::cout << std::endl;
+    std::cout << "\t--seed   : The seed, the same seed generates the same document. Default is 1." << std::endl;
+    std::cout << "\t--depth  : The nesting depth of the deep shape, default is 64." << std::endl;
+}
+
+static bool parseSize(const char *text, uint64 &size) {
+    char *end(nullptr);
+    const unsigned long long value(::strtoull(text, &end, 10));
+    if (end == text) {
+        return false;
+    }
+
+    uint64 factor(1);
+    if ('\0' != *end) {
+        switch (*end) {
+            case 'k':
+            case 'K':
+                factor = 1024;
+                break;
+            case 'm':
+            case 'M':
+                factor = 1024 * 1024;
+                break;
+            case 'g':
+            case 'G':
+                factor = 1024 * 1024 * 1024;
+                break;
+            default:
+                return false;
+        }
+        if ('\0' != end[1]) {
+            return false;
+        }
+    }
+    size = static_cast<uint64>(value) * factor;
+
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    std::string output;
+    uint64 size(1024 * 1024), seed(1);
+    size_t depth(64);
+    CorpusGenerator::Shape shape(CorpusGenerator::Mixed);
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue(i + 1 < argc);
+        if (0 == strcmp(HelpOption, argv[i])) {
+            showhelp();
+            return 0;
+        } else if (0 == strcmp(OutputOption, argv[i]) && hasValue) {
+            output = argv[++i];
+        } else if (0 == strcmp(SizeOption, argv[i]) && hasValue) {
+            if (!parseSize(argv[++i], size)) {
+                std::cerr << "Invalid size " << argv[i] << std::endl;
+                return Error;
+            }
+        } else if (0 == strcmp(ShapeOption, argv[i]) && hasValue) {
+            if (!CorpusGenerator::findShape(argv[++i], shape)) {
+                std::cerr << "Unknown shape " << argv[i] << std::endl;
+                return Error;
+            }
+        } else if (0 == strcmp(SeedOption, argv[i]) && hasValue) {
+            seed = ::strtoull(argv[++i], nullptr, 10);
+        } else if (0 == strcmp(DepthOption, argv[i]) && hasValue) {
+            depth = static_cast<size_t>(::atoi(argv[++i]));
+        } else {
+            std::cerr << "Invalid parameter " << argv[i] << std::endl;
+            showhelp();
+            return Error;
+        }
+    }
+
+    if (output.empty()) {
+        showhelp();
+        return Error;
+    }
+
+    FileDescriptorStream stream(1, false);
+    if ("-" != output && !stream.open(output)) {
+        std::cerr << "Cannot open " << output << std::endl;
+        return Error;
+    }
+
+    CorpusGenerator generator(seed);
+    generator.setMaxDepth(depth);
+    if (!generator.generate(shape, size, stream) || !stream.close()) {
+        std::cerr << "Cannot write " << output << std::endl;
+        return Error;
+    }
+
+    return 0;
+}
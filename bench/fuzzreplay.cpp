@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "ParseBudget.h"
+
+#include <openddlparser/MemoryMappedFile.h>
+#include <openddlparser/OpenDDLParser.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+USE_ODDLPARSER_NS
+
+static const char *NsPerByteOption = "--ns-per-byte";
+static const char *BaseMsOption = "--base-ms";
+static const char *AllocsPerByteOption = "--allocs-per-byte";
+static const char *BaseAllocsOption = "--base-allocs";
+static const char *RepeatOption = "--repeat";
+static const char *MinimizeOption = "--minimize";
+static const char *HelpOption = "--help";
+static const int Error = -1;
+static const int BudgetExceeded = 1;
+
+static void showhelp() {
+    std::cout << "OpenDDL Parser Fuzz Replay version " << OpenDDLParser::getVersion() << std::endl
+              << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << "\topenddlparser_fuzzreplay [--ns-per-byte <n>] [--base-ms <n>] [--allocs-per-byte <n>] [--base-allocs <n>]" << std::endl;
+    std::cout << "\t                         [--repeat <n>] [--minimize <directory>] <file>..." << std::endl
+              << std::endl;
+    std::cout << "Parses every file and checks the time and the allocations against the budget." << std::endl
+              << std::endl;
+    std::cout << "Parameter:" << std::endl;
+    std::cout << "\t--ns-per-byte     : The time allowed per input byte in nanoseconds, default is 2000." << std::endl;
+    std::cout << "\t--base-ms         : The time allowed for every input in milliseconds, default is 10." << std::endl;
+    std::cout << "\t--allocs-per-byte : The allocations allowed per input byte, default is 2." << std::endl;
+    std::cout << "\t--base-allocs     : The allocations allowed for every input, default is 64." << std::endl;
+    std::cout << "\t--repeat          : The number of parses per input, the fastest counts. Default is 3." << std::endl;
+    std::cout << "\t--minimize        : Minimizes the inputs exceeding the budget and writes them into the directory." << std::endl;
+}
+
+static bool writeFile(const std::string &filename, const std::vector<char> &buffer) {
+    FILE *file(::fopen(filename.c_str(), "wb"));
+    if (nullptr == file) {
+        return false;
+    }
+    const bool ok(buffer.empty() || buffer.size() == ::fwrite(&buffer[0], 1, buffer.size(), file));
+    ::fclose(file);
+
+    return ok;
+}
+
+static std::string getBaseName(const std::string &filename) {
+    const size_t pos(filename.find_last_of("/\\"));
+    return std::string::npos == pos ? filename : filename.substr(pos + 1);
+}
+
+int main(int argc, char *argv[]) {
+    ParseBudget budget;
+    double nsPerByte(2000.0), baseMs(10.0), allocsPerByte(2.0);
+    size_t baseAllocs(64), repetitions(3);
+    std::string minimizeDirectory;
+    std::vector<std::string> filenames;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue(i + 1 < argc);
+        if (0 == strcmp(HelpOption, argv[i])) {
+            showhelp();
+            return 0;
+        } else if (0 == strcmp(NsPerByteOption, argv[i]) && hasValue) {
+            nsPerByte = ::atof(argv[++i]);
+        } else if (0 == strcmp(BaseMsOption, argv[i]) && hasValue) {
+            baseMs = ::atof(argv[++i]);
+        } else if (0 == strcmp(AllocsPerByteOption, argv[i]) && hasValue) {
+            allocsPerByte = ::atof(argv[++i]);
+        } else if (0 == strcmp(BaseAllocsOption, argv[i]) && hasValue) {
+            baseAllocs = static_cast<size_t>(::atol(argv[++i]));
+        } else if (0 == strcmp(RepeatOption, argv[i]) && hasValue) {
+            repetitions = static_cast<size_t>(std::max(1, ::atoi(argv[++i])));
+        } else if (0 == strcmp(MinimizeOption, argv[i]) && hasValue) {
+            minimizeDirectory = argv[++i];
+        } else if ('-' == argv[i][0] && '\0' != argv[i][1]) {
+            std::cerr << "Invalid parameter " << argv[i] << std::endl;
+            showhelp();
+            return Error;
+        } else {
+            filenames.push_back(argv[i]);
+        }
+    }
+    if (filenames.empty()) {
+        showhelp();
+        return Error;
+    }
+    budget.setTimeBudget(baseMs / 1000.0, nsPerByte);
+    budget.setAllocationBudget(baseAllocs, allocsPerByte);
+
+    size_t numExceeded(0);
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        std::vector<char> input;
+        if (!MemoryMappedFile::readFile(filenames[i], input)) {
+            std::cerr << "Cannot read " << filenames[i] << std::endl;
+            return Error;
+        }
+
+        const ParseBudget::Measurement measurement(budget.measure(input.empty() ? nullptr : &input[0], input.size(), repetitions));
+        const bool exceeded(budget.isExceeded(measurement));
+        std::cout << filenames[i] << ": " << budget.describe(measurement) << (exceeded ? "  EXCEEDED" : "") << std::endl;
+        if (!exceeded) {
+            continue;
+        }
+        ++numExceeded;
+
+        if (!minimizeDirectory.empty()) {
+            const size_t numCandidates(budget.minimize(input, repetitions));
+            const std::string minimized(minimizeDirectory + "/" + getBaseName(filenames[i]) + ".min");
+            if (!writeFile(minimized, input)) {
+                std::cerr << "Cannot write " << minimized << std::endl;
+                return Error;
+            }
+            const ParseBudget::Measurement result(budget.measure(input.empty() ? nullptr : &input[0], input.size(), repetitions));
+            std::cout << "  minimized with " << numCandidates << " candidates to " << minimized << ": " << budget.describe(result) << std::endl;
+        }
+    }
+
+    return numExceeded > 0 ? BudgetExceeded : 0;
+}
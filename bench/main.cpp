@@ -0,0 +1,589 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "CorpusGenerator.h"
+
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLExport.h>
+#include <openddlparser/OpenDDLFormat.h>
+#include <openddlparser/OpenDDLParser.h>
+#include <openddlparser/OpenDDLSnapshot.h>
+#include <openddlparser/OpenDDLStream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+USE_ODDLPARSER_NS
+
+// all allocations of the process are counted, including the ones of the library
+static std::atomic<size_t> s_numAllocations(0);
+static std::atomic<size_t> s_allocatedBytes(0);
+
+void *operator new(size_t size) {
+    ++s_numAllocations;
+    s_allocatedBytes += size;
+    void *ptr(::malloc(size > 0 ? size : 1));
+    if (nullptr == ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+    ::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    ::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    ::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    ::free(ptr);
+}
+
+static const char *FileOption = "--file";
+static const char *SizeOption = "--size";
+static const char *ShapeOption = "--shape";
+static const char *IterationsOption = "--iterations";
+static const char *JsonOption = "--json";
+static const char *BaselineOption = "--baseline";
+static const char *ToleranceOption = "--tolerance";
+static const char *ThresholdsOption = "--thresholds";
+static const char *CheckTimeOption = "--check-time";
+static const char *NoExampleOption = "--no-example";
+static const char *HelpOption = "--help";
+static const int Error = -1;
+static const int Regression = 1;
+
+struct Corpus {
+    std::string m_name;
+    std::string m_data;
+};
+
+struct BenchResult {
+    std::string m_name;
+    size_t m_bytes;
+    size_t m_nodes;
+    double m_seconds;
+    size_t m_allocations;
+    size_t m_allocatedBytes;
+    size_t m_peakRssKb;
+
+    double getMBPerSecond() const {
+        return m_seconds > 0.0 ? static_cast<double>(m_bytes) / (1024.0 * 1024.0) / m_seconds : 0.0;
+    }
+
+    double getNodesPerSecond() const {
+        return m_seconds > 0.0 ? static_cast<double>(m_nodes) / m_seconds : 0.0;
+    }
+};
+
+// the limits for one benchmark, read from the thresholds file
+struct Threshold {
+    std::string m_name;
+    size_t m_maxAllocations;
+    double m_minMBPerSecond;
+};
+
+typedef std::chrono::steady_clock BenchClock;
+
+static void showhelp() {
+    std::cout << "OpenDDL Parser Benchmark version " << OpenDDLParser::getVersion() << std::endl
+              << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << "\topenddlparser_bench [--file <filename>] [--size <MB>] [--shape <shape>] [--iterations <n>]" << std::endl;
+    std::cout << "\t                    [--json <filename>] [--baseline <filename>] [--tolerance <percent>]" << std::endl;
+    std::cout << "\t                    [--thresholds <filename>] [--check-time] [--no-example]" << std::endl
+              << std::endl;
+    std::cout << "Parameter:" << std::endl;
+    std::cout << "\t--file       : An additional file to benchmark, can be used several times." << std::endl;
+    std::cout << "\t--size       : The size of the generated corpora in MB, default is 16. 0 disables them." << std::endl;
+    std::cout << "\t--shape      : The shape of a generated corpus ( see openddlparser_corpusgen ), can be used" << std::endl;
+    std::cout << "\t               several times. Default is mixed." << std::endl;
+    std::cout << "\t--iterations : The number of runs per benchmark, the median is reported. Default is 5." << std::endl;
+    std::cout << "\t--json       : Writes the results as JSON into the file." << std::endl;
+    std::cout << "\t--baseline   : Compares the results against a JSON file written before." << std::endl;
+    std::cout << "\t--tolerance  : The allowed slowdown against the baseline in percent, default is 10." << std::endl;
+    std::cout << "\t--thresholds : Checks the allocation counts against the limits in the file." << std::endl;
+    std::cout << "\t--check-time : Checks the throughput against the limits in the thresholds file as well." << std::endl;
+    std::cout << "\t--no-example : Does not benchmark the example file." << std::endl;
+}
+
+static size_t getPeakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+    if (0 != ::getrusage(RUSAGE_SELF, &usage)) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+static bool readFile(const std::string &filename, std::string &content) {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+
+    return true;
+}
+
+static void traverse(const DDLNode *node, size_t &numNodes, size_t &numValues) {
+    ++numNodes;
+    for (Value *value(node->getValue()); nullptr != value; value = value->getNext()) {
+        ++numValues;
+    }
+    for (DataArrayList *list(node->getDataArrayList()); nullptr != list; list = list->m_next) {
+        for (Value *value(list->m_dataList); nullptr != value; value = value->getNext()) {
+            ++numValues;
+        }
+    }
+    const DDLNode::DllNodeList &children(node->getChildNodeList());
+    for (size_t i = 0; i < children.size(); ++i) {
+        traverse(children[i], numNodes, numValues);
+    }
+}
+
+static size_t countNodes(const Context *ctx) {
+    size_t numNodes(0), numValues(0);
+    if (nullptr != ctx && nullptr != ctx->m_root) {
+        traverse(ctx->m_root, numNodes, numValues);
+    }
+
+    return numNodes;
+}
+
+// runs the untimed setup and the timed operation for every iteration, reports the median
+template <class Setup, class Operation>
+static BenchResult runBenchmark(const std::string &name, size_t bytes, size_t nodes, size_t iterations, Setup setup, Operation operation) {
+    std::vector<double> times;
+    size_t allocations(0), allocatedBytes(0);
+    for (size_t i = 0; i < iterations; ++i) {
+        setup();
+        const size_t numAllocations(s_numAllocations.load()), numBytes(s_allocatedBytes.load());
+        const BenchClock::time_point start(BenchClock::now());
+        operation();
+        const double seconds(std::chrono::duration<double>(BenchClock::now() - start).count());
+        allocations = s_numAllocations.load() - numAllocations;
+        allocatedBytes = s_allocatedBytes.load() - numBytes;
+        times.push_back(seconds);
+    }
+    std::sort(times.begin(), times.end());
+
+    BenchResult result;
+    result.m_name = name;
+    result.m_bytes = bytes;
+    result.m_nodes = nodes;
+    result.m_seconds = times[times.size() / 2];
+    result.m_allocations = allocations;
+    result.m_allocatedBytes = allocatedBytes;
+    result.m_peakRssKb = getPeakRssKb();
+
+    return result;
+}
+
+static bool benchCorpus(const Corpus &corpus, size_t iterations, std::vector<BenchResult> &results) {
+    OpenDDLParser parser;
+    parser.setBuffer(corpus.m_data.c_str(), corpus.m_data.size());
+    if (!parser.parse()) {
+        std::cerr << "Cannot parse corpus " << corpus.m_name << "." << std::endl;
+        return false;
+    }
+    const size_t bytes(corpus.m_data.size()), nodes(countNodes(parser.getContext()));
+
+    results.push_back(runBenchmark("parse/" + corpus.m_name, bytes, nodes, iterations,
+            [&]() { parser.clear(); },
+            [&]() {
+                parser.setBuffer(corpus.m_data.c_str(), corpus.m_data.size());
+                parser.parse();
+            }));
+
+    std::string exported;
+    results.push_back(runBenchmark("export/" + corpus.m_name, bytes, nodes, iterations,
+            [&]() { exported.clear(); },
+            [&]() {
+                OpenDDLExport exporter(new MemoryStream(&exported));
+                exporter.exportContext(parser.getContext(), "");
+            }));
+
+    // loading the snapshot of the same tree, to be compared with the parse of the text
+    std::vector<char> snapshot;
+    if (!OpenDDLSnapshot::write(parser.getContext(), snapshot)) {
+        std::cerr << "Cannot write the snapshot of corpus " << corpus.m_name << "." << std::endl;
+        return false;
+    }
+    Context *loaded(nullptr);
+    results.push_back(runBenchmark("snapshot/" + corpus.m_name, bytes, nodes, iterations,
+            [&]() {
+                delete loaded;
+                loaded = nullptr;
+            },
+            [&]() { loaded = OpenDDLSnapshot::read(&snapshot[0], snapshot.size()); }));
+    delete loaded;
+
+    size_t numNodes(0), numValues(0);
+    results.push_back(runBenchmark("traverse/" + corpus.m_name, bytes, nodes, iterations,
+            [&]() { numNodes = numValues = 0; },
+            [&]() { traverse(parser.getRoot(), numNodes, numValues); }));
+
+    Context *ctx(nullptr);
+    results.push_back(runBenchmark("teardown/" + corpus.m_name, bytes, nodes, iterations,
+            [&]() {
+                parser.setBuffer(corpus.m_data.c_str(), corpus.m_data.size());
+                parser.parse();
+                ctx = parser.detachContext();
+            },
+            [&]() { delete ctx; }));
+
+    return true;
+}
+
+// formats random bit patterns, so all exponents and digit counts are covered. The node count is the
+// number of formatted values.
+template <class T, class Bits>
+static void benchFormat(const std::string &name, size_t (*format)(T, char *), size_t iterations, std::vector<BenchResult> &results) {
+    static const size_t NumValues = 1000000;
+    std::vector<T> values;
+    values.reserve(NumValues);
+    uint64 state(1);
+    while (values.size() < NumValues) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const Bits bits(static_cast<Bits>(state >> (64 - 8 * sizeof(Bits))));
+        T value;
+        ::memcpy(&value, &bits, sizeof(T));
+        if (value - value == 0) {
+            values.push_back(value);
+        }
+    }
+
+    char buffer[FormatBufferSize];
+    size_t bytes(0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        bytes += format(values[i], buffer);
+    }
+    results.push_back(runBenchmark(name, bytes, values.size(), iterations,
+            [&]() {},
+            [&]() {
+                for (size_t i = 0; i < values.size(); ++i) {
+                    format(values[i], buffer);
+                }
+            }));
+}
+
+static void printResults(const std::vector<BenchResult> &results) {
+    char line[256];
+    snprintf(line, sizeof(line), "%-28s %10s %14s %12s %14s %10s", "benchmark", "MB/s", "nodes/s", "allocations", "alloc. bytes", "RSS [KB]");
+    std::cout << line << std::endl;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r(results[i]);
+        snprintf(line, sizeof(line), "%-28s %10.2f %14.0f %12llu %14llu %10llu", r.m_name.c_str(), r.getMBPerSecond(), r.getNodesPerSecond(),
+                static_cast<unsigned long long>(r.m_allocations), static_cast<unsigned long long>(r.m_allocatedBytes),
+                static_cast<unsigned long long>(r.m_peakRssKb));
+        std::cout << line << std::endl;
+    }
+}
+
+static bool writeJson(const std::string &filename, const std::vector<BenchResult> &results) {
+    std::ofstream file(filename.c_str());
+    if (!file) {
+        return false;
+    }
+
+    file << "{\n  \"version\": \"" << OpenDDLParser::getVersion() << "\",\n";
+    file << "  \"peak_rss_kb\": " << getPeakRssKb() << ",\n";
+    file << "  \"results\": [\n";
+    char line[512];
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r(results[i]);
+        snprintf(line, sizeof(line),
+                "    { \"name\": \"%s\", \"bytes\": %llu, \"nodes\": %llu, \"seconds\": %.9f, \"mb_per_s\": %.3f, \"nodes_per_s\": %.1f, "
+                "\"allocations\": %llu, \"allocated_bytes\": %llu, \"peak_rss_kb\": %llu }%s\n",
+                r.m_name.c_str(), static_cast<unsigned long long>(r.m_bytes), static_cast<unsigned long long>(r.m_nodes), r.m_seconds,
+                r.getMBPerSecond(), r.getNodesPerSecond(), static_cast<unsigned long long>(r.m_allocations),
+                static_cast<unsigned long long>(r.m_allocatedBytes), static_cast<unsigned long long>(r.m_peakRssKb),
+                i + 1 < results.size() ? "," : "");
+        file << line;
+    }
+    file << "  ]\n}\n";
+
+    return file.good();
+}
+
+// reads the name and throughput of every result, the file was written by writeJson
+static bool readBaseline(const std::string &filename, std::vector<std::pair<std::string, double> > &baseline) {
+    std::string content;
+    if (!readFile(filename, content)) {
+        return false;
+    }
+
+    static const char NameKey[] = "\"name\": \"";
+    static const char ThroughputKey[] = "\"mb_per_s\": ";
+    size_t pos(0);
+    while (std::string::npos != (pos = content.find(NameKey, pos))) {
+        pos += strlen(NameKey);
+        const size_t nameEnd(content.find('"', pos));
+        const size_t throughput(content.find(ThroughputKey, pos));
+        if (std::string::npos == nameEnd || std::string::npos == throughput) {
+            return false;
+        }
+        baseline.push_back(std::make_pair(content.substr(pos, nameEnd - pos), ::atof(content.c_str() + throughput + strlen(ThroughputKey))));
+        pos = throughput;
+    }
+
+    return true;
+}
+
+static size_t compareBaseline(const std::vector<BenchResult> &results, const std::vector<std::pair<std::string, double> > &baseline, double tolerance) {
+    size_t numRegressions(0);
+    char line[256];
+    std::cout << std::endl
+              << "Compared to baseline ( tolerance " << tolerance << "% ):" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i) {
+        for (size_t j = 0; j < baseline.size(); ++j) {
+            if (baseline[j].first != results[i].m_name || baseline[j].second <= 0.0) {
+                continue;
+            }
+            const double change((results[i].getMBPerSecond() / baseline[j].second - 1.0) * 100.0);
+            const bool regression(change < -tolerance);
+            if (regression) {
+                ++numRegressions;
+            }
+            snprintf(line, sizeof(line), "%-28s %10.2f -> %10.2f MB/s %+7.1f%%%s", results[i].m_name.c_str(), baseline[j].second,
+                    results[i].getMBPerSecond(), change, regression ? "  REGRESSION" : "");
+            std::cout << line << std::endl;
+        }
+    }
+
+    return numRegressions;
+}
+
+// reads the lines "<benchmark> <max. allocations> <min. MB/s>", # starts a comment
+static bool readThresholds(const std::string &filename, std::vector<Threshold> &thresholds) {
+    std::ifstream file(filename.c_str());
+    if (!file) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t comment(line.find('#'));
+        if (std::string::npos != comment) {
+            line.erase(comment);
+        }
+        std::istringstream stream(line);
+        Threshold threshold;
+        if (!(stream >> threshold.m_name)) {
+            continue;
+        }
+        if (!(stream >> threshold.m_maxAllocations >> threshold.m_minMBPerSecond)) {
+            return false;
+        }
+        thresholds.push_back(threshold);
+    }
+
+    return true;
+}
+
+// the allocation counts are deterministic, the throughput depends on the machine and the build type
+static size_t checkThresholds(const std::vector<BenchResult> &results, const std::vector<Threshold> &thresholds, bool checkTime) {
+    size_t numFailures(0);
+    char line[256];
+    std::cout << std::endl
+              << "Checked against thresholds" << (checkTime ? "" : " ( allocations only )") << ":" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i) {
+        for (size_t j = 0; j < thresholds.size(); ++j) {
+            const Threshold &threshold(thresholds[j]);
+            if (threshold.m_name != results[i].m_name) {
+                continue;
+            }
+            const bool allocationsFailed(results[i].m_allocations > threshold.m_maxAllocations);
+            const bool timeFailed(checkTime && results[i].getMBPerSecond() < threshold.m_minMBPerSecond);
+            if (allocationsFailed || timeFailed) {
+                ++numFailures;
+            }
+            snprintf(line, sizeof(line), "%-28s %12llu / %12llu allocations%s %10.2f / %8.2f MB/s%s", results[i].m_name.c_str(),
+                    static_cast<unsigned long long>(results[i].m_allocations), static_cast<unsigned long long>(threshold.m_maxAllocations),
+                    allocationsFailed ? "  EXCEEDED" : "", results[i].getMBPerSecond(), threshold.m_minMBPerSecond,
+                    timeFailed ? "  TOO SLOW" : "");
+            std::cout << line << std::endl;
+        }
+    }
+
+    return numFailures;
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<Corpus> corpora;
+    std::vector<CorpusGenerator::Shape> shapes;
+    size_t generatedSize(16), iterations(5);
+    double tolerance(10.0);
+    bool checkTime(false), useExample(true);
+    std::string jsonFilename, baselineFilename, thresholdsFilename;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue(i + 1 < argc);
+        if (0 == strcmp(HelpOption, argv[i])) {
+            showhelp();
+            return 0;
+        } else if (0 == strcmp(FileOption, argv[i]) && hasValue) {
+            Corpus corpus;
+            corpus.m_name = argv[++i];
+            if (!readFile(corpus.m_name, corpus.m_data)) {
+                std::cerr << "Cannot read file " << corpus.m_name << std::endl;
+                return Error;
+            }
+            corpora.push_back(corpus);
+        } else if (0 == strcmp(SizeOption, argv[i]) && hasValue) {
+            generatedSize = static_cast<size_t>(::atoi(argv[++i]));
+        } else if (0 == strcmp(ShapeOption, argv[i]) && hasValue) {
+            CorpusGenerator::Shape shape;
+            if (!CorpusGenerator::findShape(argv[++i], shape)) {
+                std::cerr << "Unknown shape " << argv[i] << std::endl;
+                return Error;
+            }
+            shapes.push_back(shape);
+        } else if (0 == strcmp(IterationsOption, argv[i]) && hasValue) {
+            iterations = std::max(1, ::atoi(argv[++i]));
+        } else if (0 == strcmp(JsonOption, argv[i]) && hasValue) {
+            jsonFilename = argv[++i];
+        } else if (0 == strcmp(BaselineOption, argv[i]) && hasValue) {
+            baselineFilename = argv[++i];
+        } else if (0 == strcmp(ToleranceOption, argv[i]) && hasValue) {
+            tolerance = ::atof(argv[++i]);
+        } else if (0 == strcmp(ThresholdsOption, argv[i]) && hasValue) {
+            thresholdsFilename = argv[++i];
+        } else if (0 == strcmp(CheckTimeOption, argv[i])) {
+            checkTime = true;
+        } else if (0 == strcmp(NoExampleOption, argv[i])) {
+            useExample = false;
+        } else {
+            std::cerr << "Invalid parameter " << argv[i] << std::endl;
+            showhelp();
+            return Error;
+        }
+    }
+
+    // the small example is repeated, so the timings are not dominated by the clock resolution
+    Corpus example;
+    example.m_name = "example";
+    std::string content;
+    if (!useExample) {
+        // nothing to do
+    } else if (readFile(std::string(OPENDDL_BENCH_DATA) + "/Example.ogex", content)) {
+        for (size_t i = 0; i < 256; ++i) {
+            example.m_data += content;
+            example.m_data += "\n";
+        }
+        corpora.insert(corpora.begin(), example);
+    } else {
+        std::cerr << "Cannot read Example.ogex, skipped." << std::endl;
+    }
+
+    if (shapes.empty()) {
+        shapes.push_back(CorpusGenerator::Mixed);
+    }
+    for (size_t i = 0; i < shapes.size() && generatedSize > 0; ++i) {
+        Corpus generated;
+        generated.m_name = CorpusGenerator::getShapeName(shapes[i]);
+        MemoryStream stream(&generated.m_data);
+        CorpusGenerator generator(1);
+        generator.generate(shapes[i], static_cast<uint64>(generatedSize) * 1024 * 1024, stream);
+        corpora.push_back(generated);
+    }
+
+    std::vector<BenchResult> results;
+    for (size_t i = 0; i < corpora.size(); ++i) {
+        if (!benchCorpus(corpora[i], iterations, results)) {
+            return Error;
+        }
+    }
+    benchFormat<float, uint32>("format/float", formatFloat, iterations, results);
+    benchFormat<double, uint64>("format/double", formatDouble, iterations, results);
+    printResults(results);
+
+    if (!jsonFilename.empty() && !writeJson(jsonFilename, results)) {
+        std::cerr << "Cannot write " << jsonFilename << std::endl;
+        return Error;
+    }
+
+    if (!baselineFilename.empty()) {
+        std::vector<std::pair<std::string, double> > baseline;
+        if (!readBaseline(baselineFilename, baseline)) {
+            std::cerr << "Cannot read baseline " << baselineFilename << std::endl;
+            return Error;
+        }
+        if (compareBaseline(results, baseline, tolerance) > 0) {
+            return Regression;
+        }
+    }
+
+    if (!thresholdsFilename.empty()) {
+        std::vector<Threshold> thresholds;
+        if (!readThresholds(thresholdsFilename, thresholds)) {
+            std::cerr << "Cannot read thresholds " << thresholdsFilename << std::endl;
+            return Error;
+        }
+        if (checkThresholds(results, thresholds, checkTime) > 0) {
+            return Regression;
+        }
+    }
+
+    return 0;
+}
@@ -25,10 +25,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <openddlparser/OpenDDLStream.h>
 
 #include <algorithm>
+#include <atomic>
+#include <utility>
 
 BEGIN_ODDLPARSER_NS
 
-DDLNode::DllNodeList DDLNode::s_allocatedNodes;
+// the number of living nodes, parsers may run in several threads. Only a relaxed counter is
+// touched per node, so parallel parsers do not wait for each other.
+static std::atomic<size_t> s_numAllocatedNodes(0);
 
 template <class T>
 inline static void releaseDataType(T *ptr) {
@@ -52,16 +56,17 @@ static void releaseReferencedNames(Reference *ref) {
     delete ref;
 }
 
-DDLNode::DDLNode(const std::string &type, const std::string &name, size_t idx, DDLNode *parent) :
-        m_type(type),
-        m_name(name),
+DDLNode::DDLNode(std::string &&type, std::string &&name, DDLNode *parent) :
+        m_type(std::move(type)),
+        m_name(std::move(name)),
         m_parent(parent),
         m_children(),
         m_properties(nullptr),
         m_value(nullptr),
         m_dtArrayList(nullptr),
         m_references(nullptr),
-        m_idx(idx) {
+        m_sourceBegin(0),
+        m_sourceEnd(0) {
     if (m_parent) {
         m_parent->m_children.push_back(this);
     }
@@ -74,9 +79,7 @@ DDLNode::~DDLNode() {
 
     delete m_dtArrayList;
     m_dtArrayList = nullptr;
-    if (s_allocatedNodes[m_idx] == this) {
-        s_allocatedNodes[m_idx] = nullptr;
-    }
+    s_numAllocatedNodes.fetch_sub(1, std::memory_order_relaxed);
     for (size_t i = 0; i < m_children.size(); i++) {
         delete m_children[i];
     }
@@ -111,16 +114,24 @@ const DDLNode::DllNodeList &DDLNode::getChildNodeList() const {
     return m_children;
 }
 
-void DDLNode::setType(const std::string &type) {
-    m_type = type;
+void DDLNode::setType(std::string type) {
+    m_type = std::move(type);
+}
+
+void DDLNode::setType(const char *type, size_t len) {
+    m_type.assign(type, len);
 }
 
 const std::string &DDLNode::getType() const {
     return m_type;
 }
 
-void DDLNode::setName(const std::string &name) {
-    m_name = name;
+void DDLNode::setName(std::string name) {
+    m_name = std::move(name);
+}
+
+void DDLNode::setName(const char *name, size_t len) {
+    m_name.assign(name, len);
 }
 
 const std::string &DDLNode::getName() const {
@@ -191,6 +202,19 @@ Reference *DDLNode::getReferences() const {
     return m_references;
 }
 
+void DDLNode::setSourceRange(size_t begin, size_t end) {
+    m_sourceBegin = begin;
+    m_sourceEnd = end;
+}
+
+size_t DDLNode::getSourceBegin() const {
+    return m_sourceBegin;
+}
+
+size_t DDLNode::getSourceEnd() const {
+    return m_sourceEnd;
+}
+
 void DDLNode::dump(IOStreamBase &stream) {
     if (!stream.isOpen()) {
         return;
@@ -205,23 +229,13 @@ void DDLNode::dump(IOStreamBase &stream) {
     }
 }
 
-DDLNode *DDLNode::create(const std::string &type, const std::string &name, DDLNode *parent) {
-    const size_t idx(s_allocatedNodes.size());
-    DDLNode *node = new DDLNode(type, name, idx, parent);
-    s_allocatedNodes.push_back(node);
-
-    return node;
+DDLNode *DDLNode::create(std::string type, std::string name, DDLNode *parent) {
+    s_numAllocatedNodes.fetch_add(1, std::memory_order_relaxed);
+    return new DDLNode(std::move(type), std::move(name), parent);
 }
 
-void DDLNode::releaseNodes() {
-    if (s_allocatedNodes.size() > 0) {
-        for (DDLNodeIt it = s_allocatedNodes.begin(); it != s_allocatedNodes.end(); it++) {
-            if (*it) {
-                delete *it;
-            }
-        }
-        s_allocatedNodes.clear();
-    }
+size_t DDLNode::getNumAllocatedNodes() {
+    return s_numAllocatedNodes.load(std::memory_order_relaxed);
 }
 
 END_ODDLPARSER_NS
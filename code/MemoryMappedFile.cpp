@@ -0,0 +1,251 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/MemoryMappedFile.h>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#     define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#   include <cstdio>
+#else
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif // _WIN32
+
+BEGIN_ODDLPARSER_NS
+
+MemoryMappedFile::MemoryMappedFile() :
+        m_data(nullptr),
+        m_size(0),
+        m_open(false)
+#ifdef _WIN32
+        ,
+        m_file(nullptr),
+        m_mapping(nullptr)
+#endif // _WIN32
+{
+    // empty
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MemoryMappedFile::open(const std::string &filename) {
+    close();
+
+    HANDLE file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size)) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    if (static_cast<unsigned long long>(size.QuadPart) > static_cast<unsigned long long>(static_cast<size_t>(-1))) {
+        // does not fit into the address space
+        ::CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_open = true;
+    if (0 == m_size) {
+        return true;
+    }
+
+    m_mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr == m_mapping) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const char *>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (nullptr == m_data) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void MemoryMappedFile::close() {
+    if (nullptr != m_data) {
+        ::UnmapViewOfFile(m_data);
+    }
+    if (nullptr != m_mapping) {
+        ::CloseHandle(m_mapping);
+    }
+    if (nullptr != m_file) {
+        ::CloseHandle(m_file);
+    }
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#else
+
+bool MemoryMappedFile::open(const std::string &filename) {
+    close();
+
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (-1 == fd) {
+        return false;
+    }
+
+    struct stat info;
+    if (0 != ::fstat(fd, &info) || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    const unsigned long long fileSize(static_cast<unsigned long long>(info.st_size));
+    if (fileSize > static_cast<unsigned long long>(static_cast<size_t>(-1))) {
+        // does not fit into the address space
+        ::close(fd);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize);
+    if (m_size > 0) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == data) {
+            ::close(fd);
+            m_size = 0;
+            return false;
+        }
+        // the content is read front to back, let the kernel read ahead aggressively
+        ::madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char *>(data);
+    }
+
+    // the mapping stays valid after the descriptor was closed
+    ::close(fd);
+    m_open = true;
+
+    return true;
+}
+
+void MemoryMappedFile::close() {
+    if (nullptr != m_data) {
+        ::munmap(const_cast<char *>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#endif // _WIN32
+
+bool MemoryMappedFile::isOpen() const {
+    return m_open;
+}
+
+const char *MemoryMappedFile::getData() const {
+    return m_data;
+}
+
+size_t MemoryMappedFile::getSize() const {
+    return m_size;
+}
+
+#ifdef _WIN32
+
+bool MemoryMappedFile::readFile(const std::string &filename, std::vector<char> &buffer) {
+    buffer.clear();
+    FILE *file = ::fopen(filename.c_str(), "rb");
+    if (nullptr == file) {
+        return false;
+    }
+
+    static const size_t BlockSize = 1024 * 1024;
+    size_t readBytes(0);
+    do {
+        const size_t offset(buffer.size());
+        buffer.resize(offset + BlockSize);
+        readBytes = ::fread(&buffer[offset], 1, BlockSize, file);
+        buffer.resize(offset + readBytes);
+    } while (readBytes > 0);
+    const bool success(0 == ::ferror(file));
+    ::fclose(file);
+
+    return success;
+}
+
+#else
+
+bool MemoryMappedFile::readFile(const std::string &filename, std::vector<char> &buffer) {
+    buffer.clear();
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (-1 == fd) {
+        return false;
+    }
+
+    // pread uses 64-bit offsets and works for all seekable files, streams like pipes fall back to read
+    static const size_t BlockSize = 1024 * 1024;
+    bool seekable(true), success(true);
+    for (;;) {
+        const size_t offset(buffer.size());
+        buffer.resize(offset + BlockSize);
+        ssize_t readBytes(seekable ? ::pread(fd, &buffer[offset], BlockSize, static_cast<off_t>(offset)) :
+                                     ::read(fd, &buffer[offset], BlockSize));
+        if (readBytes < 0 && seekable && ESPIPE == errno) {
+            seekable = false;
+            readBytes = ::read(fd, &buffer[offset], BlockSize);
+        }
+        if (readBytes < 0 && EINTR == errno) {
+            buffer.resize(offset);
+            continue;
+        }
+        if (readBytes <= 0) {
+            buffer.resize(offset);
+            success = (0 == readBytes);
+            break;
+        }
+        buffer.resize(offset + static_cast<size_t>(readBytes));
+    }
+    ::close(fd);
+
+    return success;
+}
+
+#endif // _WIN32
+
+END_ODDLPARSER_NS
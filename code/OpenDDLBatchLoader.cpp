@@ -0,0 +1,227 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/MemoryMappedFile.h>
+#include <openddlparser/OpenDDLBatchLoader.h>
+#include <openddlparser/OpenDDLCompression.h>
+#include <openddlparser/OpenDDLParser.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+BEGIN_ODDLPARSER_NS
+
+// a read file waiting for a parser
+struct LoadedBuffer {
+    size_t m_index;
+    std::vector<char> m_data;
+};
+
+typedef std::chrono::steady_clock LoaderClock;
+
+static double secondsSince(const LoaderClock::time_point &start) {
+    return std::chrono::duration<double>(LoaderClock::now() - start).count();
+}
+
+OpenDDLBatchLoader::OpenDDLBatchLoader() :
+        m_numReaders(2),
+        m_numParsers(0),
+        m_queueCapacity(16),
+        m_statistics() {
+    // empty
+}
+
+OpenDDLBatchLoader::~OpenDDLBatchLoader() {
+    // empty
+}
+
+void OpenDDLBatchLoader::setNumReaders(size_t numReaders) {
+    m_numReaders = numReaders;
+}
+
+size_t OpenDDLBatchLoader::getNumReaders() const {
+    return m_numReaders;
+}
+
+void OpenDDLBatchLoader::setNumParsers(size_t numParsers) {
+    m_numParsers = numParsers;
+}
+
+size_t OpenDDLBatchLoader::getNumParsers() const {
+    return m_numParsers;
+}
+
+void OpenDDLBatchLoader::setQueueCapacity(size_t capacity) {
+    m_queueCapacity = capacity > 0 ? capacity : 1;
+}
+
+size_t OpenDDLBatchLoader::getQueueCapacity() const {
+    return m_queueCapacity;
+}
+
+std::vector<OpenDDLBatchLoader::Result> OpenDDLBatchLoader::load(const std::vector<std::string> &filenames) {
+    const LoaderClock::time_point start(LoaderClock::now());
+    m_statistics = Statistics();
+    m_statistics.m_numFiles = filenames.size();
+
+    std::vector<Result> results(filenames.size());
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        results[i].m_filename = filenames[i];
+    }
+    if (filenames.empty()) {
+        return results;
+    }
+
+    size_t numParsers(m_numParsers);
+    if (0 == numParsers) {
+        numParsers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numParsers = std::min(numParsers, filenames.size());
+    const size_t numReaders(std::min(std::max<size_t>(m_numReaders, 1), filenames.size()));
+
+    std::mutex mutex;
+    std::condition_variable notFull, notEmpty;
+    std::deque<LoadedBuffer> queue;
+    std::atomic<size_t> nextFile(0);
+    size_t activeReaders(numReaders);
+
+    // the readers read the files in list order into the queue
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numReaders; ++t) {
+        threads.push_back(std::thread([&]() {
+            double readSeconds(0.0), waitSeconds(0.0);
+            size_t bytesRead(0);
+            for (size_t index = nextFile++; index < filenames.size(); index = nextFile++) {
+                const LoaderClock::time_point readStart(LoaderClock::now());
+                LoadedBuffer buffer;
+                buffer.m_index = index;
+                std::string error;
+                if (!MemoryMappedFile::readFile(filenames[index], buffer.m_data)) {
+                    error = "Cannot read file \"" + filenames[index] + "\".";
+                } else if (isCompressedBuffer(buffer.m_data.empty() ? nullptr : &buffer.m_data[0], buffer.m_data.size())) {
+                    std::vector<char> decompressed;
+                    if (decompressBuffer(&buffer.m_data[0], buffer.m_data.size(), decompressed)) {
+                        buffer.m_data.swap(decompressed);
+                    } else {
+                        error = "Cannot decompress file \"" + filenames[index] + "\".";
+                    }
+                }
+                readSeconds += secondsSince(readStart);
+
+                std::unique_lock<std::mutex> lock(mutex);
+                if (!error.empty()) {
+                    // the result of a failed file is owned by this reader only
+                    results[index].m_error = error;
+                    continue;
+                }
+                bytesRead += buffer.m_data.size();
+                const LoaderClock::time_point waitStart(LoaderClock::now());
+                notFull.wait(lock, [&]() { return queue.size() < m_queueCapacity; });
+                waitSeconds += secondsSince(waitStart);
+                queue.push_back(std::move(buffer));
+                m_statistics.m_maxQueueDepth = std::max(m_statistics.m_maxQueueDepth, queue.size());
+                notEmpty.notify_one();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            m_statistics.m_readSeconds += readSeconds;
+            m_statistics.m_readerWaitSeconds += waitSeconds;
+            m_statistics.m_bytesRead += bytesRead;
+            if (0 == --activeReaders) {
+                notEmpty.notify_all();
+            }
+        }));
+    }
+
+    // the parsers take the buffers from the queue until all readers are done
+    for (size_t t = 0; t < numParsers; ++t) {
+        threads.push_back(std::thread([&]() {
+            double parseSeconds(0.0), waitSeconds(0.0);
+            OpenDDLParser parser;
+            std::string error;
+            parser.setLogCallback([&error](LogSeverity severity, const std::string &msg) {
+                if (ddl_error_msg == severity && error.empty()) {
+                    error = msg;
+                }
+            });
+
+            for (;;) {
+                LoadedBuffer buffer;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    const LoaderClock::time_point waitStart(LoaderClock::now());
+                    notEmpty.wait(lock, [&]() { return !queue.empty() || 0 == activeReaders; });
+                    waitSeconds += secondsSince(waitStart);
+                    if (queue.empty()) {
+                        break;
+                    }
+                    buffer = std::move(queue.front());
+                    queue.pop_front();
+                    notFull.notify_one();
+                }
+
+                const LoaderClock::time_point parseStart(LoaderClock::now());
+                Result &result(results[buffer.m_index]);
+                error.clear();
+                parser.setBuffer(std::move(buffer.m_data));
+                if (parser.parse()) {
+                    result.m_context.reset(parser.detachContext());
+                } else {
+                    result.m_error = error.empty() ? "Cannot parse file \"" + result.m_filename + "\"." : error;
+                }
+                parser.clear();
+                parseSeconds += secondsSince(parseStart);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            m_statistics.m_parseSeconds += parseSeconds;
+            m_statistics.m_parserWaitSeconds += waitSeconds;
+        }));
+    }
+
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].isValid()) {
+            if (results[i].m_error.empty()) {
+                results[i].m_error = "Cannot parse file \"" + results[i].m_filename + "\".";
+            }
+            ++m_statistics.m_numFailed;
+        }
+    }
+    m_statistics.m_wallSeconds = secondsSince(start);
+
+    return results;
+}
+
+const OpenDDLBatchLoader::Statistics &OpenDDLBatchLoader::getStatistics() const {
+    return m_statistics;
+}
+
+END_ODDLPARSER_NS
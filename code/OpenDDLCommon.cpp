@@ -24,8 +24,49 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <openddlparser/OpenDDLCommon.h>
 #include <openddlparser/Value.h>
 
+#include <utility>
+
 BEGIN_ODDLPARSER_NS
 
+static inline uint64 rotateLeft(uint64 value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+static inline uint64 finalizeHash(uint64 h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64 computeHash(const void *data, size_t len, uint64 seed) {
+    static const uint64 Prime1 = 0x9e3779b185ebca87ULL;
+    static const uint64 Prime2 = 0xc2b2ae3d27d4eb4fULL;
+
+    const unsigned char *in = static_cast<const unsigned char *>(data);
+    uint64 h = seed ^ (static_cast<uint64>(len) * Prime1);
+
+    // consume eight bytes per step, the tail is folded in bytewise
+    while (len >= sizeof(uint64)) {
+        uint64 word;
+        ::memcpy(&word, in, sizeof(uint64));
+        h ^= rotateLeft(word * Prime2, 31) * Prime1;
+        h = rotateLeft(h, 27) * Prime1 + Prime2;
+        in += sizeof(uint64);
+        len -= sizeof(uint64);
+    }
+    while (len > 0) {
+        h ^= static_cast<uint64>(*in) * Prime1;
+        h = rotateLeft(h, 11) * Prime2;
+        ++in;
+        --len;
+    }
+
+    return finalizeHash(h);
+}
+
 Text::Text(const char *buffer, size_t numChars) :
         m_capacity(0),
         m_len(0),
@@ -33,6 +74,26 @@ Text::Text(const char *buffer, size_t numChars) :
     set(buffer, numChars);
 }
 
+Text::Text(Text &&rhs) :
+        m_capacity(rhs.m_capacity),
+        m_len(rhs.m_len),
+        m_buffer(rhs.m_buffer) {
+    rhs.m_capacity = 0;
+    rhs.m_len = 0;
+    rhs.m_buffer = nullptr;
+}
+
+Text &Text::operator=(Text &&rhs) {
+    if (this != &rhs) {
+        clear();
+        std::swap(m_capacity, rhs.m_capacity);
+        std::swap(m_len, rhs.m_len);
+        std::swap(m_buffer, rhs.m_buffer);
+    }
+
+    return *this;
+}
+
 Text::~Text() {
     clear();
 }
@@ -79,6 +140,16 @@ Name::Name(NameType type, Text *id) :
     // empty
 }
 
+Name::Name(NameType type, Text &&id) :
+        m_type(type), m_id(new Text(std::move(id))) {
+    // empty
+}
+
+Name::Name(Name &&rhs) :
+        m_type(rhs.m_type), m_id(rhs.m_id) {
+    rhs.m_id = nullptr;
+}
+
 Name::~Name() {
     delete m_id;
     m_id = nullptr;
@@ -103,7 +174,8 @@ Reference::Reference(size_t numrefs, Name **names) :
         }
     }
 }
-Reference::Reference(const Reference &ref) {
+Reference::Reference(const Reference &ref) :
+        m_numRefs(0), m_referencedName(nullptr) {
     m_numRefs = ref.m_numRefs;
     if (m_numRefs != 0) {
         m_referencedName = new Name *[m_numRefs];
@@ -143,6 +215,11 @@ Property::Property(Text *id) :
     // empty
 }
 
+Property::Property(Text &&id) :
+        m_key(new Text(std::move(id))), m_value(nullptr), m_ref(nullptr), m_next(nullptr) {
+    // empty
+}
+
 Property::~Property() {
     delete m_key;
     if (m_value != nullptr)
@@ -183,6 +260,33 @@ size_t DataArrayList::size() {
     return result;
 }
 
+template<class T>
+size_t DataArrayList::copyTo(T *out, size_t n) const {
+    if (nullptr == out) {
+        return 0;
+    }
+
+    size_t copied(0);
+    for (const DataArrayList *current = this; nullptr != current && copied < n; current = current->m_next) {
+        if (nullptr != current->m_dataList) {
+            copied += current->m_dataList->copyTo(out + copied, n - copied);
+        }
+    }
+
+    return copied;
+}
+
+template size_t DataArrayList::copyTo<int8>(int8 *, size_t) const;
+template size_t DataArrayList::copyTo<int16>(int16 *, size_t) const;
+template size_t DataArrayList::copyTo<int32>(int32 *, size_t) const;
+template size_t DataArrayList::copyTo<int64>(int64 *, size_t) const;
+template size_t DataArrayList::copyTo<uint8>(uint8 *, size_t) const;
+template size_t DataArrayList::copyTo<uint16>(uint16 *, size_t) const;
+template size_t DataArrayList::copyTo<uint32>(uint32 *, size_t) const;
+template size_t DataArrayList::copyTo<uint64>(uint64 *, size_t) const;
+template size_t DataArrayList::copyTo<float>(float *, size_t) const;
+template size_t DataArrayList::copyTo<double>(double *, size_t) const;
+
 Context::Context() :
         m_root(nullptr) {
     // empty
@@ -197,4 +301,238 @@ void Context::clear() {
     m_root = nullptr;
 }
 
+// walks a node tree and adds every heap allocation to the matching kind
+class MemoryUsageCounter {
+public:
+    explicit MemoryUsageCounter(MemoryUsage &usage) :
+            m_usage(usage),
+            m_inlineCapacity(std::string().capacity()) {
+        // empty
+    }
+
+    void addAllocation(size_t &kind, size_t bytes) {
+        kind += bytes;
+        m_usage.m_overhead += MemoryUsage::getAllocatorOverhead(bytes);
+        ++m_usage.m_numAllocations;
+    }
+
+    void addString(const std::string &str) {
+        // short strings are stored inside the string object
+        if (str.capacity() > m_inlineCapacity) {
+            addAllocation(m_usage.m_strings, str.capacity() + 1);
+        }
+    }
+
+    void addText(const Text *text) {
+        if (nullptr == text) {
+            return;
+        }
+        addAllocation(m_usage.m_strings, sizeof(Text));
+        if (nullptr != text->m_buffer) {
+            addAllocation(m_usage.m_strings, text->m_capacity);
+        }
+    }
+
+    void addReference(const Reference *ref) {
+        if (nullptr == ref) {
+            return;
+        }
+        addAllocation(m_usage.m_references, sizeof(Reference));
+        if (nullptr == ref->m_referencedName) {
+            return;
+        }
+        addAllocation(m_usage.m_references, ref->m_numRefs * sizeof(Name *));
+        for (size_t i = 0; i < ref->m_numRefs; ++i) {
+            if (nullptr != ref->m_referencedName[i]) {
+                addAllocation(m_usage.m_references, sizeof(Name));
+                addText(ref->m_referencedName[i]->m_id);
+            }
+        }
+    }
+
+    void addValues(const Value *value, size_t &kind) {
+        for (; nullptr != value; value = value->m_next) {
+            addAllocation(kind, sizeof(Value));
+            if (nullptr == value->m_data) {
+                continue;
+            }
+            if (Value::ValueType::ddl_ref == value->m_type) {
+                addReference(reinterpret_cast<const Reference *>(value->m_data));
+            } else if (Value::ValueType::ddl_string == value->m_type) {
+                addAllocation(m_usage.m_strings, value->m_size);
+            } else {
+                addAllocation(kind, value->m_size);
+            }
+        }
+    }
+
+    void addProperties(const Property *prop) {
+        for (; nullptr != prop; prop = prop->m_next) {
+            addAllocation(m_usage.m_properties, sizeof(Property));
+            addText(prop->m_key);
+            addValues(prop->m_value, m_usage.m_values);
+            addReference(prop->m_ref);
+        }
+    }
+
+    void addArrays(const DataArrayList *list) {
+        for (; nullptr != list; list = list->m_next) {
+            addAllocation(m_usage.m_arrays, sizeof(DataArrayList));
+            addValues(list->m_dataList, m_usage.m_arrays);
+            addReference(list->m_refs);
+        }
+    }
+
+    void addNode(const DDLNode *node) {
+        addAllocation(m_usage.m_nodes, sizeof(DDLNode));
+        addString(node->getType());
+        addString(node->getName());
+        addProperties(node->getProperties());
+        addValues(node->getValue(), m_usage.m_values);
+        addArrays(node->getDataArrayList());
+        addReference(node->getReferences());
+
+        const DDLNode::DllNodeList &children(node->getChildNodeList());
+        if (0 != children.capacity()) {
+            addAllocation(m_usage.m_nodes, children.capacity() * sizeof(DDLNode *));
+        }
+        for (size_t i = 0; i < children.size(); ++i) {
+            addNode(children[i]);
+        }
+    }
+
+private:
+    MemoryUsage &m_usage;
+    size_t m_inlineCapacity;
+};
+
+MemoryUsage Context::memoryUsage() const {
+    MemoryUsage usage;
+    MemoryUsageCounter counter(usage);
+    counter.addAllocation(usage.m_nodes, sizeof(Context));
+    if (nullptr != m_root) {
+        counter.addNode(m_root);
+    }
+
+    return usage;
+}
+
+MemoryUsage::MemoryUsage() {
+    clear();
+}
+
+void MemoryUsage::clear() {
+    m_nodes = 0;
+    m_strings = 0;
+    m_values = 0;
+    m_properties = 0;
+    m_references = 0;
+    m_arrays = 0;
+    m_overhead = 0;
+    m_numAllocations = 0;
+}
+
+size_t MemoryUsage::getTotal() const {
+    return m_nodes + m_strings + m_values + m_properties + m_references + m_arrays + m_overhead;
+}
+
+size_t MemoryUsage::getAllocatorOverhead(size_t bytes) {
+    // modelled after dlmalloc / glibc: a size header, alignment to two words and a minimum chunk
+    static const size_t Header = sizeof(size_t);
+    static const size_t Alignment = 2 * sizeof(void *);
+    static const size_t MinChunk = 4 * sizeof(void *);
+    size_t chunk((bytes + Header + Alignment - 1) & ~(Alignment - 1));
+    if (chunk < MinChunk) {
+        chunk = MinChunk;
+    }
+
+    return chunk - bytes;
+}
+
+ParseStats::ParseStats() {
+    clear();
+}
+
+void ParseStats::clear() {
+    for (size_t i = 0; i < ddl_num_object_kinds; ++i) {
+        m_allocations[i].m_count = 0;
+        m_allocations[i].m_bytes = 0;
+    }
+    m_numNodes = 0;
+    m_numValues = 0;
+    m_maxDepth = 0;
+    m_inputBytes = 0;
+}
+
+size_t ParseStats::getTotalCount() const {
+    size_t count(0);
+    for (size_t i = 0; i < ddl_num_object_kinds; ++i) {
+        count += m_allocations[i].m_count;
+    }
+
+    return count;
+}
+
+size_t ParseStats::getTotalBytes() const {
+    size_t bytes(0);
+    for (size_t i = 0; i < ddl_num_object_kinds; ++i) {
+        bytes += m_allocations[i].m_bytes;
+    }
+
+    return bytes;
+}
+
+const char *ParseStats::getKindName(ParseObjectKind kind) {
+    static const char *Names[ddl_num_object_kinds] = {
+        "DDLNode",
+        "Value",
+        "Text",
+        "Name",
+        "Property",
+        "Reference",
+        "DataArrayList"
+    };
+    if (kind >= ddl_num_object_kinds) {
+        return "";
+    }
+
+    return Names[kind];
+}
+
+ParseTimings::Timing::Timing() :
+        m_calls(0),
+        m_seconds(0.0) {
+    // empty
+}
+
+ParseTimings::ParseTimings() :
+        m_structures(),
+        m_totalSeconds(0.0) {
+    // empty
+}
+
+void ParseTimings::clear() {
+    for (size_t i = 0; i < ddl_num_parse_phases; ++i) {
+        m_phases[i] = Timing();
+    }
+    m_structures.clear();
+    m_totalSeconds = 0.0;
+}
+
+const char *ParseTimings::getPhaseName(ParsePhase phase) {
+    static const char *Names[ddl_num_parse_phases] = {
+        "normalize",
+        "header",
+        "primitive type",
+        "numeric conversion",
+        "node creation",
+        "allocation"
+    };
+    if (phase >= ddl_num_parse_phases) {
+        return "";
+    }
+
+    return Names[phase];
+}
+
 END_ODDLPARSER_NS
@@ -0,0 +1,493 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/OpenDDLCompression.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef OPENDDL_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+BEGIN_ODDLPARSER_NS
+
+#ifdef OPENDDL_WITH_ZLIB
+struct CompressionState {
+    z_stream m_stream;
+};
+
+// zlib counts in 32-bit, bigger blocks are handed over in pieces
+static const size_t MaxBlockSize = 1u << 30;
+#else
+struct CompressionState {
+    int m_unused;
+};
+#endif
+
+#ifdef _WIN32
+static int openInputFile(const std::string &name) {
+    return ::_open(name.c_str(), _O_RDONLY | _O_BINARY);
+}
+
+static int readBlock(int fd, char *data, size_t len) {
+    return ::_read(fd, data, static_cast<unsigned int>(std::min<size_t>(len, 1u << 30)));
+}
+
+static void closeFile(int fd) {
+    ::_close(fd);
+}
+#else
+static int openInputFile(const std::string &name) {
+    return ::open(name.c_str(), O_RDONLY);
+}
+
+static ssize_t readBlock(int fd, char *data, size_t len) {
+    ssize_t readBytes(0);
+    do {
+        readBytes = ::read(fd, data, len);
+    } while (readBytes < 0 && EINTR == errno);
+
+    return readBytes;
+}
+
+static void closeFile(int fd) {
+    ::close(fd);
+}
+#endif
+
+bool isCompressionSupported() {
+#ifdef OPENDDL_WITH_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool isCompressedBuffer(const char *data, size_t len) {
+    if (nullptr == data || len < 2) {
+        return false;
+    }
+
+    const unsigned char first(static_cast<unsigned char>(data[0])), second(static_cast<unsigned char>(data[1]));
+    if (0x1f == first && 0x8b == second) {
+        return true;
+    }
+
+    // zlib: deflate with a 32K window, a valid check sum and no preset dictionary. Other window
+    // sizes are not detected, their headers are valid beginnings of a text.
+    return 0x78 == first && 0 == ((first << 8) | second) % 31 && 0 == (second & 0x20);
+}
+
+bool decompressBuffer(const char *data, size_t len, std::vector<char> &buffer) {
+    buffer.clear();
+    if (nullptr == data || !isCompressedBuffer(data, len)) {
+        return false;
+    }
+
+#ifdef OPENDDL_WITH_ZLIB
+    z_stream stream;
+    ::memset(&stream, 0, sizeof(z_stream));
+    if (Z_OK != ::inflateInit2(&stream, 15 + 32)) {
+        return false;
+    }
+
+    // text compresses well, start with a guess and double the size if needed
+    buffer.resize(std::max<size_t>(len * 4, 4096));
+    size_t inPos(0), outPos(0);
+    int ret(Z_OK);
+    for (;;) {
+        if (outPos == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        const size_t inLen(std::min(len - inPos, MaxBlockSize));
+        const size_t outLen(std::min(buffer.size() - outPos, MaxBlockSize));
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data + inPos));
+        stream.avail_in = static_cast<uInt>(inLen);
+        stream.next_out = reinterpret_cast<Bytef *>(&buffer[outPos]);
+        stream.avail_out = static_cast<uInt>(outLen);
+        ret = ::inflate(&stream, Z_NO_FLUSH);
+        inPos += inLen - stream.avail_in;
+        outPos += outLen - stream.avail_out;
+        if (Z_STREAM_END == ret) {
+            // gzip files may consist of several members
+            if (inPos == len || Z_OK != ::inflateReset(&stream)) {
+                break;
+            }
+        } else if (Z_OK != ret && (Z_BUF_ERROR != ret || (inPos == len && outPos != buffer.size()))) {
+            // corrupt or truncated
+            break;
+        }
+    }
+    ::inflateEnd(&stream);
+    if (Z_STREAM_END != ret || inPos != len) {
+        buffer.clear();
+        return false;
+    }
+    buffer.resize(outPos);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+const size_t CompressedInputStream::BufferSize;
+
+CompressedInputStream::CompressedInputStream(int fd, bool ownsFd) :
+        IOStreamBase(),
+        m_fd(fd),
+        m_ownsFd(ownsFd),
+        m_detected(false),
+        m_compressed(false),
+        m_eof(false),
+        m_finished(false),
+        m_error(false),
+        m_input(),
+        m_inputPos(0),
+        m_inputEnd(0),
+        m_state(nullptr) {
+    // empty
+}
+
+CompressedInputStream::~CompressedInputStream() {
+    close();
+}
+
+bool CompressedInputStream::open(const std::string &name) {
+    close();
+    m_fd = openInputFile(name);
+    m_ownsFd = true;
+
+    return isOpen();
+}
+
+bool CompressedInputStream::close() {
+    const bool wasOpen(isOpen());
+    if (wasOpen && m_ownsFd) {
+        closeFile(m_fd);
+    }
+    m_fd = -1;
+    m_ownsFd = false;
+    reset();
+
+    return wasOpen;
+}
+
+bool CompressedInputStream::isOpen() const {
+    return m_fd >= 0;
+}
+
+size_t CompressedInputStream::read(size_t sizeToRead, std::string &statement) {
+    statement.resize(sizeToRead);
+    if (!isOpen() || m_error || 0 == sizeToRead) {
+        statement.clear();
+        return 0;
+    }
+
+    if (!m_detected && !detectFormat()) {
+        statement.clear();
+        return 0;
+    }
+
+    size_t readBytes(0);
+    if (m_compressed) {
+        readBytes = readCompressed(&statement[0], sizeToRead);
+    } else {
+        // plain input is passed through
+        while (readBytes < sizeToRead && (m_inputPos != m_inputEnd || fillInput())) {
+            const size_t len(std::min(sizeToRead - readBytes, m_inputEnd - m_inputPos));
+            ::memcpy(&statement[readBytes], &m_input[m_inputPos], len);
+            m_inputPos += len;
+            readBytes += len;
+        }
+    }
+    statement.resize(readBytes);
+
+    return readBytes;
+}
+
+bool CompressedInputStream::isCompressed() const {
+    return m_compressed;
+}
+
+bool CompressedInputStream::hasError() const {
+    return m_error;
+}
+
+void CompressedInputStream::reset() {
+#ifdef OPENDDL_WITH_ZLIB
+    if (nullptr != m_state) {
+        ::inflateEnd(&m_state->m_stream);
+    }
+#endif
+    delete m_state;
+    m_state = nullptr;
+    m_detected = false;
+    m_compressed = false;
+    m_eof = false;
+    m_finished = false;
+    m_error = false;
+    m_inputPos = 0;
+    m_inputEnd = 0;
+}
+
+bool CompressedInputStream::fillInput() {
+    if (m_inputPos == m_inputEnd) {
+        m_inputPos = m_inputEnd = 0;
+    }
+    if (m_eof) {
+        return false;
+    }
+    if (m_input.size() != BufferSize) {
+        m_input.resize(BufferSize);
+    }
+
+    const auto readBytes(readBlock(m_fd, &m_input[m_inputEnd], m_input.size() - m_inputEnd));
+    if (readBytes <= 0) {
+        m_eof = true;
+        m_error = readBytes < 0;
+        return false;
+    }
+    m_inputEnd += static_cast<size_t>(readBytes);
+
+    return true;
+}
+
+bool CompressedInputStream::detectFormat() {
+    while (m_inputEnd - m_inputPos < 2 && fillInput()) {
+        // the header may arrive in pieces from a pipe
+    }
+    m_detected = true;
+    m_compressed = isCompressedBuffer(m_input.empty() ? nullptr : &m_input[m_inputPos], m_inputEnd - m_inputPos);
+    if (!m_compressed) {
+        return !m_error;
+    }
+
+#ifdef OPENDDL_WITH_ZLIB
+    m_state = new CompressionState;
+    ::memset(&m_state->m_stream, 0, sizeof(z_stream));
+    // detect gzip and zlib headers automatically
+    if (Z_OK != ::inflateInit2(&m_state->m_stream, 15 + 32)) {
+        delete m_state;
+        m_state = nullptr;
+        m_error = true;
+    }
+#else
+    m_error = true;
+#endif
+
+    return !m_error;
+}
+
+size_t CompressedInputStream::readCompressed(char *out, size_t len) {
+#ifdef OPENDDL_WITH_ZLIB
+    z_stream &stream(m_state->m_stream);
+    size_t readBytes(0);
+    while (readBytes < len && !m_finished) {
+        if (m_inputPos == m_inputEnd && !fillInput()) {
+            // the input ends before the compressed stream
+            m_error = true;
+            break;
+        }
+
+        const size_t inLen(std::min(m_inputEnd - m_inputPos, MaxBlockSize));
+        const size_t outLen(std::min(len - readBytes, MaxBlockSize));
+        stream.next_in = reinterpret_cast<Bytef *>(&m_input[m_inputPos]);
+        stream.avail_in = static_cast<uInt>(inLen);
+        stream.next_out = reinterpret_cast<Bytef *>(out + readBytes);
+        stream.avail_out = static_cast<uInt>(outLen);
+        const int ret(::inflate(&stream, Z_NO_FLUSH));
+        m_inputPos += inLen - stream.avail_in;
+        readBytes += outLen - stream.avail_out;
+        if (Z_STREAM_END == ret) {
+            // gzip files may consist of several members
+            if (m_inputPos == m_inputEnd && !fillInput()) {
+                m_finished = !m_error;
+            } else if (Z_OK != ::inflateReset(&stream)) {
+                m_error = true;
+            }
+        } else if (Z_OK != ret && Z_BUF_ERROR != ret) {
+            m_error = true;
+        }
+        if (m_error) {
+            break;
+        }
+    }
+
+    return readBytes;
+#else
+    (void)out;
+    (void)len;
+    return 0;
+#endif
+}
+
+const size_t CompressedOutputStream::BufferSize;
+
+CompressedOutputStream::CompressedOutputStream(IOStreamBase *target, CompressionFormat format, int level) :
+        IOStreamBase(),
+        m_target(target),
+        m_ownsTarget(nullptr == target),
+        m_format(format),
+        m_level(level),
+        m_started(false),
+        m_error(false),
+        m_output(),
+        m_state(nullptr) {
+    if (m_ownsTarget) {
+        m_target = new FileDescriptorStream();
+    }
+}
+
+CompressedOutputStream::~CompressedOutputStream() {
+    close();
+    if (m_ownsTarget) {
+        delete m_target;
+    }
+}
+
+bool CompressedOutputStream::open(const std::string &name) {
+    close();
+    m_error = false;
+    if (!isCompressionSupported()) {
+        return false;
+    }
+
+    return m_target->open(name);
+}
+
+bool CompressedOutputStream::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+    // an empty compressed stream is written as well
+    if (!m_started) {
+        start();
+    }
+    if (m_started) {
+        compress(nullptr, 0, true);
+    }
+#ifdef OPENDDL_WITH_ZLIB
+    if (nullptr != m_state) {
+        ::deflateEnd(&m_state->m_stream);
+    }
+#endif
+    delete m_state;
+    m_state = nullptr;
+    m_started = false;
+    const bool closed(m_target->close());
+
+    return closed && !m_error;
+}
+
+bool CompressedOutputStream::isOpen() const {
+    return isCompressionSupported() && m_target->isOpen();
+}
+
+size_t CompressedOutputStream::write(const std::string &statement) {
+    return write(statement.c_str(), statement.size());
+}
+
+size_t CompressedOutputStream::write(const char *data, size_t len) {
+    if (nullptr == data || !isOpen() || m_error) {
+        return 0;
+    }
+    if (!m_started && !start()) {
+        return 0;
+    }
+
+    return compress(data, len, false) ? len : 0;
+}
+
+bool CompressedOutputStream::hasError() const {
+    return m_error;
+}
+
+bool CompressedOutputStream::start() {
+#ifdef OPENDDL_WITH_ZLIB
+    m_state = new CompressionState;
+    ::memset(&m_state->m_stream, 0, sizeof(z_stream));
+    const int windowBits(ddl_gzip_format == m_format ? 15 + 16 : 15);
+    if (Z_OK != ::deflateInit2(&m_state->m_stream, m_level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY)) {
+        delete m_state;
+        m_state = nullptr;
+        m_error = true;
+        return false;
+    }
+    m_output.resize(BufferSize);
+    m_started = true;
+
+    return true;
+#else
+    m_error = true;
+    return false;
+#endif
+}
+
+bool CompressedOutputStream::compress(const char *data, size_t len, bool finish) {
+#ifdef OPENDDL_WITH_ZLIB
+    z_stream &stream(m_state->m_stream);
+    do {
+        const size_t inLen(std::min(len, MaxBlockSize));
+        const bool lastBlock(inLen == len);
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        stream.avail_in = static_cast<uInt>(inLen);
+        int ret(Z_OK);
+        do {
+            stream.next_out = reinterpret_cast<Bytef *>(&m_output[0]);
+            stream.avail_out = static_cast<uInt>(m_output.size());
+            ret = ::deflate(&stream, (finish && lastBlock) ? Z_FINISH : Z_NO_FLUSH);
+            if (Z_STREAM_ERROR == ret) {
+                m_error = true;
+                return false;
+            }
+            const size_t compressedLen(m_output.size() - stream.avail_out);
+            if (compressedLen > 0 && m_target->write(&m_output[0], compressedLen) != compressedLen) {
+                m_error = true;
+                return false;
+            }
+        } while (0 == stream.avail_out);
+        data += inLen;
+        len -= inLen;
+    } while (len > 0);
+
+    return true;
+#else
+    (void)data;
+    (void)len;
+    (void)finish;
+    m_error = true;
+    return false;
+#endif
+}
+
+END_ODDLPARSER_NS
@@ -0,0 +1,425 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLDiff.h>
+#include <openddlparser/Value.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+BEGIN_ODDLPARSER_NS
+
+static const size_t NoMatch = ~static_cast<size_t>(0);
+
+static bool isTextEqual(const Text *lhs, const Text *rhs) {
+    if (nullptr == lhs || nullptr == rhs) {
+        return lhs == rhs;
+    }
+
+    return *lhs == *rhs;
+}
+
+static bool isReferenceEqual(const Reference *lhs, const Reference *rhs) {
+    const size_t numLhs(nullptr == lhs ? 0 : lhs->m_numRefs);
+    const size_t numRhs(nullptr == rhs ? 0 : rhs->m_numRefs);
+    if (numLhs != numRhs) {
+        return false;
+    }
+
+    for (size_t i = 0; i < numLhs; ++i) {
+        const Name *lhsName(lhs->m_referencedName[i]), *rhsName(rhs->m_referencedName[i]);
+        if (lhsName->m_type != rhsName->m_type || !isTextEqual(lhsName->m_id, rhsName->m_id)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool isValueListEqual(const Value *lhs, const Value *rhs) {
+    while (nullptr != lhs && nullptr != rhs) {
+        if (lhs->m_type != rhs->m_type) {
+            return false;
+        }
+        if (Value::ValueType::ddl_ref == lhs->m_type) {
+            if (!isReferenceEqual(lhs->getRef(), rhs->getRef())) {
+                return false;
+            }
+        } else if (lhs->m_size != rhs->m_size || (0 != lhs->m_size && 0 != ::memcmp(lhs->m_data, rhs->m_data, lhs->m_size))) {
+            // the payload of a value is stored contiguous, so a memcmp is enough
+            return false;
+        }
+        lhs = lhs->getNext();
+        rhs = rhs->getNext();
+    }
+
+    return lhs == rhs;
+}
+
+static bool isPropertyListEqual(const Property *lhs, const Property *rhs) {
+    while (nullptr != lhs && nullptr != rhs) {
+        if (!isTextEqual(lhs->m_key, rhs->m_key) || !isValueListEqual(lhs->m_value, rhs->m_value) ||
+                !isReferenceEqual(lhs->m_ref, rhs->m_ref)) {
+            return false;
+        }
+        lhs = lhs->m_next;
+        rhs = rhs->m_next;
+    }
+
+    return lhs == rhs;
+}
+
+static bool isDataArrayListEqual(const DataArrayList *lhs, const DataArrayList *rhs) {
+    while (nullptr != lhs && nullptr != rhs) {
+        if (lhs->m_numItems != rhs->m_numItems || !isValueListEqual(lhs->m_dataList, rhs->m_dataList) ||
+                !isReferenceEqual(lhs->m_refs, rhs->m_refs)) {
+            return false;
+        }
+        lhs = lhs->m_next;
+        rhs = rhs->m_next;
+    }
+
+    return lhs == rhs;
+}
+
+static Reference *copyReference(const Reference *ref) {
+    if (nullptr == ref) {
+        return nullptr;
+    }
+
+    return new Reference(*ref);
+}
+
+static Value *copyValueList(const Value *value) {
+    Value *first(nullptr), *prev(nullptr);
+    for (; nullptr != value; value = value->getNext()) {
+        Value *current(ValueAllocator::allocPrimData(value->m_type));
+        if (nullptr == current) {
+            continue;
+        }
+        if (Value::ValueType::ddl_ref == value->m_type) {
+            current->setRef(value->getRef());
+        } else {
+            if (current->m_size != value->m_size) {
+                delete[] current->m_data;
+                current->m_data = new unsigned char[value->m_size];
+                current->m_size = value->m_size;
+            }
+            ::memcpy(current->m_data, value->m_data, value->m_size);
+        }
+
+        if (nullptr == first) {
+            first = current;
+        } else {
+            prev->setNext(current);
+        }
+        prev = current;
+    }
+
+    return first;
+}
+
+static Property *copyPropertyList(const Property *prop) {
+    Property *first(nullptr), *prev(nullptr);
+    for (; nullptr != prop; prop = prop->m_next) {
+        Text *key(nullptr == prop->m_key ? nullptr : new Text(prop->m_key->m_buffer, prop->m_key->m_len));
+        Property *current(new Property(key));
+        current->m_value = copyValueList(prop->m_value);
+        current->m_ref = copyReference(prop->m_ref);
+        if (nullptr == first) {
+            first = current;
+        } else {
+            prev->m_next = current;
+        }
+        prev = current;
+    }
+
+    return first;
+}
+
+static DataArrayList *copyDataArrayList(const DataArrayList *list) {
+    DataArrayList *first(nullptr), *prev(nullptr);
+    for (; nullptr != list; list = list->m_next) {
+        DataArrayList *current(new DataArrayList);
+        current->m_numItems = list->m_numItems;
+        current->m_dataList = copyValueList(list->m_dataList);
+        current->m_refs = copyReference(list->m_refs);
+        current->m_numRefs = list->m_numRefs;
+        if (nullptr == first) {
+            first = current;
+        } else {
+            prev->m_next = current;
+        }
+        prev = current;
+    }
+
+    return first;
+}
+
+static DDLNode *copyContent(const DDLNode *node, DDLNode *parent) {
+    DDLNode *copy(DDLNode::create(node->getType(), node->getName(), parent));
+    copy->setProperties(copyPropertyList(node->getProperties()));
+    copy->setValue(copyValueList(node->getValue()));
+    copy->setDataArrayList(copyDataArrayList(node->getDataArrayList()));
+    copy->setReferences(copyReference(node->getReferences()));
+
+    return copy;
+}
+
+static DDLNode *copyTree(const DDLNode *node, DDLNode *parent) {
+    DDLNode *copy(copyContent(node, parent));
+    const DDLNode::DllNodeList &children(node->getChildNodeList());
+    for (size_t i = 0; i < children.size(); ++i) {
+        copyTree(children[i], copy);
+    }
+
+    return copy;
+}
+
+static DDLNode *resolvePath(DDLNode *root, const std::vector<size_t> &path, size_t depth) {
+    DDLNode *current(root);
+    for (size_t i = 0; i < depth && nullptr != current; ++i) {
+        const DDLNode::DllNodeList &children(current->getChildNodeList());
+        current = path[i] < children.size() ? children[path[i]] : nullptr;
+    }
+
+    return current;
+}
+
+// Returns the indices into the input of the longest increasing subsequence, matched entries only.
+static std::vector<size_t> longestIncreasingRun(const std::vector<size_t> &values) {
+    std::vector<size_t> tails, predecessor(values.size(), NoMatch);
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (NoMatch == values[i]) {
+            continue;
+        }
+        size_t lo(0), hi(tails.size());
+        while (lo < hi) {
+            const size_t mid((lo + hi) / 2);
+            if (values[tails[mid]] < values[i]) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo > 0) {
+            predecessor[i] = tails[lo - 1];
+        }
+        if (lo == tails.size()) {
+            tails.push_back(i);
+        } else {
+            tails[lo] = i;
+        }
+    }
+
+    std::vector<size_t> result(tails.size());
+    size_t current(tails.empty() ? NoMatch : tails.back());
+    for (size_t i = result.size(); i > 0; --i) {
+        result[i - 1] = current;
+        current = predecessor[current];
+    }
+
+    return result;
+}
+
+static void buildMatchKeys(const DDLNode::DllNodeList &nodes, std::vector<std::string> &keys) {
+    // the n-th node with the same type and name gets the occurrence n, so duplicates are matched by position
+    std::unordered_map<std::string, size_t> occurrences;
+    keys.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        std::string key(nodes[i]->getType());
+        key += '\0';
+        key += nodes[i]->getName();
+        key += '\0';
+        key += std::to_string(occurrences[key]++);
+        keys[i] = key;
+    }
+}
+
+void OpenDDLDiff::diffNodes(const DDLNode *oldNode, const DDLNode *newNode, std::vector<size_t> &path, OpenDDLPatch &patch) {
+    if (!OpenDDLDiff::isContentEqual(oldNode, newNode)) {
+        patch.add(PatchOperation::Kind::UpdateNode, path, copyContent(newNode, nullptr));
+    }
+
+    const DDLNode::DllNodeList &oldChildren(oldNode->getChildNodeList());
+    const DDLNode::DllNodeList &newChildren(newNode->getChildNodeList());
+    std::vector<std::string> oldKeys, newKeys;
+    buildMatchKeys(oldChildren, oldKeys);
+    buildMatchKeys(newChildren, newKeys);
+
+    std::unordered_map<std::string, size_t> oldIndex;
+    for (size_t i = 0; i < oldKeys.size(); ++i) {
+        oldIndex[oldKeys[i]] = i;
+    }
+    std::vector<size_t> match(newChildren.size(), NoMatch);
+    for (size_t i = 0; i < newKeys.size(); ++i) {
+        std::unordered_map<std::string, size_t>::const_iterator it(oldIndex.find(newKeys[i]));
+        if (oldIndex.end() != it) {
+            match[i] = it->second;
+        }
+    }
+
+    // keep the largest set of matched children which did not change their order
+    const std::vector<size_t> kept(longestIncreasingRun(match));
+    std::vector<bool> oldKept(oldChildren.size(), false), newKept(newChildren.size(), false);
+    for (size_t i = 0; i < kept.size(); ++i) {
+        newKept[kept[i]] = true;
+        oldKept[match[kept[i]]] = true;
+    }
+
+    path.push_back(0);
+    for (size_t i = oldChildren.size(); i > 0; --i) {
+        if (!oldKept[i - 1]) {
+            path.back() = i - 1;
+            patch.add(PatchOperation::Kind::RemoveNode, path, nullptr);
+        }
+    }
+    for (size_t i = 0; i < newChildren.size(); ++i) {
+        if (!newKept[i]) {
+            path.back() = i;
+            patch.add(PatchOperation::Kind::InsertNode, path, copyTree(newChildren[i], nullptr));
+        }
+    }
+    for (size_t i = 0; i < kept.size(); ++i) {
+        path.back() = kept[i];
+        diffNodes(oldChildren[match[kept[i]]], newChildren[kept[i]], path, patch);
+    }
+    path.pop_back();
+}
+
+OpenDDLPatch::OpenDDLPatch() :
+        m_operations() {
+    // empty
+}
+
+OpenDDLPatch::~OpenDDLPatch() {
+    clear();
+}
+
+void OpenDDLPatch::clear() {
+    for (size_t i = 0; i < m_operations.size(); ++i) {
+        delete m_operations[i].m_node;
+    }
+    m_operations.clear();
+}
+
+bool OpenDDLPatch::empty() const {
+    return m_operations.empty();
+}
+
+size_t OpenDDLPatch::size() const {
+    return m_operations.size();
+}
+
+const PatchOperation &OpenDDLPatch::get(size_t idx) const {
+    return m_operations[idx];
+}
+
+void OpenDDLPatch::add(PatchOperation::Kind kind, const std::vector<size_t> &path, DDLNode *node) {
+    PatchOperation op;
+    op.m_kind = kind;
+    op.m_path = path;
+    op.m_node = node;
+    m_operations.push_back(op);
+}
+
+bool OpenDDLPatch::apply(Context *ctx) const {
+    if (nullptr == ctx || nullptr == ctx->m_root) {
+        return false;
+    }
+
+    for (size_t i = 0; i < m_operations.size(); ++i) {
+        const PatchOperation &op(m_operations[i]);
+        switch (op.m_kind) {
+            case PatchOperation::Kind::RemoveNode: {
+                DDLNode *node(resolvePath(ctx->m_root, op.m_path, op.m_path.size()));
+                if (nullptr == node || node == ctx->m_root) {
+                    return false;
+                }
+                node->detachParent();
+                delete node;
+            } break;
+
+            case PatchOperation::Kind::InsertNode: {
+                if (op.m_path.empty()) {
+                    return false;
+                }
+                DDLNode *parent(resolvePath(ctx->m_root, op.m_path, op.m_path.size() - 1));
+                if (nullptr == parent || op.m_path.back() > parent->m_children.size()) {
+                    return false;
+                }
+                DDLNode *node(copyTree(op.m_node, nullptr));
+                node->m_parent = parent;
+                parent->m_children.insert(parent->m_children.begin() + op.m_path.back(), node);
+            } break;
+
+            case PatchOperation::Kind::UpdateNode: {
+                DDLNode *node(resolvePath(ctx->m_root, op.m_path, op.m_path.size()));
+                if (nullptr == node) {
+                    return false;
+                }
+                node->setType(op.m_node->getType());
+                node->setName(op.m_node->getName());
+                node->setProperties(copyPropertyList(op.m_node->getProperties()));
+                delete node->m_value;
+                node->m_value = copyValueList(op.m_node->getValue());
+                delete node->m_dtArrayList;
+                node->m_dtArrayList = copyDataArrayList(op.m_node->getDataArrayList());
+                delete node->m_references;
+                node->m_references = copyReference(op.m_node->getReferences());
+            } break;
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool OpenDDLDiff::diff(const Context *oldCtx, const Context *newCtx, OpenDDLPatch &patch) {
+    patch.clear();
+    if (nullptr == oldCtx || nullptr == newCtx || nullptr == oldCtx->m_root || nullptr == newCtx->m_root) {
+        return false;
+    }
+
+    std::vector<size_t> path;
+    diffNodes(oldCtx->m_root, newCtx->m_root, path, patch);
+
+    return true;
+}
+
+bool OpenDDLDiff::isContentEqual(const DDLNode *lhs, const DDLNode *rhs) {
+    if (nullptr == lhs || nullptr == rhs) {
+        return lhs == rhs;
+    }
+
+    return lhs->getType() == rhs->getType() && lhs->getName() == rhs->getName() &&
+           isPropertyListEqual(lhs->getProperties(), rhs->getProperties()) &&
+           isValueListEqual(lhs->getValue(), rhs->getValue()) &&
+           isDataArrayListEqual(lhs->getDataArrayList(), rhs->getDataArrayList()) &&
+           isReferenceEqual(lhs->getReferences(), rhs->getReferences());
+}
+
+END_ODDLPARSER_NS
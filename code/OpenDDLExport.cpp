@@ -22,51 +22,52 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <openddlparser/DDLNode.h>
 #include <openddlparser/OpenDDLExport.h>
+#include <openddlparser/OpenDDLFormat.h>
 #include <openddlparser/OpenDDLParser.h>
+#include <openddlparser/OpenDDLSnapshot.h>
 #include <openddlparser/Value.h>
 
-#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
-BEGIN_ODDLPARSER_NS
-
-struct DDLNodeIterator final {
-    const DDLNode::DllNodeList &m_childs;
-    size_t m_idx;
 
-    DDLNodeIterator(const DDLNode::DllNodeList &childs) :
-            m_childs(childs), m_idx(0) {
-        // empty
-    }
+BEGIN_ODDLPARSER_NS
 
-    ~DDLNodeIterator() = default;
+static const size_t IndentWidth = 4;
 
-    bool getNext(DDLNode **node) {
-        if (m_childs.size() > (m_idx + 1)) {
-            m_idx++;
-            *node = m_childs[m_idx];
-            return true;
-        }
+static void writeLineEnd(std::string &statement) {
+    statement += '\n';
+}
 
-        return false;
-    }
+static void writeIndent(size_t level, std::string &statement) {
+    statement.append(level * IndentWidth, ' ');
+}
 
-private:
-    DDLNodeIterator() ddl_no_copy;
-    DDLNodeIterator &operator=(const DDLNodeIterator &) ddl_no_copy;
-};
+static void writeInteger(int64 value, std::string &statement) {
+    char buffer[FormatBufferSize];
+    statement.append(buffer, formatInt64(value, buffer));
+}
 
-static void writeLineEnd(std::string &statement) {
-    statement += "\n";
+static void writeUnsignedInteger(uint64 value, std::string &statement) {
+    char buffer[FormatBufferSize];
+    statement.append(buffer, formatUInt64(value, buffer));
 }
 
 OpenDDLExport::OpenDDLExport(IOStreamBase *stream) :
-        m_stream(stream) {
+        m_stream(stream),
+        m_buffer(),
+        m_numThreads(1),
+        m_parallelDepth(1) {
     if (nullptr == m_stream) {
         m_stream = new IOStreamBase();
     }
 }
 
 OpenDDLExport::~OpenDDLExport() {
+    flush();
     if (nullptr != m_stream) {
         m_stream->close();
     }
@@ -89,33 +90,179 @@ bool OpenDDLExport::exportContext(Context *ctx, const std::string &filename) {
         }
     }
 
-    const bool retValue(handleNode(root));
+    m_buffer.reserve(FlushThreshold + FlushThreshold / 4);
+    bool retValue(handleNode(root));
+    if (!flush()) {
+        retValue = false;
+    }
 
     return retValue;
 }
 
+void OpenDDLExport::setNumThreads(size_t numThreads) {
+    m_numThreads = numThreads;
+}
+
+size_t OpenDDLExport::getNumThreads() const {
+    return m_numThreads;
+}
+
+void OpenDDLExport::setParallelDepth(size_t depth) {
+    m_parallelDepth = depth > 0 ? depth : 1;
+}
+
+size_t OpenDDLExport::getParallelDepth() const {
+    return m_parallelDepth;
+}
+
+bool OpenDDLExport::exportSnapshot(Context *ctx, const std::string &filename) {
+    if (nullptr == ctx || filename.empty()) {
+        return false;
+    }
+
+    return OpenDDLSnapshot::writeFile(ctx, filename);
+}
+
 bool OpenDDLExport::handleNode(DDLNode *node) {
     if (nullptr == node) {
         return true;
     }
+    if (m_numThreads > 1) {
+        return handleNodeParallel(node);
+    }
 
     const DDLNode::DllNodeList &childs = node->getChildNodeList();
-    if (childs.empty()) {
-        return true;
+    bool success(true);
+    for (size_t i = 0; i < childs.size(); ++i) {
+        if (nullptr != childs[i] && !writeNode(childs[i], 0, m_buffer)) {
+            success = false;
+        }
     }
-    DDLNode *current(nullptr);
-    DDLNodeIterator it(childs);
-    std::string statement;
+
+    return success;
+}
+
+/// One piece of the output, either fixed text or a subtree formatted by a worker.
+struct ExportSegment {
+    std::string m_text;
+    DDLNode *m_node;
+    size_t m_level;
+    bool m_done;
+};
+
+static void addTextSegment(std::vector<ExportSegment> &segments, const std::string &text) {
+    if (segments.empty() || nullptr != segments.back().m_node) {
+        ExportSegment segment;
+        segment.m_node = nullptr;
+        segment.m_level = 0;
+        segment.m_done = true;
+        segments.push_back(segment);
+    }
+    segments.back().m_text += text;
+}
+
+void OpenDDLExport::collectSegments(DDLNode *node, size_t level, std::vector<ExportSegment> &segments) {
+    const DDLNode::DllNodeList &childs(node->getChildNodeList());
+    for (size_t i = 0; i < childs.size(); ++i) {
+        DDLNode *child(childs[i]);
+        if (nullptr == child) {
+            continue;
+        }
+
+        if (level + 1 < m_parallelDepth && !child->getChildNodeList().empty()) {
+            // split the node, its header and footer are written by the calling thread
+            std::string text;
+            writeNodeBegin(child, level, text);
+            addTextSegment(segments, text);
+            collectSegments(child, level + 1, segments);
+            text.clear();
+            writeNodeEnd(level, text);
+            addTextSegment(segments, text);
+        } else {
+            ExportSegment segment;
+            segment.m_node = child;
+            segment.m_level = level;
+            segment.m_done = false;
+            segments.push_back(segment);
+        }
+    }
+}
+
+bool OpenDDLExport::handleNodeParallel(DDLNode *node) {
+    std::vector<ExportSegment> segments;
+    collectSegments(node, 0, segments);
+
+    std::vector<size_t> tasks;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (nullptr != segments[i].m_node) {
+            tasks.push_back(i);
+        }
+    }
+
+    // the workers stay a limited number of subtrees ahead of the writer to bound the memory
+    const size_t window(m_numThreads * 4);
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t nextTask(0), writtenTasks(0);
     bool success(true);
-    while (it.getNext(&current)) {
-        if (nullptr != current) {
-            success |= writeNode(current, statement);
-            if (!handleNode(current)) {
+
+    std::vector<std::thread> workers;
+    const size_t numWorkers(std::min(m_numThreads, tasks.size()));
+    for (size_t t = 0; t < numWorkers; ++t) {
+        workers.push_back(std::thread([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                condition.wait(lock, [&]() { return nextTask == tasks.size() || nextTask < writtenTasks + window; });
+                if (nextTask == tasks.size()) {
+                    return;
+                }
+                ExportSegment &segment(segments[tasks[nextTask++]]);
+                lock.unlock();
+
+                std::string text;
+                const bool ok(writeNode(segment.m_node, segment.m_level, text));
+
+                lock.lock();
+                segment.m_text.swap(text);
+                segment.m_done = true;
+                if (!ok) {
+                    success = false;
+                }
+                condition.notify_all();
+            }
+        }));
+    }
+
+    // write all segments in document order
+    for (size_t i = 0; i < segments.size(); ++i) {
+        std::string text;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&]() { return segments[i].m_done; });
+            text.swap(segments[i].m_text);
+            if (nullptr != segments[i].m_node) {
+                ++writtenTasks;
+                condition.notify_all();
+            }
+        }
+
+        if (text.size() >= FlushThreshold) {
+            flush();
+            if (nullptr != m_stream && m_stream->isOpen() && m_stream->write(text.c_str(), text.size()) != text.size()) {
+                success = false;
+            }
+        } else {
+            m_buffer += text;
+            if (m_buffer.size() >= FlushThreshold && !flush()) {
                 success = false;
             }
         }
     }
 
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+
     return success;
 }
 
@@ -124,40 +271,108 @@ bool OpenDDLExport::writeToStream(const std::string &statement) {
         return false;
     }
 
+    // keep the order of the already buffered statements
+    flush();
     if (!statement.empty()) {
-        m_stream->write(statement);
+        m_stream->write(statement.c_str(), statement.size());
     }
 
     return true;
 }
 
-bool OpenDDLExport::writeNode(DDLNode *node, std::string &statement) {
+bool OpenDDLExport::flush() {
+    if (m_buffer.empty()) {
+        return true;
+    }
+    if (nullptr == m_stream) {
+        return false;
+    }
+
+    // like writeToStream a closed stream just drops the statements
+    const bool success(!m_stream->isOpen() || m_stream->write(m_buffer.c_str(), m_buffer.size()) == m_buffer.size());
+    m_buffer.clear();
+
+    return success;
+}
+
+bool OpenDDLExport::writeNodeBegin(DDLNode *node, size_t level, std::string &statement) {
+    if (nullptr == node) {
+        return false;
+    }
+
     bool success(true);
+    writeIndent(level, statement);
     writeNodeHeader(node, statement);
     if (node->hasProperties()) {
+        statement += ' ';
         success = writeProperties(node, statement);
     }
     writeLineEnd(statement);
+    writeIndent(level, statement);
+    statement += '{';
+    writeLineEnd(statement);
 
-    statement = "}";
     DataArrayList *al(node->getDataArrayList());
-    if (nullptr != al) {
+    if (nullptr != al && nullptr != al->m_dataList) {
+        writeIndent(level + 1, statement);
         writeValueType(al->m_dataList->m_type, al->m_numItems, statement);
+        statement += " { ";
         writeValueArray(al, statement);
+        statement += " }";
+        writeLineEnd(statement);
     }
     Value *v(node->getValue());
     if (nullptr != v) {
+        writeIndent(level + 1, statement);
         writeValueType(v->m_type, 1, statement);
-        statement = "{";
+        statement += " { ";
+        for (size_t idx = 0; nullptr != v; v = v->getNext(), ++idx) {
+            if (idx > 0) {
+                statement += ", ";
+            }
+            writeValue(v, statement);
+        }
+        statement += " }";
         writeLineEnd(statement);
-        writeValue(v, statement);
-        statement = "}";
+    }
+    Reference *refs(node->getReferences());
+    if (nullptr != refs && 0 != refs->m_numRefs) {
+        writeIndent(level + 1, statement);
+        statement += getTypeToken(Value::ValueType::ddl_ref);
+        statement += " { ";
+        writeReference(refs, statement);
+        statement += " }";
         writeLineEnd(statement);
     }
-    statement = "}";
+
+    return success;
+}
+
+void OpenDDLExport::writeNodeEnd(size_t level, std::string &statement) {
+    writeIndent(level, statement);
+    statement += '}';
     writeLineEnd(statement);
+}
+
+bool OpenDDLExport::writeNode(DDLNode *node, size_t level, std::string &statement) {
+    if (nullptr == node) {
+        return false;
+    }
+
+    bool success(writeNodeBegin(node, level, statement));
+
+    // hand big blocks over to the stream, the buffer keeps its capacity
+    if (&statement == &m_buffer && m_buffer.size() >= FlushThreshold && !flush()) {
+        success = false;
+    }
 
-    writeToStream(statement);
+    const DDLNode::DllNodeList &childs(node->getChildNodeList());
+    for (size_t i = 0; i < childs.size(); ++i) {
+        if (nullptr != childs[i] && !writeNode(childs[i], level + 1, statement)) {
+            success = false;
+        }
+    }
+    writeNodeEnd(level, statement);
 
     return success;
 }
@@ -199,9 +414,13 @@ bool OpenDDLExport::writeProperties(DDLNode *node, std::string &statement) {
             } else {
                 first = false;
             }
-            statement += std::string(prop->m_key->m_buffer);
+            statement.append(prop->m_key->m_buffer, prop->m_key->m_len);
             statement += " = ";
-            writeValue(prop->m_value, statement);
+            if (nullptr != prop->m_value) {
+                writeValue(prop->m_value, statement);
+            } else {
+                writeReference(prop->m_ref, statement);
+            }
             prop = prop->m_next;
         }
 
@@ -216,16 +435,12 @@ bool OpenDDLExport::writeValueType(Value::ValueType type, size_t numItems, std::
         return false;
     }
 
-    const std::string typeStr(getTypeToken(type));
-    statement += typeStr;
+    statement += getTypeToken(type);
     // if we have an array to write
     if (numItems > 1) {
-        statement += "[";
-        char buffer[256];
-        ::memset(buffer, '\0', 256 * sizeof(char));
-        snprintf(buffer, sizeof(buffer), "%d", static_cast<int>(numItems));
-        statement += buffer;
-        statement += "]";
+        statement += '[';
+        writeUnsignedInteger(numItems, statement);
+        statement += ']';
     }
 
     return true;
@@ -244,77 +459,57 @@ bool OpenDDLExport::writeValue(Value *val, std::string &statement) {
                 statement += "false";
             }
             break;
-        case Value::ValueType::ddl_int8 : {
-            std::stringstream stream;
-            const int i = static_cast<int>(val->getInt8());
-            stream << i;
-            statement += stream.str();
-        } break;
-        case Value::ValueType::ddl_int16: {
-            std::stringstream stream;
-            char buffer[256];
-            ::memset(buffer, '\0', 256 * sizeof(char));
-            snprintf(buffer, sizeof(buffer), "%d", val->getInt16());
-            statement += buffer;
-        } break;
-        case Value::ValueType::ddl_int32: {
-            std::stringstream stream;
-            char buffer[256];
-            ::memset(buffer, '\0', 256 * sizeof(char));
-            const int i = static_cast<int>(val->getInt32());
-            snprintf(buffer, sizeof(buffer), "%d", i);
-            statement += buffer;
-        } break;
-        case Value::ValueType::ddl_int64: {
-            std::stringstream stream;
-            const int i = static_cast<int>(val->getInt64());
-            stream << i;
-            statement += stream.str();
-        } break;
-        case Value::ValueType::ddl_unsigned_int8: {
-            std::stringstream stream;
-            const int i = static_cast<unsigned int>(val->getUnsignedInt8());
-            stream << i;
-            statement += stream.str();
-        } break;
-        case Value::ValueType::ddl_unsigned_int16: {
-            std::stringstream stream;
-            const int i = static_cast<unsigned int>(val->getUnsignedInt16());
-            stream << i;
-            statement += stream.str();
-        } break;
-        case Value::ValueType::ddl_unsigned_int32: {
-            std::stringstream stream;
-            const int i = static_cast<unsigned int>(val->getUnsignedInt32());
-            stream << i;
-            statement += stream.str();
-        } break;
-        case Value::ValueType::ddl_unsigned_int64: {
-            std::stringstream stream;
-            const int i = static_cast<unsigned int>(val->getUnsignedInt64());
-            stream << i;
-            statement += stream.str();
-        } break;
-        case Value::ValueType::ddl_half:
+        case Value::ValueType::ddl_int8:
+            writeInteger(val->getInt8(), statement);
             break;
+        case Value::ValueType::ddl_int16:
+            writeInteger(val->getInt16(), statement);
+            break;
+        case Value::ValueType::ddl_int32:
+            writeInteger(val->getInt32(), statement);
+            break;
+        case Value::ValueType::ddl_int64:
+            writeInteger(val->getInt64(), statement);
+            break;
+        case Value::ValueType::ddl_unsigned_int8:
+            writeUnsignedInteger(val->getUnsignedInt8(), statement);
+            break;
+        case Value::ValueType::ddl_unsigned_int16:
+            writeUnsignedInteger(val->getUnsignedInt16(), statement);
+            break;
+        case Value::ValueType::ddl_unsigned_int32:
+            writeUnsignedInteger(val->getUnsignedInt32(), statement);
+            break;
+        case Value::ValueType::ddl_unsigned_int64:
+            writeUnsignedInteger(val->getUnsignedInt64(), statement);
+            break;
+        case Value::ValueType::ddl_half: {
+            char buffer[FormatBufferSize];
+            const float value(val->getHalf());
+            if (std::isfinite(value)) {
+                statement.append(buffer, formatFloat(value, buffer));
+            } else {
+                // infinity and NaN are written as the bits of the half
+                uint16 bits;
+                ::memcpy(&bits, val->m_data, sizeof(uint16));
+                statement.append(buffer, static_cast<size_t>(snprintf(buffer, sizeof(buffer), "0x%04X", static_cast<unsigned int>(bits))));
+            }
+        } break;
         case Value::ValueType::ddl_float: {
-            std::stringstream stream;
-            stream << val->getFloat();
-            statement += stream.str();
+            char buffer[FormatBufferSize];
+            statement.append(buffer, formatFloat(val->getFloat(), buffer));
         } break;
         case Value::ValueType::ddl_double: {
-            std::stringstream stream;
-            stream << val->getDouble();
-            statement += stream.str();
-        } break;
-        case Value::ValueType::ddl_string: {
-            std::stringstream stream;
-            stream << val->getString();
-            statement += "\"";
-            statement += stream.str();
-            statement += "\"";
+            char buffer[FormatBufferSize];
+            statement.append(buffer, formatDouble(val->getDouble(), buffer));
         } break;
+        case Value::ValueType::ddl_string:
+            statement += '\"';
+            statement += val->getString();
+            statement += '\"';
+            break;
         case Value::ValueType::ddl_ref:
+            writeReference(val->getRef(), statement);
             break;
         case Value::ValueType::ddl_none:
         case Value::ValueType::ddl_types_max:
@@ -338,6 +533,9 @@ bool OpenDDLExport::writeValueArray(DataArrayList *al, std::string &statement) {
     Value *nextValue(nextDataArrayList->m_dataList);
     while (nullptr != nextDataArrayList) {
         if (nullptr != nextDataArrayList) {
+            if (nextDataArrayList != al) {
+                statement += ", ";
+            }
             statement += "{ ";
             nextValue = nextDataArrayList->m_dataList;
             size_t idx(0);
@@ -357,4 +555,23 @@ bool OpenDDLExport::writeValueArray(DataArrayList *al, std::string &statement) {
     return true;
 }
 
+bool OpenDDLExport::writeReference(const Reference *ref, std::string &statement) {
+    if (nullptr == ref) {
+        return false;
+    }
+
+    for (size_t i = 0; i < ref->m_numRefs; ++i) {
+        if (i > 0) {
+            statement += ", ";
+        }
+        const Name *name(ref->m_referencedName[i]);
+        statement += GlobalName == name->m_type ? '$' : '%';
+        if (nullptr != name->m_id) {
+            statement.append(name->m_id->m_buffer, name->m_id->m_len);
+        }
+    }
+
+    return true;
+}
+
 END_ODDLPARSER_NS
@@ -0,0 +1,208 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/OpenDDLHalf.h>
+
+#include <cstring>
+
+#if defined(OPENDDL_WITH_F16C) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#  define OPENDDL_F16C_PATH
+#  include <immintrin.h>
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#    define DDL_TARGET_F16C
+#  else
+#    include <cpuid.h>
+#    define DDL_TARGET_F16C __attribute__((target("avx,f16c")))
+#  endif
+#endif
+
+BEGIN_ODDLPARSER_NS
+
+static inline float bitsToFloat(uint32 bits) {
+    float value;
+    ::memcpy(&value, &bits, sizeof(float));
+
+    return value;
+}
+
+static inline uint32 floatToBits(float value) {
+    uint32 bits;
+    ::memcpy(&bits, &value, sizeof(float));
+
+    return bits;
+}
+
+float halfToFloat(uint16 bits) {
+    // move exponent and mantissa into place and rebias the exponent
+    uint32 result(static_cast<uint32>(bits & 0x7fffu) << 13);
+    const uint32 exponent(result & 0x0f800000u);
+    result += (127u - 15u) << 23;
+    if (0x0f800000u == exponent) {
+        // infinity or NaN
+        result += (128u - 16u) << 23;
+    } else if (0 == exponent) {
+        // a denormalized half is a normalized float, let the FPU normalize it
+        result += 1u << 23;
+        result = floatToBits(bitsToFloat(result) - bitsToFloat(113u << 23));
+    }
+
+    return bitsToFloat(result | (static_cast<uint32>(bits & 0x8000u) << 16));
+}
+
+uint16 floatToHalf(float value) {
+    const uint32 bits(floatToBits(value));
+    const uint32 sign((bits >> 16) & 0x8000u);
+    const uint32 absBits(bits & 0x7fffffffu);
+    if (absBits >= 0x7f800000u) {
+        // infinity stays infinity, NaN stays a quiet NaN
+        const uint32 nan(absBits > 0x7f800000u ? 0x200u | ((absBits >> 13) & 0x3ffu) : 0u);
+        return static_cast<uint16>(sign | 0x7c00u | nan);
+    }
+    if (absBits >= 0x477ff000u) {
+        // 65520 and above round to infinity
+        return static_cast<uint16>(sign | 0x7c00u);
+    }
+    if (absBits < 0x33000000u) {
+        // below half of the smallest denormalized half
+        return static_cast<uint16>(sign);
+    }
+
+    uint32 result(0), rest(0), halfway(0);
+    if (absBits < 0x38800000u) {
+        // denormalized half, shift the mantissa with its implicit bit
+        const uint32 shift(126u - (absBits >> 23));
+        const uint32 mantissa((absBits & 0x7fffffu) | 0x800000u);
+        result = mantissa >> shift;
+        rest = mantissa & ((1u << shift) - 1u);
+        halfway = 1u << (shift - 1u);
+    } else {
+        result = (absBits - 0x38000000u) >> 13;
+        rest = absBits & 0x1fffu;
+        halfway = 0x1000u;
+    }
+
+    // round to nearest even, a carry into the exponent is still correct
+    if (rest > halfway || (rest == halfway && 0 != (result & 1u))) {
+        ++result;
+    }
+
+    return static_cast<uint16>(sign | result);
+}
+
+#ifdef OPENDDL_F16C_PATH
+
+static bool detectF16C() {
+    unsigned int ecx(0);
+#ifdef _MSC_VER
+    int info[4] = { 0 };
+    __cpuid(info, 1);
+    ecx = static_cast<unsigned int>(info[2]);
+#else
+    unsigned int eax(0), ebx(0), edx(0);
+    if (0 == __get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+#endif // _MSC_VER
+
+    // F16C needs AVX and an OS which saves the AVX registers
+    const unsigned int OsxSave(1u << 27), Avx(1u << 28), F16C(1u << 29);
+    if ((ecx & (OsxSave | Avx | F16C)) != (OsxSave | Avx | F16C)) {
+        return false;
+    }
+#ifdef _MSC_VER
+    const unsigned long long xcr0(_xgetbv(0));
+#else
+    unsigned int xcrLow(0), xcrHigh(0);
+    __asm__("xgetbv" : "=a"(xcrLow), "=d"(xcrHigh) : "c"(0));
+    const unsigned long long xcr0(xcrLow | (static_cast<unsigned long long>(xcrHigh) << 32));
+#endif // _MSC_VER
+
+    return 0x6u == (xcr0 & 0x6u);
+}
+
+DDL_TARGET_F16C static void convertHalfToFloatF16C(const uint16 *in, float *out, size_t n) {
+    size_t i(0);
+    for (; i + 8 <= n; i += 8) {
+        const __m128i halfs(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(halfs));
+    }
+    for (; i < n; ++i) {
+        out[i] = halfToFloat(in[i]);
+    }
+}
+
+DDL_TARGET_F16C static void convertFloatToHalfF16C(const float *in, uint16 *out, size_t n) {
+    size_t i(0);
+    for (; i + 8 <= n; i += 8) {
+        const __m128i halfs(_mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), halfs);
+    }
+    for (; i < n; ++i) {
+        out[i] = floatToHalf(in[i]);
+    }
+}
+
+#endif // OPENDDL_F16C_PATH
+
+bool hasHalfConversionInstructions() {
+#ifdef OPENDDL_F16C_PATH
+    static const bool HasF16C(detectF16C());
+    return HasF16C;
+#else
+    return false;
+#endif // OPENDDL_F16C_PATH
+}
+
+void convertHalfToFloat(const uint16 *in, float *out, size_t n) {
+    if (nullptr == in || nullptr == out) {
+        return;
+    }
+
+#ifdef OPENDDL_F16C_PATH
+    if (hasHalfConversionInstructions()) {
+        convertHalfToFloatF16C(in, out, n);
+        return;
+    }
+#endif // OPENDDL_F16C_PATH
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = halfToFloat(in[i]);
+    }
+}
+
+void convertFloatToHalf(const float *in, uint16 *out, size_t n) {
+    if (nullptr == in || nullptr == out) {
+        return;
+    }
+
+#ifdef OPENDDL_F16C_PATH
+    if (hasHalfConversionInstructions()) {
+        convertFloatToHalfF16C(in, out, n);
+        return;
+    }
+#endif // OPENDDL_F16C_PATH
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = floatToHalf(in[i]);
+    }
+}
+
+END_ODDLPARSER_NS
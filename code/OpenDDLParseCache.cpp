@@ -0,0 +1,242 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/OpenDDLParseCache.h>
+#include <openddlparser/OpenDDLSnapshot.h>
+
+#include <cinttypes>
+#include <cstring>
+#include <utility>
+
+BEGIN_ODDLPARSER_NS
+
+// MurmurHash64A, its constants and its mixing differ from computeHash. Two inputs colliding in
+// both hashes, with the same size, are not to be expected.
+static uint64 computeCheckHash(const char *buffer, size_t len) {
+    static const uint64 Mul = 0xc6a4a7935bd1e995ULL;
+    static const int Shift = 47;
+
+    uint64 h = 0x8445d61a4e774912ULL ^ (static_cast<uint64>(len) * Mul);
+    const char *end(buffer + (len & ~static_cast<size_t>(7)));
+    for (; buffer != end; buffer += sizeof(uint64)) {
+        uint64 k;
+        ::memcpy(&k, buffer, sizeof(uint64));
+        k *= Mul;
+        k ^= k >> Shift;
+        k *= Mul;
+        h ^= k;
+        h *= Mul;
+    }
+
+    const unsigned char *tail(reinterpret_cast<const unsigned char *>(buffer));
+    switch (len & 7) {
+    case 7: h ^= static_cast<uint64>(tail[6]) << 48; // fall through
+    case 6: h ^= static_cast<uint64>(tail[5]) << 40; // fall through
+    case 5: h ^= static_cast<uint64>(tail[4]) << 32; // fall through
+    case 4: h ^= static_cast<uint64>(tail[3]) << 24; // fall through
+    case 3: h ^= static_cast<uint64>(tail[2]) << 16; // fall through
+    case 2: h ^= static_cast<uint64>(tail[1]) << 8; // fall through
+    case 1:
+        h ^= static_cast<uint64>(tail[0]);
+        h *= Mul;
+    }
+
+    h ^= h >> Shift;
+    h *= Mul;
+    h ^= h >> Shift;
+
+    return h;
+}
+
+OpenDDLParseCache::OpenDDLParseCache(size_t byteBudget, const std::string &directory) :
+        m_mutex(),
+        m_byteBudget(byteBudget),
+        m_directory(directory),
+        m_entries(),
+        m_lookup(),
+        m_stats() {
+    ::memset(&m_stats, 0, sizeof(Statistics));
+}
+
+OpenDDLParseCache::~OpenDDLParseCache() {
+    clear();
+}
+
+OpenDDLParseCache::ContextPtr OpenDDLParseCache::parse(const char *buffer, size_t len, uint32 options,
+        OpenDDLParser::logCallback callback) {
+    if (nullptr == buffer || 0 == len) {
+        return ContextPtr();
+    }
+
+    const Key key(createKey(buffer, len, options));
+    ContextPtr ctx(lookup(key));
+    if (ctx) {
+        return ctx;
+    }
+
+    // try the snapshot tier before parsing the buffer again
+    const std::string snapshotName(getSnapshotName(key));
+    if (!snapshotName.empty()) {
+        Context *loaded(OpenDDLSnapshot::readFile(snapshotName, buffer, len));
+        if (nullptr != loaded) {
+            ctx = ContextPtr(loaded);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.m_diskHits;
+            insert(key, ctx, loaded->memoryUsage().getTotal());
+            return ctx;
+        }
+    }
+
+    OpenDDLParser theParser;
+    theParser.setLogCallback(callback);
+    theParser.setBuffer(buffer, len);
+    const bool ok(theParser.parse());
+    Context *parsed(theParser.detachContext());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.m_misses;
+    }
+    if (!ok || nullptr == parsed) {
+        delete parsed;
+        return ContextPtr();
+    }
+
+    if (!snapshotName.empty()) {
+        OpenDDLSnapshot::writeFile(parsed, snapshotName, buffer, len);
+    }
+
+    const size_t bytes(parsed->memoryUsage().getTotal());
+    ctx = ContextPtr(parsed);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    insert(key, ctx, bytes);
+
+    return ctx;
+}
+
+OpenDDLParseCache::ContextPtr OpenDDLParseCache::find(const char *buffer, size_t len, uint32 options) {
+    if (nullptr == buffer || 0 == len) {
+        return ContextPtr();
+    }
+
+    return lookup(createKey(buffer, len, options));
+}
+
+void OpenDDLParseCache::setByteBudget(size_t byteBudget) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_byteBudget = byteBudget;
+    evict();
+}
+
+size_t OpenDDLParseCache::getByteBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_byteBudget;
+}
+
+void OpenDDLParseCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lookup.clear();
+    m_entries.clear();
+    m_stats.m_numEntries = 0;
+    m_stats.m_usedBytes = 0;
+}
+
+OpenDDLParseCache::Statistics OpenDDLParseCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void OpenDDLParseCache::resetStatistics() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.m_hits = 0;
+    m_stats.m_diskHits = 0;
+    m_stats.m_misses = 0;
+    m_stats.m_evictions = 0;
+}
+
+OpenDDLParseCache::Key OpenDDLParseCache::createKey(const char *buffer, size_t len, uint32 options) {
+    Key key;
+    key.m_hash = computeHash(buffer, len);
+    key.m_check = computeCheckHash(buffer, len);
+    key.m_len = len;
+    key.m_options = options;
+
+    return key;
+}
+
+OpenDDLParseCache::ContextPtr OpenDDLParseCache::lookup(const Key &key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    EntryMap::iterator it(m_lookup.find(key));
+    if (m_lookup.end() == it) {
+        return ContextPtr();
+    }
+
+    // move the entry to the front, the back is the least recently used one
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    ++m_stats.m_hits;
+
+    return it->second->m_context;
+}
+
+void OpenDDLParseCache::insert(const Key &key, const ContextPtr &ctx, size_t bytes) {
+    EntryMap::iterator it(m_lookup.find(key));
+    if (m_lookup.end() != it) {
+        // another thread was faster, keep its entry
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return;
+    }
+
+    Entry entry;
+    entry.m_key = key;
+    entry.m_context = ctx;
+    entry.m_bytes = bytes;
+    m_entries.push_front(std::move(entry));
+    m_lookup[key] = m_entries.begin();
+    ++m_stats.m_numEntries;
+    m_stats.m_usedBytes += bytes;
+
+    evict();
+}
+
+void OpenDDLParseCache::evict() {
+    while (m_stats.m_usedBytes > m_byteBudget && !m_entries.empty()) {
+        const Entry &last(m_entries.back());
+        m_stats.m_usedBytes -= last.m_bytes;
+        --m_stats.m_numEntries;
+        ++m_stats.m_evictions;
+        m_lookup.erase(last.m_key);
+        m_entries.pop_back();
+    }
+}
+
+std::string OpenDDLParseCache::getSnapshotName(const Key &key) const {
+    if (m_directory.empty()) {
+        return std::string();
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "/%016" PRIx64 "-%" PRIu64 "-%u.ddlsnap",
+            static_cast<uint64_t>(key.m_hash), static_cast<uint64_t>(key.m_len), key.m_options);
+
+    return m_directory + name;
+}
+
+END_ODDLPARSER_NS
@@ -20,15 +20,27 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
+#include <openddlparser/MemoryMappedFile.h>
+#include <openddlparser/OpenDDLCompression.h>
 #include <openddlparser/OpenDDLExport.h>
 #include <openddlparser/OpenDDLParser.h>
+#include <openddlparser/OpenDDLSnapshot.h>
+#include <openddlparser/OpenDDLTrace.h>
 
 #include <math.h>
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
+#ifdef OPENDDL_HAVE_SDT
+#include <sys/sdt.h>
+#endif
+
 #ifdef _WIN32
 #   ifndef WIN32_LEAN_AND_MEAN
 #     define WIN32_LEAN_AND_MEAN
@@ -75,17 +87,6 @@ const char *getTypeToken(Value::ValueType type) {
     return Grammar::PrimitiveTypeToken[(size_t)type];
 }
 
-static void logInvalidTokenError(const std::string &in, const std::string &exp, OpenDDLParser::logCallback callback) {
-    if (callback) {\
-        std::string part(in.substr(0, 50));
-        std::stringstream stream;
-        stream << "Invalid token \"" << in << "\" "
-               << "(expected \"" << exp << "\") "
-               << "in: \"" << part << "\"";
-        callback(ddl_error_msg, stream.str());
-    }
-}
-
 static bool isIntegerType(Value::ValueType integerType) {
     if (integerType != Value::ValueType::ddl_int8 && integerType != Value::ValueType::ddl_int16 &&
             integerType != Value::ValueType::ddl_int32 && integerType != Value::ValueType::ddl_int64) {
@@ -104,28 +105,563 @@ static bool isUnsignedIntegerType(Value::ValueType integerType) {
     return true;
 }
 
-static DDLNode *createDDLNode(Text *id, OpenDDLParser *parser) {
-    if (nullptr == id || nullptr == parser || id->m_buffer == nullptr) {
+// the statistics of the parse running in this thread, nullptr if they are disabled
+static thread_local ParseStats *s_parseStats = nullptr;
+
+// the first malformed literal of the data list parsed in this thread, reported by the parser afterwards
+static thread_local const char *s_invalidLiteral = nullptr;
+
+// activates the statistics for the parse running in this thread
+class ParseStatsScope {
+public:
+    explicit ParseStatsScope(ParseStats *stats) :
+            m_previous(s_parseStats) {
+        s_parseStats = stats;
+    }
+
+    ~ParseStatsScope() {
+        s_parseStats = m_previous;
+    }
+
+private:
+    ParseStats *m_previous;
+};
+
+#ifdef OPENDDL_TRACING
+
+// the text of the parse running in this thread, used to compute the offsets of the events
+static thread_local const char *s_traceBuffer = nullptr;
+static thread_local const SourceMap *s_traceSourceMap = nullptr;
+
+// sets the text for the events of the parse running in this thread
+class TraceScope {
+public:
+    TraceScope(const char *buffer, const SourceMap *sourceMap) :
+            m_previousBuffer(s_traceBuffer),
+            m_previousSourceMap(s_traceSourceMap) {
+        s_traceBuffer = buffer;
+        s_traceSourceMap = sourceMap;
+    }
+
+    ~TraceScope() {
+        s_traceBuffer = m_previousBuffer;
+        s_traceSourceMap = m_previousSourceMap;
+    }
+
+private:
+    const char *m_previousBuffer;
+    const SourceMap *m_previousSourceMap;
+};
+
+static void emitTrace(TraceEvent event, const char *name, const char *pos, size_t size) {
+    OpenDDLTracer *tracer(OpenDDLTracer::getInstalled());
+#ifndef OPENDDL_HAVE_SDT
+    // without the USDT probes nobody else is listening
+    if (nullptr == tracer) {
+        return;
+    }
+#endif // OPENDDL_HAVE_SDT
+
+    size_t offset(0);
+    if (nullptr != s_traceBuffer && nullptr != pos && pos >= s_traceBuffer) {
+        offset = static_cast<size_t>(pos - s_traceBuffer);
+        if (nullptr != s_traceSourceMap) {
+            offset = s_traceSourceMap->toSource(offset);
+        }
+    }
+    if (nullptr == name) {
+        name = "";
+    }
+
+#ifdef OPENDDL_HAVE_SDT
+    switch (event) {
+        case ddl_trace_structure_begin:
+            DTRACE_PROBE3(openddlparser, structure_begin, name, offset, size);
+            break;
+        case ddl_trace_structure_end:
+            DTRACE_PROBE3(openddlparser, structure_end, name, offset, size);
+            break;
+        case ddl_trace_data_list:
+            DTRACE_PROBE3(openddlparser, data_list, name, offset, size);
+            break;
+        case ddl_trace_error:
+            DTRACE_PROBE3(openddlparser, error, name, offset, size);
+            break;
+        case ddl_trace_allocation:
+            DTRACE_PROBE3(openddlparser, allocation, name, offset, size);
+            break;
+        default:
+            break;
+    }
+#endif // OPENDDL_HAVE_SDT
+
+    if (nullptr != tracer) {
+        TraceRecord record;
+        record.m_event = event;
+        record.m_nanoseconds = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        record.m_offset = offset;
+        record.m_size = size;
+        record.m_name = name;
+        tracer->trace(record);
+    }
+}
+
+static const char *getTraceTypeName(Value::ValueType type) {
+    if (type <= Value::ValueType::ddl_none || type >= Value::ValueType::ddl_types_max) {
+        return "";
+    }
+
+    return getTypeToken(type);
+}
+
+#  define DDL_TRACE(event, name, pos, size) emitTrace(event, name, pos, size)
+#else
+#  define DDL_TRACE(event, name, pos, size)
+#endif // OPENDDL_TRACING
+
+// formats the message only when the severity passes the filter of the parser
+#define DDL_LOG(severity, ...)                      \
+    do {                                            \
+        if (isLogged(severity)) {                   \
+            logFormat(severity, __VA_ARGS__);       \
+        }                                           \
+    } while (false)
+
+#ifdef OPENDDL_PHASE_TIMERS
+
+// the timings of the parse running in this thread, nullptr if they are disabled
+static thread_local ParseTimings *s_parseTimings = nullptr;
+
+class ScopedTimer;
+
+// the innermost running phase and structure timer, used to compute the self times
+static thread_local ScopedTimer *s_activePhase = nullptr;
+static thread_local ScopedTimer *s_activeStructure = nullptr;
+
+static inline double secondsSince(const std::chrono::steady_clock::time_point &start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// measures the self time of one scope, the time of nested scopes is subtracted
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ScopedTimer *&active) :
+            m_active(active),
+            m_parent(active),
+            m_childSeconds(0.0),
+            m_start() {
+        if (nullptr != s_parseTimings) {
+            m_active = this;
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    bool isRunning() const {
+        return m_active == this;
+    }
+
+    // stops the timer and returns the self time
+    double stop() {
+        const double seconds(secondsSince(m_start));
+        if (nullptr != m_parent) {
+            m_parent->m_childSeconds += seconds;
+        }
+        m_active = m_parent;
+
+        return seconds - m_childSeconds;
+    }
+
+private:
+    ScopedTimer *&m_active;
+    ScopedTimer *m_parent;
+    double m_childSeconds;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+class PhaseTimer {
+public:
+    explicit PhaseTimer(ParsePhase phase) :
+            m_phase(phase),
+            m_timer(s_activePhase) {
+        // empty
+    }
+
+    ~PhaseTimer() {
+        if (m_timer.isRunning()) {
+            const double seconds(m_timer.stop());
+            ++s_parseTimings->m_phases[m_phase].m_calls;
+            s_parseTimings->m_phases[m_phase].m_seconds += seconds;
+        }
+    }
+
+private:
+    ParsePhase m_phase;
+    ScopedTimer m_timer;
+};
+
+// the type of a structure is only known after its header was parsed
+class StructureTimer {
+public:
+    StructureTimer() :
+            m_node(nullptr),
+            m_timer(s_activeStructure) {
+        // empty
+    }
+
+    ~StructureTimer() {
+        if (m_timer.isRunning()) {
+            const double seconds(m_timer.stop());
+            if (nullptr != m_node) {
+                ParseTimings::Timing &timing(s_parseTimings->m_structures[m_node->getType()]);
+                ++timing.m_calls;
+                timing.m_seconds += seconds;
+            }
+        }
+    }
+
+    void setNode(DDLNode *node) {
+        m_node = node;
+    }
+
+private:
+    DDLNode *m_node;
+    ScopedTimer m_timer;
+};
+
+static std::string formatParseTimings(const ParseTimings &timings) {
+    std::ostringstream stream;
+    stream << "Parse timings: total " << timings.m_totalSeconds * 1000.0 << " ms";
+    for (size_t i = 0; i < ddl_num_parse_phases; ++i) {
+        const ParseTimings::Timing &timing(timings.m_phases[i]);
+        stream << ", " << ParseTimings::getPhaseName(static_cast<ParsePhase>(i)) << " " << timing.m_seconds * 1000.0
+               << " ms (" << timing.m_calls << ")";
+    }
+    for (ParseTimings::StructureTimings::const_iterator it = timings.m_structures.begin(); it != timings.m_structures.end(); ++it) {
+        stream << ", " << it->first << " " << it->second.m_seconds * 1000.0 << " ms (" << it->second.m_calls << ")";
+    }
+
+    return stream.str();
+}
+
+// activates the timers for the parse running in this thread and reports the timings at the end
+class ParseTimingsScope {
+public:
+    typedef std::function<void(const std::string &msg)> ReportCallback;
+
+    ParseTimingsScope(ParseTimings *timings, const ReportCallback &callback) :
+            m_previous(s_parseTimings),
+            m_previousPhase(s_activePhase),
+            m_previousStructure(s_activeStructure),
+            m_callback(callback),
+            m_start(std::chrono::steady_clock::now()) {
+        s_parseTimings = timings;
+        s_activePhase = nullptr;
+        s_activeStructure = nullptr;
+    }
+
+    ~ParseTimingsScope() {
+        if (nullptr != s_parseTimings) {
+            s_parseTimings->m_totalSeconds = secondsSince(m_start);
+            if (m_callback) {
+                m_callback(formatParseTimings(*s_parseTimings));
+            }
+        }
+        s_parseTimings = m_previous;
+        s_activePhase = m_previousPhase;
+        s_activeStructure = m_previousStructure;
+    }
+
+private:
+    ParseTimings *m_previous;
+    ScopedTimer *m_previousPhase;
+    ScopedTimer *m_previousStructure;
+    ReportCallback m_callback;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#  define DDL_PHASE_TIMER(phase) PhaseTimer ddlPhaseTimer(phase)
+#  define DDL_PARSE_TIMINGS_SCOPE() \
+        ParseTimingsScope ddlTimingsScope(m_parseTimingsEnabled ? &m_parseTimings : nullptr, \
+                isLogged(ddl_info_msg) ? ParseTimingsScope::ReportCallback([this](const std::string &msg) { \
+                    logMessage(ddl_info_msg, msg.c_str(), msg.size()); \
+                }) : ParseTimingsScope::ReportCallback())
+#else
+#  define DDL_PHASE_TIMER(phase)
+#  define DDL_PARSE_TIMINGS_SCOPE()
+#endif // OPENDDL_PHASE_TIMERS
+
+static inline void countObject(ParseObjectKind kind, size_t bytes) {
+    if (nullptr != s_parseStats) {
+        ++s_parseStats->m_allocations[kind].m_count;
+        s_parseStats->m_allocations[kind].m_bytes += bytes;
+    }
+}
+
+static inline void countNode() {
+    if (nullptr != s_parseStats) {
+        countObject(ddl_node_object, sizeof(DDLNode));
+        ++s_parseStats->m_numNodes;
+    }
+}
+
+static Value *allocValue(Value::ValueType type, size_t len = 0) {
+    DDL_PHASE_TIMER(ddl_allocation_phase);
+    Value *value(ValueAllocator::allocPrimData(type, len));
+    if (nullptr != s_parseStats && nullptr != value) {
+        countObject(ddl_value_object, sizeof(Value) + value->m_size);
+        ++s_parseStats->m_numValues;
+    }
+    if (nullptr != value) {
+        DDL_TRACE(ddl_trace_allocation, "Value", nullptr, sizeof(Value) + value->m_size);
+    }
+
+    return value;
+}
+
+static Reference *createReference(std::vector<Name *> &names) {
+    DDL_PHASE_TIMER(ddl_allocation_phase);
+    countObject(ddl_reference_object, sizeof(Reference) + names.size() * sizeof(Name *));
+    DDL_TRACE(ddl_trace_allocation, "Reference", nullptr, sizeof(Reference) + names.size() * sizeof(Name *));
+    return new Reference(names.size(), &names[0]);
+}
+
+static DDLNode *createDDLNode(const char *type, size_t len, OpenDDLParser *parser) {
+    if (nullptr == type || 0 == len || nullptr == parser) {
         return nullptr;
     }
 
-    const std::string type{id->m_buffer};
+    DDL_PHASE_TIMER(ddl_node_creation_phase);
     DDLNode *parent = parser->top();
-    DDLNode *node = DDLNode::create(type, "", parent);
+    DDLNode *node = DDLNode::create(std::string(type, len), std::string(), parent);
+    countNode();
+    DDL_TRACE(ddl_trace_allocation, "DDLNode", nullptr, sizeof(DDLNode));
 
     return node;
 }
 
+SourceMap::SourceMap() :
+        m_jumps(),
+        m_lineBreaks() {
+    // empty
+}
+
+void SourceMap::clear() {
+    m_jumps.clear();
+    m_lineBreaks.clear();
+}
+
+void SourceMap::addJump(size_t normalizedOffset, size_t sourceOffset) {
+    Jump jump;
+    jump.m_normalized = normalizedOffset;
+    jump.m_source = sourceOffset;
+    m_jumps.push_back(jump);
+}
+
+size_t SourceMap::toSource(size_t normalizedOffset) const {
+    // look for the last jump in front of the offset, before the first jump both offsets are equal
+    size_t first(0), count(m_jumps.size());
+    while (count > 0) {
+        const size_t step(count / 2);
+        if (m_jumps[first + step].m_normalized <= normalizedOffset) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    if (0 == first) {
+        return normalizedOffset;
+    }
+
+    const Jump &jump(m_jumps[first - 1]);
+    return jump.m_source + (normalizedOffset - jump.m_normalized);
+}
+
+void SourceMap::addLineBreak(size_t sourceOffset) {
+    m_lineBreaks.push_back(sourceOffset);
+}
+
+void SourceMap::getLineColumn(size_t sourceOffset, size_t &line, size_t &column) const {
+    // the number of line breaks in front of the offset is the line index
+    const std::vector<size_t>::const_iterator it(std::lower_bound(m_lineBreaks.begin(), m_lineBreaks.end(), sourceOffset));
+    const size_t lineIdx(static_cast<size_t>(it - m_lineBreaks.begin()));
+    const size_t lineBegin(0 == lineIdx ? 0 : m_lineBreaks[lineIdx - 1] + 1);
+    line = lineIdx + 1;
+    column = sourceOffset - lineBegin + 1;
+}
+
+// Removes comments and line breaks, the input can be handed over in chunks.
+class BufferNormalizer {
+public:
+    // the comment detection looks ahead at most this number of characters
+    static const size_t LookAhead = 4;
+
+    BufferNormalizer(std::vector<char> &normalized, SourceMap *sourceMap) :
+            m_normalized(normalized),
+            m_sourceMap(sourceMap),
+            m_state(Content),
+            m_offset(0),
+            m_skipped(0) {
+        // empty
+    }
+
+    // Returns the number of consumed characters. Unless it is the last chunk, up to LookAhead - 1
+    // characters at the end stay unconsumed and have to be handed over again with the next chunk.
+    size_t feed(const char *data, size_t len, bool last) {
+        const char *end(data + len);
+        const size_t limit(last ? len : (len >= LookAhead ? len - LookAhead + 1 : 0));
+        size_t idx(0);
+        while (idx < limit) {
+            const char *c(data + idx);
+            if ('\n' == *c && nullptr != m_sourceMap) {
+                m_sourceMap->addLineBreak(m_offset + idx);
+            }
+            if (BlockComment == m_state) {
+                if (isCommentCloseTag(c, end)) {
+                    m_state = Content;
+                    ++idx;
+                }
+            } else if (LineComment == m_state) {
+                if (isEndofLine(*c)) {
+                    m_state = Content;
+                }
+            } else if (isCommentOpenTag(c, end)) {
+                // the close tag is searched starting at the '*' of the open tag
+                m_state = BlockComment;
+            } else if (isComment<const char>(c, end)) {
+                m_state = LineComment;
+                ++idx;
+            } else if (!isNewLine(*c)) {
+                const size_t sourceIdx(m_offset + idx);
+                if (nullptr != m_sourceMap && sourceIdx != m_normalized.size() + m_skipped) {
+                    m_skipped = sourceIdx - m_normalized.size();
+                    m_sourceMap->addJump(m_normalized.size(), sourceIdx);
+                }
+                m_normalized.push_back(*c);
+            }
+            ++idx;
+        }
+        m_offset += idx;
+
+        return idx;
+    }
+
+    // Returns the number of consumed characters over all chunks.
+    size_t getOffset() const {
+        return m_offset;
+    }
+
+private:
+    enum State {
+        Content,
+        BlockComment,
+        LineComment
+    };
+
+    std::vector<char> &m_normalized;
+    SourceMap *m_sourceMap;
+    State m_state;
+    size_t m_offset;
+    size_t m_skipped;
+};
+
+static void mapSourceRanges(DDLNode *node, const SourceMap &sourceMap) {
+    const DDLNode::DllNodeList &children(node->getChildNodeList());
+    for (size_t i = 0; i < children.size(); ++i) {
+        DDLNode *child(children[i]);
+        const size_t begin(sourceMap.toSource(child->getSourceBegin()));
+        const size_t end(child->getSourceEnd() > 0 ? sourceMap.toSource(child->getSourceEnd() - 1) + 1 : begin);
+        child->setSourceRange(begin, end);
+        mapSourceRanges(child, sourceMap);
+    }
+}
+
+static void moveSourceRanges(DDLNode *node, size_t offset) {
+    node->setSourceRange(node->getSourceBegin() + offset, node->getSourceEnd() + offset);
+    const DDLNode::DllNodeList &children(node->getChildNodeList());
+    for (size_t i = 0; i < children.size(); ++i) {
+        moveSourceRanges(children[i], offset);
+    }
+}
+
+static void shiftSourceRanges(DDLNode *node, size_t oldEnd, size_t removedLen, size_t insertedLen, const DDLNode *skip) {
+    if (node == skip) {
+        return;
+    }
+
+    size_t begin(node->getSourceBegin()), end(node->getSourceEnd());
+    if (begin >= oldEnd) {
+        begin = begin - removedLen + insertedLen;
+    }
+    if (end >= oldEnd) {
+        end = end - removedLen + insertedLen;
+    }
+    node->setSourceRange(begin, end);
+
+    const DDLNode::DllNodeList &children(node->getChildNodeList());
+    for (size_t i = 0; i < children.size(); ++i) {
+        shiftSourceRanges(children[i], oldEnd, removedLen, insertedLen, skip);
+    }
+}
+
+static DDLNode *findEnclosingNode(DDLNode *node, size_t begin, size_t end) {
+    DDLNode *found(nullptr);
+    while (nullptr != node) {
+        // the children are ordered by their source offset
+        const DDLNode::DllNodeList &children(node->getChildNodeList());
+        size_t first(0), count(children.size());
+        while (count > 0) {
+            const size_t step(count / 2);
+            if (children[first + step]->getSourceBegin() <= begin) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        if (0 == first || children[first - 1]->getSourceEnd() < end) {
+            break;
+        }
+        node = children[first - 1];
+        found = node;
+    }
+
+    return found;
+}
+
 OpenDDLParser::OpenDDLParser() :
         m_logCallback(nullptr),
+        m_logSink(nullptr),
+        m_logSinkData(nullptr),
+        m_logSeverity(ddl_info_msg),
         m_buffer(),
         m_stack(),
-        m_context(nullptr) {
-    // empty
+        m_context(nullptr),
+        m_sourceMap(),
+        m_diagnostics(),
+        m_parseStatsEnabled(false),
+        m_parseStats(),
+        m_parseTimingsEnabled(false),
+        m_parseTimings() {
+    applyLogEnvironment();
 }
 
 OpenDDLParser::OpenDDLParser(const char *buffer, size_t len) :
-        m_logCallback(nullptr), m_buffer(), m_context(nullptr) {
+        m_logCallback(nullptr), m_logSink(nullptr), m_logSinkData(nullptr), m_logSeverity(ddl_info_msg), m_buffer(), m_context(nullptr), m_sourceMap(), m_diagnostics(),
+        m_parseStatsEnabled(false), m_parseStats(),
+        m_parseTimingsEnabled(false), m_parseTimings() {
+    applyLogEnvironment();
+    if (0 != len) {
+        setBuffer(buffer, len);
+    }
+}
+
+OpenDDLParser::OpenDDLParser(const char *buffer, size_t len, LogSeverity severity) :
+        m_logCallback(nullptr), m_logSink(nullptr), m_logSinkData(nullptr), m_logSeverity(severity), m_buffer(), m_context(nullptr), m_sourceMap(), m_diagnostics(),
+        m_parseStatsEnabled(false), m_parseStats(),
+        m_parseTimingsEnabled(false), m_parseTimings() {
+    // no lookup of OPENDDL_LOG_LEVEL, the severity is fixed by the owner
     if (0 != len) {
         setBuffer(buffer, len);
     }
@@ -143,11 +679,16 @@ void OpenDDLParser::logToStream(FILE *f, LogSeverity severity, const std::string
         case ddl_info_msg:  tag = "info";  break;
         case ddl_warn_msg:  tag = "warn";  break;
         case ddl_error_msg: tag = "error"; break;
+        default: break;
         }
         fprintf(f, "OpenDDLParser: (%5s) %s\n", tag, message.c_str());
     }
 }
 
+void OpenDDLParser::logToStderr(LogSeverity severity, const char *msg, size_t len, void *) {
+    logToStream(stderr, severity, std::string(msg, len));
+}
+
 OpenDDLParser::logCallback OpenDDLParser::StdLogCallback (FILE *destination) {
     using namespace std::placeholders;
     return std::bind(logToStream, destination ? destination : stderr, _1, _2);
@@ -156,12 +697,131 @@ OpenDDLParser::logCallback OpenDDLParser::StdLogCallback (FILE *destination) {
 void OpenDDLParser::setLogCallback(logCallback callback) {
     // install user-specific log callback; null = no log callback
     m_logCallback = callback;
+    if (logToStderr == m_logSink) {
+        // the sink of OPENDDL_LOG_LEVEL is only a default
+        m_logSink = nullptr;
+    }
 }
 
 OpenDDLParser::logCallback OpenDDLParser::getLogCallback() const {
     return m_logCallback;
 }
 
+void OpenDDLParser::setLogSink(logSink sink, void *userData) {
+    m_logSink = sink;
+    m_logSinkData = userData;
+}
+
+OpenDDLParser::logSink OpenDDLParser::getLogSink() const {
+    return m_logSink;
+}
+
+void OpenDDLParser::setLogSeverity(LogSeverity severity) {
+    m_logSeverity = severity;
+}
+
+LogSeverity OpenDDLParser::getLogSeverity() const {
+    return m_logSeverity;
+}
+
+const std::vector<ParseDiagnostic> &OpenDDLParser::getDiagnostics() const {
+    return m_diagnostics;
+}
+
+void OpenDDLParser::getLineColumn(size_t offset, size_t &line, size_t &column) const {
+    m_sourceMap.getLineColumn(offset, line, column);
+}
+
+std::string OpenDDLParser::formatDiagnostic(const ParseDiagnostic &diagnostic) const {
+    size_t line(0), column(0);
+    getLineColumn(diagnostic.m_offset, line, column);
+
+    std::stringstream stream;
+    switch (diagnostic.m_code) {
+        case ddl_unexpected_token:
+            stream << "Invalid token (expected \"" << diagnostic.m_expected << "\")";
+            break;
+        case ddl_invalid_array_size:
+            stream << "0 for array is invalid";
+            break;
+        case ddl_invalid_structure:
+            stream << "Cannot create a node for the structure";
+            break;
+        case ddl_invalid_literal:
+            stream << "Invalid literal";
+            break;
+        default:
+            stream << "Unknown diagnostic";
+            break;
+    }
+    stream << " at line " << line << ", column " << column;
+
+    return stream.str();
+}
+
+bool OpenDDLParser::isLogged(LogSeverity severity) const {
+    // the severity is checked first, it is the common case for disabled messages
+    return severity >= m_logSeverity && (nullptr != m_logSink || m_logCallback);
+}
+
+void OpenDDLParser::logMessage(LogSeverity severity, const char *msg, size_t len) const {
+    if (nullptr != m_logSink) {
+        m_logSink(severity, msg, len, m_logSinkData);
+    } else if (m_logCallback) {
+        m_logCallback(severity, std::string(msg, len));
+    }
+}
+
+void OpenDDLParser::logFormat(LogSeverity severity, const char *format, ...) const {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    const int len(vsnprintf(buffer, sizeof(buffer), format, args));
+    va_end(args);
+    if (len < 0) {
+        return;
+    }
+
+    logMessage(severity, buffer, std::min(static_cast<size_t>(len), sizeof(buffer) - 1));
+}
+
+void OpenDDLParser::applyLogEnvironment() {
+    const char *level(getenv("OPENDDL_LOG_LEVEL"));
+    if (nullptr == level) {
+        return;
+    }
+
+    static const char *Names[] = { "debug", "info", "warn", "error", "none" };
+    for (size_t i = 0; i < sizeof(Names) / sizeof(Names[0]); ++i) {
+        if (0 == strcmp(level, Names[i])) {
+            m_logSeverity = static_cast<LogSeverity>(ddl_debug_msg + i);
+            m_logSink = logToStderr;
+            return;
+        }
+    }
+}
+
+void OpenDDLParser::reportDiagnostic(DiagnosticCode code, const char *pos, const char *expected) {
+    const char *begin(m_buffer.empty() ? nullptr : &m_buffer[0]);
+    const size_t normalizedOffset(nullptr != begin && nullptr != pos ? static_cast<size_t>(pos - begin) : 0);
+
+    ParseDiagnostic diagnostic;
+    diagnostic.m_code = code;
+    diagnostic.m_severity = ddl_error_msg;
+    diagnostic.m_offset = m_sourceMap.toSource(normalizedOffset);
+    diagnostic.m_expected = nullptr == expected ? "" : expected;
+    m_diagnostics.push_back(diagnostic);
+
+    // the message is only formatted for somebody who listens
+    if (isLogged(diagnostic.m_severity)) {
+        static const size_t ExcerptLen = 50;
+        const size_t excerptLen(std::min(ExcerptLen, m_buffer.size() - std::min(normalizedOffset, m_buffer.size())));
+        const std::string excerpt(0 == excerptLen ? std::string() : std::string(begin + normalizedOffset, excerptLen));
+        const std::string msg(formatDiagnostic(diagnostic) + ": \"" + excerpt + "\"");
+        logMessage(diagnostic.m_severity, msg.c_str(), msg.size());
+    }
+}
+
 void OpenDDLParser::setBuffer(const char *buffer, size_t len) {
     clear();
     if (0 == len) {
@@ -178,6 +838,43 @@ void OpenDDLParser::setBuffer(const std::vector<char> &buffer) {
     std::copy(buffer.begin(), buffer.end(), m_buffer.begin());
 }
 
+void OpenDDLParser::setBuffer(std::vector<char> &&buffer) {
+    clear();
+    m_buffer = std::move(buffer);
+}
+
+void OpenDDLParser::setParseStatsEnabled(bool enabled) {
+    m_parseStatsEnabled = enabled;
+}
+
+bool OpenDDLParser::isParseStatsEnabled() const {
+    return m_parseStatsEnabled;
+}
+
+const ParseStats &OpenDDLParser::getParseStats() const {
+    return m_parseStats;
+}
+
+void OpenDDLParser::setParseTimingsEnabled(bool enabled) {
+    m_parseTimingsEnabled = enabled;
+}
+
+bool OpenDDLParser::isParseTimingsEnabled() const {
+    return m_parseTimingsEnabled;
+}
+
+const ParseTimings &OpenDDLParser::getParseTimings() const {
+    return m_parseTimings;
+}
+
+bool OpenDDLParser::hasParseTimers() {
+#ifdef OPENDDL_PHASE_TIMERS
+    return true;
+#else
+    return false;
+#endif // OPENDDL_PHASE_TIMERS
+}
+
 const char *OpenDDLParser::getBuffer() const {
     if (m_buffer.empty()) {
         return nullptr;
@@ -194,6 +891,9 @@ void OpenDDLParser::clear() {
     m_buffer.resize(0);
     delete m_context;
     m_context = nullptr;
+    m_stack.clear();
+    m_sourceMap.clear();
+    m_diagnostics.clear();
 }
 
 bool OpenDDLParser::validate() {
@@ -209,19 +909,125 @@ bool OpenDDLParser::validate() {
 }
 
 bool OpenDDLParser::parse() {
+    m_parseTimings.clear();
     if (m_buffer.empty()) {
         return false;
     }
 
-    normalizeBuffer(m_buffer);
+    DDL_PARSE_TIMINGS_SCOPE();
+    const size_t sourceLen(m_buffer.size());
+    normalizeBuffer(m_buffer, &m_sourceMap);
+
+    return parseNormalized(sourceLen);
+}
+
+bool OpenDDLParser::parseFile(const std::string &filename) {
+    clear();
+    m_parseTimings.clear();
+    DDL_PARSE_TIMINGS_SCOPE();
+
+    MemoryMappedFile file;
+    if (file.open(filename) && !isCompressedBuffer(file.getData(), file.getSize())) {
+        // normalize straight from the mapping, there is no copy of the raw content
+        const size_t sourceLen(file.getSize());
+        normalizeBuffer(file.getData(), sourceLen, m_buffer, &m_sourceMap);
+        file.close();
+        if (0 == sourceLen) {
+            return false;
+        }
+        return parseNormalized(sourceLen);
+    }
+    file.close();
+
+    // compressed files and inputs which cannot be mapped, like pipes, are read chunk by chunk
+    CompressedInputStream stream;
+    if (!stream.open(filename)) {
+        if (isLogged(ddl_error_msg)) {
+            logFormat(ddl_error_msg, "Cannot read file \"%s\".", filename.c_str());
+        }
+        return false;
+    }
+
+    const size_t sourceLen(normalizeStream(stream));
+    if (stream.hasError()) {
+        if (isLogged(ddl_error_msg)) {
+            logFormat(ddl_error_msg, "Cannot read or decompress file \"%s\".", filename.c_str());
+        }
+        return false;
+    }
+    if (0 == sourceLen) {
+        return false;
+    }
+
+    return parseNormalized(sourceLen);
+}
+
+bool OpenDDLParser::parseStream(IOStreamBase &stream) {
+    clear();
+    m_parseTimings.clear();
+    DDL_PARSE_TIMINGS_SCOPE();
+    const size_t sourceLen(normalizeStream(stream));
+    if (0 == sourceLen) {
+        return false;
+    }
+
+    return parseNormalized(sourceLen);
+}
+
+size_t OpenDDLParser::normalizeStream(IOStreamBase &stream) {
+    static const size_t ChunkSize = 256 * 1024;
+
+    m_buffer.clear();
+    m_sourceMap.clear();
+    BufferNormalizer normalizer(m_buffer, &m_sourceMap);
+    std::string chunk, pending;
+    for (;;) {
+        const size_t readBytes(stream.read(ChunkSize, chunk));
+        const bool last(0 == readBytes);
+        // only the few characters of the look-ahead are carried over to the next chunk
+        DDL_PHASE_TIMER(ddl_normalize_phase);
+        if (pending.empty()) {
+            const size_t consumed(normalizer.feed(chunk.c_str(), readBytes, last));
+            pending.assign(chunk.c_str() + consumed, readBytes - consumed);
+        } else {
+            pending.append(chunk.c_str(), readBytes);
+            pending.erase(0, normalizer.feed(pending.c_str(), pending.size(), last));
+        }
+        if (last) {
+            break;
+        }
+    }
+
+    return normalizer.getOffset();
+}
+
+bool OpenDDLParser::parseNormalized(size_t sourceLen) {
+    m_parseStats.clear();
+    m_diagnostics.clear();
     if (!validate()) {
         return false;
     }
 
+    ParseStatsScope statsScope(m_parseStatsEnabled ? &m_parseStats : nullptr);
+#ifdef OPENDDL_TRACING
+    TraceScope traceScope(m_buffer.empty() ? nullptr : &m_buffer[0], &m_sourceMap);
+#endif // OPENDDL_TRACING
+    m_parseStats.m_inputBytes = sourceLen;
+
+    // a parser can be used more than once, the new context replaces the previous one
+    delete m_context;
+    m_stack.clear();
     m_context = new Context;
     m_context->m_root = DDLNode::create("root", "", nullptr);
+    countNode();
+    m_context->m_root->setSourceRange(0, sourceLen);
     pushNode(m_context->m_root);
 
+    if (m_buffer.empty()) {
+        // nothing but comments
+        return true;
+    }
+
     // do the main parsing
     char *current(&m_buffer[0]);
     char *end(&m_buffer[m_buffer.size() - 1] + 1);
@@ -233,6 +1039,82 @@ bool OpenDDLParser::parse() {
         }
         pos = current - &m_buffer[0];
     }
+    mapSourceRanges(m_context->m_root, m_sourceMap);
+
+    return true;
+}
+
+// the line break closes an open line comment in front of the sentinel
+static const char *ReparseSentinel = "\nx{float{0}}";
+
+bool OpenDDLParser::reparse(const char *buffer, size_t len, size_t editOffset, size_t removedLen, size_t insertedLen) {
+    DDLNode *root(getRoot());
+    if (nullptr == buffer || nullptr == root || editOffset + insertedLen > len ||
+            editOffset + removedLen > root->getSourceEnd() ||
+            len + removedLen != root->getSourceEnd() + insertedLen) {
+        // no usable previous parse, so parse all
+        setBuffer(buffer, len);
+        return parse();
+    }
+
+    const size_t oldEnd(editOffset + removedLen);
+    DDLNode *current(findEnclosingNode(root, editOffset, oldEnd));
+    while (nullptr != current && current != root) {
+        const size_t begin(current->getSourceBegin());
+        const size_t end(current->getSourceEnd() - removedLen + insertedLen);
+
+        // A sentinel structure behind the range is only parsed as the second top-level node when
+        // the range ends with the closing bracket of the node and leaves no comment or string open.
+        std::string range(buffer + begin, end - begin);
+        range += ReparseSentinel;
+
+        // errors are expected when the edit breaks the structure, so no logging here
+        OpenDDLParser subParser(range.c_str(), range.size(), ddl_no_msg);
+        if (subParser.parse()) {
+            DDLNode *subRoot(subParser.getRoot());
+            const DDLNode::DllNodeList &subNodes(subRoot->getChildNodeList());
+            if (2 == subNodes.size() && subNodes[0]->getSourceEnd() == end - begin &&
+                    subNodes[1]->getSourceBegin() == end - begin + 1 && nullptr == subRoot->getValue() &&
+                    nullptr == subRoot->getDataArrayList() && nullptr == subRoot->getReferences()) {
+                DDLNode *newNode(subNodes[0]);
+                newNode->detachParent();
+                moveSourceRanges(newNode, begin);
+
+                // splice the new node into the position of the old one
+                DDLNode *parent(current->getParent());
+                DDLNode::DDLNodeIt it(std::find(parent->m_children.begin(), parent->m_children.end(), current));
+                *it = newNode;
+                newNode->m_parent = parent;
+                current->m_parent = nullptr;
+                delete current;
+
+                shiftSourceRanges(root, oldEnd, removedLen, insertedLen, newNode);
+
+                // lines, columns and excerpts have to refer to the edited text, normalizing is
+                // only one linear pass. The results of the previous run do not describe it anymore.
+                normalizeBuffer(buffer, len, m_buffer, &m_sourceMap);
+                m_diagnostics.clear();
+                m_parseStats.clear();
+                return true;
+            }
+        }
+        current = current->getParent();
+    }
+
+    setBuffer(buffer, len);
+    return parse();
+}
+
+bool OpenDDLParser::loadSnapshot(const std::string &filename) {
+    clear();
+    m_context = OpenDDLSnapshot::readFile(filename);
+    if (nullptr == m_context) {
+        if (isLogged(ddl_error_msg)) {
+            logFormat(ddl_error_msg, "Cannot load snapshot \"%s\".", filename.c_str());
+        }
+        return false;
+    }
+
     return true;
 }
 
@@ -246,51 +1128,116 @@ bool OpenDDLParser::exportContext(Context *ctx, const std::string &filename) {
 }
 
 char *OpenDDLParser::parseNextNode(char *in, char *end) {
+#ifdef OPENDDL_PHASE_TIMERS
+    StructureTimer structureTimer;
+    const size_t depth(m_stack.size());
+#endif // OPENDDL_PHASE_TIMERS
     in = parseHeader(in, end);
+#ifdef OPENDDL_PHASE_TIMERS
+    if (m_stack.size() > depth) {
+        structureTimer.setNode(top());
+    }
+#endif // OPENDDL_PHASE_TIMERS
     in = parseStructure(in, end);
 
     return in;
 }
 
 #ifdef DEBUG_HEADER_NAME
-static void dumpId(Identifier *id) {
+static void dumpId(const char *id, size_t len) {
     if (nullptr != id) {
-        if (nullptr != id->m_text.m_buffer) {
-            std::cout << id->m_text.m_buffer << std::endl;
-        }
+        std::cout.write(id, len) << std::endl;
     }
 }
 #endif
 
+// finds the range of an identifier, start is nullptr if there is none
+static char *scanIdentifier(char *in, char *end, char **start, size_t &len) {
+    *start = nullptr;
+    len = 0;
+    if (nullptr == in || in == end) {
+        return in;
+    }
+
+    // ignore blanks
+    in = lookForNextToken(in, end);
+    if (in == end) {
+        return in;
+    }
+
+    // staring with a number is forbidden
+    if (isNumeric<const char>(*in)) {
+        return in;
+    }
+
+    *start = in;
+    while ((in != end) && !isSeparator(*in) && !isNewLine(*in) &&
+            *in != Grammar::OpenPropertyToken[0] &&
+            *in != Grammar::ClosePropertyToken[0] &&
+            *in != '$') {
+        ++in;
+        ++len;
+    }
+
+    return in;
+}
+
+// finds the range of the identifier of a name, start is nullptr if there is none
+static char *scanName(char *in, char *end, NameType &type, char **start, size_t &len) {
+    *start = nullptr;
+    len = 0;
+    if (nullptr == in || in == end) {
+        return in;
+    }
+
+    // ignore blanks
+    in = lookForNextToken(in, end);
+    if (*in != '$' && *in != '%') {
+        return in;
+    }
+
+    type = ('%' == *in) ? LocalName : GlobalName;
+    in++;
+
+    return scanIdentifier(in, end, start, len);
+}
+
 char *OpenDDLParser::parseHeader(char *in, char *end) {
     if (nullptr == in || in == end) {
         return in;
     }
 
-    Text *id{nullptr};
-    in = OpenDDLParser::parseIdentifier(in, end, &id);
+    DDL_PHASE_TIMER(ddl_header_phase);
+    char *id{nullptr};
+    size_t idLen(0);
+    in = lookForNextToken(in, end);
+    const size_t sourceBegin(in - &m_buffer[0]);
+    // the type and the name are copied straight from the buffer into the node
+    in = scanIdentifier(in, end, &id, idLen);
 
 #ifdef DEBUG_HEADER_NAME
-    dumpId(id);
+    dumpId(id, idLen);
 #endif // DEBUG_HEADER_NAME
 
     in = lookForNextToken(in, end);
     if (nullptr != id) {
         // store the node
-        DDLNode *node(createDDLNode(id, this));
+        DDLNode *node(createDDLNode(id, idLen, this));
         if (nullptr != node) {
+            node->setSourceRange(sourceBegin, sourceBegin);
             pushNode(node);
+            DDL_TRACE(ddl_trace_structure_begin, node->getType().c_str(), &m_buffer[0] + sourceBegin, 0);
+            DDL_LOG(ddl_debug_msg, "Structure \"%s\" begins at offset %zu", node->getType().c_str(), m_sourceMap.toSource(sourceBegin));
         } else {
-            std::cerr << "nullptr returned by creating DDLNode." << std::endl;
+            reportDiagnostic(ddl_invalid_structure, &m_buffer[0] + sourceBegin, nullptr);
         }
-        delete id;
-
-        Name *name{nullptr};
-        in = OpenDDLParser::parseName(in, end, &name);
-        if (nullptr != name && nullptr != node && nullptr != name->m_id->m_buffer) {
-            const std::string nodeName(name->m_id->m_buffer);
-            node->setName(nodeName);
-            delete name;
+
+        NameType nameType(GlobalName);
+        char *name{nullptr};
+        size_t nameLen(0);
+        in = scanName(in, end, nameType, &name, nameLen);
+        if (nullptr != name && nullptr != node && 0 != nameLen) {
+            node->setName(name, nameLen);
         }
 
         Property *first{nullptr};
@@ -301,17 +1248,23 @@ char *OpenDDLParser::parseHeader(char *in, char *end) {
             Property *prev{nullptr};
             while (in != end && *in != Grammar::ClosePropertyToken[0]) {
                 in = OpenDDLParser::parseProperty(in, end, &prop);
-                in = lookForNextToken(in, end);
+                // lookForNextToken would skip the separator, so only skip the blanks here
+                while (in != end && (isSpace(*in) || isNewLine(*in))) {
+                    ++in;
+                }
                 if(in == end) {
+                    delete prop;
                     break;
                 }
 
                 if (*in != Grammar::CommaSeparator[0] && *in != Grammar::ClosePropertyToken[0]) {
-                    logInvalidTokenError(std::string(in, end), Grammar::ClosePropertyToken, m_logCallback);
+                    delete prop;
+                    DDL_TRACE(ddl_trace_error, Grammar::ClosePropertyToken, in, 0);
+                    reportDiagnostic(ddl_unexpected_token, in, Grammar::ClosePropertyToken);
                     return nullptr;
                 }
 
-                if (nullptr != prop && *in != Grammar::CommaSeparator[0]) {
+                if (nullptr != prop) {
                     if (nullptr == first) {
                         first = prop;
                     }
@@ -320,6 +1273,9 @@ char *OpenDDLParser::parseHeader(char *in, char *end) {
                     }
                     prev = prop;
                 }
+                if (*in == Grammar::CommaSeparator[0]) {
+                    ++in;
+                }
             }
             if(in != end) {
                 ++in;
@@ -354,8 +1310,15 @@ char *OpenDDLParser::parseStructure(char *in, char *end) {
             if (in != end) {
                 ++in;
             }
+            DDLNode *current(top());
+            if (nullptr != current) {
+                current->setSourceRange(current->getSourceBegin(), in - &m_buffer[0]);
+                DDL_TRACE(ddl_trace_structure_end, current->getType().c_str(), in, current->getChildNodeList().size());
+                DDL_LOG(ddl_debug_msg, "Structure \"%s\" ends with %zu children", current->getType().c_str(), current->getChildNodeList().size());
+            }
         } else {
-            logInvalidTokenError(std::string(in, end), std::string(Grammar::OpenBracketToken), m_logCallback);
+            DDL_TRACE(ddl_trace_error, Grammar::OpenBracketToken, in, 0);
+            reportDiagnostic(ddl_unexpected_token, in, Grammar::OpenBracketToken);
             error = true;
             return nullptr;
         }
@@ -410,23 +1373,31 @@ char *OpenDDLParser::parseStructureBody(char *in, char *end, bool &error) {
             Reference *refs(nullptr);
             DataArrayList *dtArrayList(nullptr);
             Value *values(nullptr);
+            s_invalidLiteral = nullptr;
             if (1 == arrayLen) {
                 size_t numRefs(0), numValues(0);
                 in = parseDataList(in, end, type, &values, numValues, &refs, numRefs);
+                DDL_LOG(ddl_debug_msg, "Data list of %zu values and %zu references", numValues, numRefs);
                 setNodeValues(top(), values);
                 setNodeReferences(top(), refs);
             } else if (arrayLen > 1) {
                 in = parseDataArrayList(in, end, type, &dtArrayList);
                 setNodeDataArrayList(top(), dtArrayList);
             } else {
-                std::cerr << "0 for array is invalid." << std::endl;
+                reportDiagnostic(ddl_invalid_array_size, in, nullptr);
                 error = true;
             }
+            if (nullptr != s_invalidLiteral) {
+                reportDiagnostic(ddl_invalid_literal, s_invalidLiteral, nullptr);
+                s_invalidLiteral = nullptr;
+                return nullptr;
+            }
         }
 
         in = lookForNextToken(in, end);
         if (in == end || *in != '}') {
-            logInvalidTokenError(std::string(in, end), std::string(Grammar::CloseBracketToken), m_logCallback);
+            DDL_TRACE(ddl_trace_error, Grammar::CloseBracketToken, in, 0);
+            reportDiagnostic(ddl_unexpected_token, in, Grammar::CloseBracketToken);
             return nullptr;
         } else {
             //in++;
@@ -445,6 +1416,9 @@ void OpenDDLParser::pushNode(DDLNode *node) {
     }
 
     m_stack.push_back(node);
+    if (nullptr != s_parseStats && m_stack.size() - 1 > s_parseStats->m_maxDepth) {
+        s_parseStats->m_maxDepth = m_stack.size() - 1;
+    }
 }
 
 DDLNode *OpenDDLParser::popNode() {
@@ -478,36 +1452,38 @@ Context *OpenDDLParser::getContext() const {
     return m_context;
 }
 
+Context *OpenDDLParser::detachContext() {
+    Context *ctx(m_context);
+    m_context = nullptr;
+    m_stack.clear();
+
+    return ctx;
+}
+
 void OpenDDLParser::normalizeBuffer(std::vector<char> &buffer) {
-    if (buffer.empty()) {
-        return;
-    }
+    normalizeBuffer(buffer, nullptr);
+}
 
+void OpenDDLParser::normalizeBuffer(std::vector<char> &buffer, SourceMap *sourceMap) {
     std::vector<char> newBuffer;
-    const size_t len(buffer.size());
-    char *end(&buffer[len - 1] + 1);
-    for (size_t readIdx = 0; readIdx < len; ++readIdx) {
-        char *c(&buffer[readIdx]);
-        // check for a comment
-        if (isCommentOpenTag(c, end)) {
-            ++readIdx;
-            while (readIdx < len && !isCommentCloseTag(&buffer[readIdx], end)) {
-                ++readIdx;
-            }
-            ++readIdx;
-        } else if (!isComment<char>(c, end) && !isNewLine(*c)) {
-            newBuffer.push_back(buffer[readIdx]);
-        } else {
-            if (isComment<char>(c, end)) {
-                ++readIdx;
-                // skip the comment and the rest of the line
-                while (readIdx < len && !isEndofLine(buffer[readIdx])) {
-                    ++readIdx;
-                }
-            }
-        }
+    normalizeBuffer(buffer.empty() ? nullptr : &buffer[0], buffer.size(), newBuffer, sourceMap);
+    buffer.swap(newBuffer);
+}
+
+void OpenDDLParser::normalizeBuffer(const char *buffer, size_t len, std::vector<char> &normalized, SourceMap *sourceMap) {
+    DDL_PHASE_TIMER(ddl_normalize_phase);
+    normalized.clear();
+    if (nullptr != sourceMap) {
+        sourceMap->clear();
     }
-    buffer = newBuffer;
+    if (nullptr == buffer || 0 == len) {
+        return;
+    }
+
+    // the result can only shrink, so one allocation is enough
+    normalized.reserve(len);
+    BufferNormalizer normalizer(normalized, sourceMap);
+    normalizer.feed(buffer, len, true);
 }
 
 char *OpenDDLParser::parseName(char *in, char *end, Name **name) {
@@ -516,25 +1492,15 @@ char *OpenDDLParser::parseName(char *in, char *end, Name **name) {
         return in;
     }
 
-    // ignore blanks
-    in = lookForNextToken(in, end);
-    if (*in != '$' && *in != '%') {
-        return in;
-    }
-
     NameType ntype(GlobalName);
-    if (*in == '%') {
-        ntype = LocalName;
-    }
-    in++;
-    Name *currentName(nullptr);
-    Text *id(nullptr);
-    in = parseIdentifier(in, end, &id);
-    if (id) {
-        currentName = new Name(ntype, id);
-        if (currentName) {
-            *name = currentName;
-        }
+    char *start(nullptr);
+    size_t len(0);
+    in = scanName(in, end, ntype, &start, len);
+    if (nullptr != start) {
+        // Name keeps its id on the heap, so the identifier is copied once into the new Text
+        *name = new Name(ntype, new Text(start, len));
+        countObject(ddl_name_object, sizeof(Name));
+        countObject(ddl_text_object, sizeof(Text) + (*name)->m_id->m_capacity);
     }
 
     return in;
@@ -546,35 +1512,19 @@ char *OpenDDLParser::parseIdentifier(char *in, char *end, Text **id) {
         return in;
     }
 
-    // ignore blanks
-    in = lookForNextToken(in, end);
-    if (in == end) {
-        return in;
-    }
-
-    // staring with a number is forbidden
-    if (isNumeric<const char>(*in)) {
-        return in;
-    }
-
-    // get size of id
-    size_t idLen(0);
-    char *start(in);
-    while ((in != end) && !isSeparator(*in) && !isNewLine(*in) &&
-            *in != Grammar::OpenPropertyToken[0] &&
-            *in != Grammar::ClosePropertyToken[0] &&
-            *in != '$') {
-        ++in;
-        ++idLen;
+    char *start(nullptr);
+    size_t len(0);
+    in = scanIdentifier(in, end, &start, len);
+    if (nullptr != start) {
+        *id = new Text(start, len);
+        countObject(ddl_text_object, sizeof(Text) + (*id)->m_capacity);
     }
 
-    const size_t len(idLen);
-    *id = new Text(start, len);
-
     return in;
 }
 
 char *OpenDDLParser::parsePrimitiveDataType(char *in, char *end, Value::ValueType &type, size_t &len) {
+    DDL_PHASE_TIMER(ddl_primitive_type_phase);
     type = Value::ValueType::ddl_none;
     len = 0;
     if (nullptr == in || in == end) {
@@ -674,10 +1624,10 @@ char *OpenDDLParser::parseBooleanLiteral(char *in, char *end, Value **boolean) {
             *boolean = nullptr;
             return in;
         }
-        *boolean = ValueAllocator::allocPrimData(Value::ValueType::ddl_bool);
+        *boolean = allocValue(Value::ValueType::ddl_bool);
         (*boolean)->setBool(false);
     } else {
-        *boolean = ValueAllocator::allocPrimData(Value::ValueType::ddl_bool);
+        *boolean = allocValue(Value::ValueType::ddl_bool);
         (*boolean)->setBool(true);
     }
 
@@ -685,6 +1635,7 @@ char *OpenDDLParser::parseBooleanLiteral(char *in, char *end, Value **boolean) {
 }
 
 char *OpenDDLParser::parseIntegerLiteral(char *in, char *end, Value **integer, Value::ValueType integerType) {
+    DDL_PHASE_TIMER(ddl_numeric_conversion_phase);
     *integer = nullptr;
     if (nullptr == in || in == end) {
         return in;
@@ -700,7 +1651,8 @@ char *OpenDDLParser::parseIntegerLiteral(char *in, char *end, Value **integer, V
         ++in;
     }
 
-    if (isNumeric(*start)) {
+    const bool isNegative(*start == '-' && isIntegerType(integerType) && start + 1 != end && isNumeric(*(start + 1)));
+    if (isNumeric(*start) || isNegative) {
 #ifdef OPENDDL_NO_USE_CPP11
         const int64 value(atol(start)); // maybe not really 64bit as atoll is but exists without c++11
         const uint64 uvalue(strtoul(start, nullptr, 10));
@@ -708,7 +1660,7 @@ char *OpenDDLParser::parseIntegerLiteral(char *in, char *end, Value **integer, V
         const int64 value(atoll(start));
         const uint64 uvalue(strtoull(start, nullptr, 10));
 #endif
-        *integer = ValueAllocator::allocPrimData(integerType);
+        *integer = allocValue(integerType);
         switch (integerType) {
             case Value::ValueType::ddl_int8:
                 (*integer)->setInt8((int8)value);
@@ -742,7 +1694,28 @@ char *OpenDDLParser::parseIntegerLiteral(char *in, char *end, Value **integer, V
     return in;
 }
 
+// reads a hex literal like 0x7F800000 as the raw bits of a value with at most maxDigits digits
+static bool parseHexBits(const char *in, const char *end, size_t maxDigits, uint64 &bits) {
+    bits = 0;
+    const char *digit(in + 2);
+    if (digit == end) {
+        return false;
+    }
+
+    for (size_t numDigits = 1; digit != end; ++digit, ++numDigits) {
+        const char c(*digit);
+        const bool isHexDigit((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'));
+        if (!isHexDigit || numDigits > maxDigits) {
+            return false;
+        }
+        bits = (bits << 4) | static_cast<uint64>(hex2Decimal(c));
+    }
+
+    return true;
+}
+
 char *OpenDDLParser::parseFloatingLiteral(char *in, char *end, Value **floating, Value::ValueType floatType) {
+    DDL_PHASE_TIMER(ddl_numeric_conversion_phase);
     *floating = nullptr;
     if (nullptr == in || in == end) {
         return in;
@@ -757,7 +1730,37 @@ char *OpenDDLParser::parseFloatingLiteral(char *in, char *end, Value **floating,
     // parse the float value
     bool ok(false);
     if (isHexLiteral(start, end)) {
-        parseHexaLiteral(start, end, floating);
+        if (Value::ValueType::ddl_half == floatType) {
+            // a hex literal holds the bits of the half
+            uint64 bits(0);
+            if (parseHexBits(start, in, 4, bits)) {
+                const uint16 halfBits(static_cast<uint16>(bits));
+                *floating = allocValue(Value::ValueType::ddl_half);
+                ::memcpy((*floating)->m_data, &halfBits, sizeof(uint16));
+            } else if (nullptr == s_invalidLiteral) {
+                s_invalidLiteral = start;
+            }
+        } else {
+            // a hex literal holds the bits of the float or the double, infinity and NaN are written this way
+            const bool isDouble(Value::ValueType::ddl_double == floatType);
+            uint64 bits(0);
+            if (parseHexBits(start, in, isDouble ? 16 : 8, bits)) {
+                if (isDouble) {
+                    double value;
+                    ::memcpy(&value, &bits, sizeof(double));
+                    *floating = allocValue(Value::ValueType::ddl_double);
+                    (*floating)->setDouble(value);
+                } else {
+                    const uint32 floatBits(static_cast<uint32>(bits));
+                    float value;
+                    ::memcpy(&value, &floatBits, sizeof(float));
+                    *floating = allocValue(Value::ValueType::ddl_float);
+                    (*floating)->setFloat(value);
+                }
+            } else if (nullptr == s_invalidLiteral) {
+                s_invalidLiteral = start;
+            }
+        }
         return in;
     }
 
@@ -774,11 +1777,17 @@ char *OpenDDLParser::parseFloatingLiteral(char *in, char *end, Value **floating,
     if (ok) {
         if (floatType == Value::ValueType::ddl_double) {
             const double value(atof(start));
-            *floating = ValueAllocator::allocPrimData(Value::ValueType::ddl_double);
+            *floating = allocValue(Value::ValueType::ddl_double);
             (*floating)->setDouble(value);
+        } else if (floatType == Value::ValueType::ddl_half) {
+            // a half from a float can not round twice, a float has more than twice the precision
+            const float value(strtof(start, nullptr));
+            *floating = allocValue(Value::ValueType::ddl_half);
+            (*floating)->setHalf(value);
         } else {
-            const float value((float)atof(start));
-            *floating = ValueAllocator::allocPrimData(Value::ValueType::ddl_float);
+            // parse directly as float, a detour over double can round twice
+            const float value(strtof(start, nullptr));
+            *floating = allocValue(Value::ValueType::ddl_float);
             (*floating)->setFloat(value);
         }
     }
@@ -798,28 +1807,40 @@ char *OpenDDLParser::parseStringLiteral(char *in, char *end, Value **stringData)
     if (*start == '\"') {
         ++start;
         ++in;
-        while (*in != '\"' && in != end) {
+        while (in != end && *in != '\"') {
             ++in;
             ++len;
         }
 
-        *stringData = ValueAllocator::allocPrimData(Value::ValueType::ddl_string, len);
+        *stringData = allocValue(Value::ValueType::ddl_string, len);
         ::strncpy((char *)(*stringData)->m_data, start, len);
         (*stringData)->m_data[len] = '\0';
-        ++in;
+        if (in != end) {
+            ++in;
+        }
     }
 
     return in;
 }
 
-static void createPropertyWithData(Text *id, Value *primData, Property **prop) {
+// the key is copied straight from the buffer, only for a complete property
+static Property *createProperty(const char *key, size_t len) {
+    Property *prop(new Property(Text(key, len)));
+    countObject(ddl_property_object, sizeof(Property));
+    countObject(ddl_text_object, sizeof(Text) + prop->m_key->m_capacity);
+
+    return prop;
+}
+
+static void createPropertyWithData(const char *key, size_t len, Value *primData, Property **prop) {
     if (nullptr != primData) {
-        (*prop) = new Property(id);
+        (*prop) = createProperty(key, len);
         (*prop)->m_value = primData;
     }
 }
 
 char *OpenDDLParser::parseHexaLiteral(char *in, char *end, Value **data) {
+    DDL_PHASE_TIMER(ddl_numeric_conversion_phase);
     *data = nullptr;
     if (nullptr == in || in == end) {
         return in;
@@ -867,7 +1888,7 @@ char *OpenDDLParser::parseHexaLiteral(char *in, char *end, Value **data) {
         ++start;
     }
 
-    *data = ValueAllocator::allocPrimData(Value::ValueType::ddl_unsigned_int64);
+    *data = allocValue(Value::ValueType::ddl_unsigned_int64);
     if (nullptr != *data) {
         (*data)->setUnsignedInt64(value);
     }
@@ -882,9 +1903,10 @@ char *OpenDDLParser::parseProperty(char *in, char *end, Property **prop) {
     }
 
     in = lookForNextToken(in, end);
-    Text *id = nullptr;
-    in = parseIdentifier(in, end, &id);
-    if (nullptr != id) {
+    char *key(nullptr);
+    size_t keyLen(0);
+    in = scanIdentifier(in, end, &key, keyLen);
+    if (nullptr != key) {
         in = lookForNextToken(in, end);
         if (in != end && *in == '=') {
             ++in;
@@ -892,24 +1914,22 @@ char *OpenDDLParser::parseProperty(char *in, char *end, Property **prop) {
             Value *primData(nullptr);
             if (isInteger(in, end)) {
                 in = parseIntegerLiteral(in, end, &primData);
-                createPropertyWithData(id, primData, prop);
+                createPropertyWithData(key, keyLen, primData, prop);
             } else if (isFloat(in, end)) {
                 in = parseFloatingLiteral(in, end, &primData);
-                createPropertyWithData(id, primData, prop);
+                createPropertyWithData(key, keyLen, primData, prop);
             } else if (isStringLiteral(*in)) { // string data
                 in = parseStringLiteral(in, end, &primData);
-                createPropertyWithData(id, primData, prop);
+                createPropertyWithData(key, keyLen, primData, prop);
             } else { // reference data
                 std::vector<Name *> names;
                 in = parseReference(in, end, names);
                 if (!names.empty()) {
-                    Reference *ref = new Reference(names.size(), &names[0]);
-                    (*prop) = new Property(id);
+                    Reference *ref = createReference(names);
+                    (*prop) = createProperty(key, keyLen);
                     (*prop)->m_ref = ref;
                 }
             }
-        } else {
-            delete id;
         }
     }
 
@@ -926,6 +1946,9 @@ char *OpenDDLParser::parseDataList(char *in, char *end, Value::ValueType type, V
 
     in = lookForNextToken(in, end);
     if (in != end && *in == '{') {
+#ifdef OPENDDL_TRACING
+        const char *listBegin(in);
+#endif // OPENDDL_TRACING
         ++in;
         Value *current(nullptr), *prev(nullptr);
         while (in != end && '}' != *in) {
@@ -935,7 +1958,7 @@ char *OpenDDLParser::parseDataList(char *in, char *end, Value::ValueType type, V
                 std::vector<Name *> names;
                 in = parseReference(in, end, names);
                 if (!names.empty()) {
-                    Reference *ref = new Reference(names.size(), &names[0]);
+                    Reference *ref = createReference(names);
                     *refs = ref;
                     numRefs = names.size();
                 }
@@ -992,6 +2015,7 @@ char *OpenDDLParser::parseDataList(char *in, char *end, Value::ValueType type, V
         }
         if (in != end)
             ++in;
+        DDL_TRACE(ddl_trace_data_list, getTraceTypeName(type), listBegin, numValues + numRefs);
     }
 
     return in;
@@ -1000,6 +2024,7 @@ char *OpenDDLParser::parseDataList(char *in, char *end, Value::ValueType type, V
 static DataArrayList *createDataArrayList(Value *currentValue, size_t numValues,
         Reference *refs, size_t numRefs) {
     DataArrayList *dataList(new DataArrayList);
+    countObject(ddl_data_array_list_object, sizeof(DataArrayList));
     dataList->m_dataList = currentValue;
     dataList->m_numItems = numValues;
     dataList->m_refs = refs;
@@ -0,0 +1,803 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/MemoryMappedFile.h>
+#include <openddlparser/OpenDDLSnapshot.h>
+#include <openddlparser/Value.h>
+
+#include <unordered_map>
+
+BEGIN_ODDLPARSER_NS
+
+static const char SnapshotMagic[8] = { 'O', 'D', 'D', 'L', 'S', 'N', 'A', 'P' };
+static const uint32 SnapshotVersion = 2;
+static const uint32 SnapshotByteOrder = 0x01020304;
+static const uint32 InvalidIndex = 0xffffffff;
+static const uint64 InvalidOffset = ~static_cast<uint64>(0);
+
+static const uint32 PropertyHasValue = 1;
+static const uint32 PropertyHasReference = 2;
+
+struct SnapshotHeader {
+    char m_magic[8];
+    uint32 m_version;
+    uint32 m_byteOrder;
+    uint64 m_payloadSize;
+    uint64 m_checksum;
+    uint32 m_numSymbols;
+    uint32 m_numNodes;
+    uint64 m_symbolTableOffset;
+    uint64 m_nodeTableOffset;
+    uint64 m_dataOffset;
+    uint64 m_sourceOffset;
+    uint64 m_sourceSize;
+};
+
+struct SnapshotNode {
+    uint32 m_type;
+    uint32 m_name;
+    uint32 m_parent;
+    uint32 m_numChildren;
+    uint64 m_properties;
+    uint64 m_values;
+    uint64 m_dataArrayList;
+    uint64 m_references;
+};
+
+static_assert(sizeof(SnapshotHeader) == 80, "Unexpected padding in snapshot header.");
+static_assert(sizeof(SnapshotNode) == 48, "Unexpected padding in snapshot node record.");
+
+//-------------------------------------------------------------------------------------------------
+//  Writer
+//-------------------------------------------------------------------------------------------------
+class SnapshotWriter {
+public:
+    SnapshotWriter() :
+            m_symbolLookup(),
+            m_symbols(),
+            m_nodes(),
+            m_data() {
+        // empty
+    }
+
+    uint32 addSymbol(const char *str, size_t len) {
+        const std::string key(str, len);
+        std::unordered_map<std::string, uint32>::const_iterator it(m_symbolLookup.find(key));
+        if (m_symbolLookup.end() != it) {
+            return it->second;
+        }
+
+        const uint32 idx(static_cast<uint32>(m_symbols.size()));
+        m_symbols.push_back(key);
+        m_symbolLookup[key] = idx;
+
+        return idx;
+    }
+
+    uint32 addSymbol(const std::string &str) {
+        return addSymbol(str.c_str(), str.size());
+    }
+
+    void append(const void *data, size_t len) {
+        const char *in(static_cast<const char *>(data));
+        m_data.insert(m_data.end(), in, in + len);
+    }
+
+    void appendU32(uint32 value) {
+        append(&value, sizeof(uint32));
+    }
+
+    void appendU64(uint64 value) {
+        append(&value, sizeof(uint64));
+    }
+
+    void writeNodes(DDLNode *node, uint32 parent) {
+        SnapshotNode record;
+        record.m_type = addSymbol(node->getType());
+        record.m_name = addSymbol(node->getName());
+        record.m_parent = parent;
+        record.m_numChildren = static_cast<uint32>(node->getChildNodeList().size());
+        record.m_properties = writeProperties(node->getProperties());
+        record.m_values = writeValueList(node->getValue());
+        record.m_dataArrayList = writeDataArrayList(node->getDataArrayList());
+        record.m_references = writeReference(node->getReferences());
+
+        const uint32 idx(static_cast<uint32>(m_nodes.size()));
+        m_nodes.push_back(record);
+
+        const DDLNode::DllNodeList &children(node->getChildNodeList());
+        for (size_t i = 0; i < children.size(); ++i) {
+            writeNodes(children[i], idx);
+        }
+    }
+
+    uint64 writeReference(const Reference *ref) {
+        if (nullptr == ref) {
+            return InvalidOffset;
+        }
+
+        const uint64 offset(m_data.size());
+        appendReference(ref);
+
+        return offset;
+    }
+
+    void appendReference(const Reference *ref) {
+        appendU32(static_cast<uint32>(ref->m_numRefs));
+        for (size_t i = 0; i < ref->m_numRefs; ++i) {
+            const Name *name(ref->m_referencedName[i]);
+            appendU32(static_cast<uint32>(name->m_type));
+            appendU32(addSymbol(name->m_id->m_buffer, name->m_id->m_len));
+        }
+    }
+
+    uint64 writeValueList(Value *value) {
+        if (nullptr == value) {
+            return InvalidOffset;
+        }
+
+        const uint64 offset(m_data.size());
+        appendValueList(value);
+
+        return offset;
+    }
+
+    void appendValueList(Value *value) {
+        // count the runs of values with the same type first
+        uint32 numRuns(0);
+        for (Value *current = value; nullptr != current;) {
+            Value *next(current->getNext());
+            while (nullptr != next && next->m_type == current->m_type) {
+                next = next->getNext();
+            }
+            ++numRuns;
+            current = next;
+        }
+        appendU32(numRuns);
+
+        Value *current(value);
+        while (nullptr != current) {
+            const Value::ValueType type(current->m_type);
+            uint32 count(0);
+            for (Value *v = current; nullptr != v && v->m_type == type; v = v->getNext()) {
+                ++count;
+            }
+            appendU32(static_cast<uint32>(type));
+            appendU32(count);
+            for (uint32 i = 0; i < count; ++i) {
+                switch (type) {
+                    case Value::ValueType::ddl_string:
+                        appendU32(addSymbol(current->getString(), strlen(current->getString())));
+                        break;
+                    case Value::ValueType::ddl_ref: {
+                        const Reference *ref(current->getRef());
+                        if (nullptr == ref) {
+                            appendU32(0);
+                        } else {
+                            appendReference(ref);
+                        }
+                    } break;
+                    default:
+                        append(current->m_data, current->m_size);
+                        break;
+                }
+                current = current->getNext();
+            }
+        }
+    }
+
+    uint64 writeProperties(const Property *prop) {
+        if (nullptr == prop) {
+            return InvalidOffset;
+        }
+
+        uint32 numProps(0);
+        for (const Property *p = prop; nullptr != p; p = p->m_next) {
+            ++numProps;
+        }
+
+        const uint64 offset(m_data.size());
+        appendU32(numProps);
+        for (const Property *p = prop; nullptr != p; p = p->m_next) {
+            appendU32(addSymbol(p->m_key->m_buffer, p->m_key->m_len));
+            uint32 flags(0);
+            if (nullptr != p->m_value) {
+                flags |= PropertyHasValue;
+            }
+            if (nullptr != p->m_ref) {
+                flags |= PropertyHasReference;
+            }
+            appendU32(flags);
+            if (nullptr != p->m_value) {
+                appendValueList(p->m_value);
+            }
+            if (nullptr != p->m_ref) {
+                appendReference(p->m_ref);
+            }
+        }
+
+        return offset;
+    }
+
+    uint64 writeDataArrayList(const DataArrayList *dtArrayList) {
+        if (nullptr == dtArrayList) {
+            return InvalidOffset;
+        }
+
+        uint32 numLists(0);
+        for (const DataArrayList *al = dtArrayList; nullptr != al; al = al->m_next) {
+            ++numLists;
+        }
+
+        const uint64 offset(m_data.size());
+        appendU32(numLists);
+        for (const DataArrayList *al = dtArrayList; nullptr != al; al = al->m_next) {
+            appendU64(al->m_numItems);
+            appendU64(al->m_numRefs);
+            appendU32(nullptr != al->m_dataList ? 1 : 0);
+            appendU32(nullptr != al->m_refs ? 1 : 0);
+            if (nullptr != al->m_dataList) {
+                appendValueList(al->m_dataList);
+            }
+            if (nullptr != al->m_refs) {
+                appendReference(al->m_refs);
+            }
+        }
+
+        return offset;
+    }
+
+    void finish(std::vector<char> &buffer, const char *source, size_t sourceLen) {
+        std::vector<uint64> symbolOffsets;
+        symbolOffsets.reserve(m_symbols.size() + 1);
+        uint64 blobSize(0);
+        for (size_t i = 0; i < m_symbols.size(); ++i) {
+            symbolOffsets.push_back(blobSize);
+            blobSize += m_symbols[i].size() + 1;
+        }
+        symbolOffsets.push_back(blobSize);
+
+        const uint64 symbolTableSize(symbolOffsets.size() * sizeof(uint64) + blobSize);
+        const uint64 nodeTableSize(m_nodes.size() * sizeof(SnapshotNode));
+
+        SnapshotHeader header;
+        ::memcpy(header.m_magic, SnapshotMagic, sizeof(SnapshotMagic));
+        header.m_version = SnapshotVersion;
+        header.m_byteOrder = SnapshotByteOrder;
+        header.m_payloadSize = symbolTableSize + nodeTableSize + m_data.size() + sourceLen;
+        header.m_checksum = 0;
+        header.m_numSymbols = static_cast<uint32>(m_symbols.size());
+        header.m_numNodes = static_cast<uint32>(m_nodes.size());
+        header.m_symbolTableOffset = 0;
+        header.m_nodeTableOffset = symbolTableSize;
+        header.m_dataOffset = symbolTableSize + nodeTableSize;
+        header.m_sourceOffset = header.m_dataOffset + m_data.size();
+        header.m_sourceSize = sourceLen;
+
+        buffer.resize(sizeof(SnapshotHeader) + static_cast<size_t>(header.m_payloadSize));
+        char *out(&buffer[0] + sizeof(SnapshotHeader));
+        ::memcpy(out, &symbolOffsets[0], symbolOffsets.size() * sizeof(uint64));
+        out += symbolOffsets.size() * sizeof(uint64);
+        for (size_t i = 0; i < m_symbols.size(); ++i) {
+            ::memcpy(out, m_symbols[i].c_str(), m_symbols[i].size() + 1);
+            out += m_symbols[i].size() + 1;
+        }
+        if (!m_nodes.empty()) {
+            ::memcpy(out, &m_nodes[0], static_cast<size_t>(nodeTableSize));
+            out += nodeTableSize;
+        }
+        if (!m_data.empty()) {
+            ::memcpy(out, &m_data[0], m_data.size());
+            out += m_data.size();
+        }
+        if (0 != sourceLen) {
+            ::memcpy(out, source, sourceLen);
+        }
+
+        header.m_checksum = computeHash(&buffer[0] + sizeof(SnapshotHeader), static_cast<size_t>(header.m_payloadSize));
+        ::memcpy(&buffer[0], &header, sizeof(SnapshotHeader));
+    }
+
+private:
+    std::unordered_map<std::string, uint32> m_symbolLookup;
+    std::vector<std::string> m_symbols;
+    std::vector<SnapshotNode> m_nodes;
+    std::vector<char> m_data;
+};
+
+//-------------------------------------------------------------------------------------------------
+//  Reader
+//-------------------------------------------------------------------------------------------------
+class SnapshotReader {
+public:
+    SnapshotReader(const char *buffer, size_t len) :
+            m_buffer(buffer),
+            m_len(len),
+            m_header(),
+            m_symbolOffsets(nullptr),
+            m_symbolBlob(nullptr),
+            m_blobSize(0),
+            m_nodeTable(nullptr),
+            m_data(nullptr),
+            m_dataSize(0),
+            m_source(nullptr) {
+        // empty
+    }
+
+    bool validate() {
+        if (!OpenDDLSnapshot::isSnapshot(m_buffer, m_len)) {
+            return false;
+        }
+
+        ::memcpy(&m_header, m_buffer, sizeof(SnapshotHeader));
+        if (SnapshotVersion != m_header.m_version || SnapshotByteOrder != m_header.m_byteOrder) {
+            return false;
+        }
+
+        const uint64 payloadSize(m_len - sizeof(SnapshotHeader));
+        if (m_header.m_payloadSize != payloadSize) {
+            return false;
+        }
+
+        const char *payload(m_buffer + sizeof(SnapshotHeader));
+        if (m_header.m_checksum != computeHash(payload, static_cast<size_t>(payloadSize))) {
+            return false;
+        }
+
+        const uint64 offsetTableSize((static_cast<uint64>(m_header.m_numSymbols) + 1) * sizeof(uint64));
+        const uint64 nodeTableSize(static_cast<uint64>(m_header.m_numNodes) * sizeof(SnapshotNode));
+        if (0 != m_header.m_symbolTableOffset || m_header.m_nodeTableOffset < offsetTableSize ||
+                m_header.m_nodeTableOffset > payloadSize ||
+                m_header.m_dataOffset < m_header.m_nodeTableOffset ||
+                m_header.m_dataOffset - m_header.m_nodeTableOffset != nodeTableSize ||
+                m_header.m_dataOffset > payloadSize ||
+                m_header.m_sourceOffset < m_header.m_dataOffset ||
+                m_header.m_sourceOffset > payloadSize ||
+                m_header.m_sourceSize != payloadSize - m_header.m_sourceOffset) {
+            return false;
+        }
+
+        m_symbolOffsets = payload;
+        m_symbolBlob = payload + offsetTableSize;
+        m_blobSize = m_header.m_nodeTableOffset - offsetTableSize;
+        m_nodeTable = payload + m_header.m_nodeTableOffset;
+        m_data = payload + m_header.m_dataOffset;
+        m_dataSize = m_header.m_sourceOffset - m_header.m_dataOffset;
+        m_source = payload + m_header.m_sourceOffset;
+
+        return true;
+    }
+
+    bool hasSource(const char *source, size_t len) const {
+        return m_header.m_sourceSize == len && (0 == len || 0 == ::memcmp(m_source, source, len));
+    }
+
+    Context *createContext() {
+        if (0 == m_header.m_numNodes) {
+            return nullptr;
+        }
+
+        Context *ctx(new Context);
+        std::vector<DDLNode *> nodes;
+        nodes.reserve(m_header.m_numNodes);
+        for (uint32 i = 0; i < m_header.m_numNodes; ++i) {
+            SnapshotNode record;
+            ::memcpy(&record, m_nodeTable + i * sizeof(SnapshotNode), sizeof(SnapshotNode));
+
+            const char *type(nullptr), *name(nullptr);
+            size_t typeLen(0), nameLen(0);
+            if (!getSymbol(record.m_type, &type, typeLen) || !getSymbol(record.m_name, &name, nameLen)) {
+                delete ctx;
+                return nullptr;
+            }
+
+            // nodes are stored in pre-order, so the parent must be known already
+            DDLNode *parent(nullptr);
+            if (0 == i) {
+                if (InvalidIndex != record.m_parent) {
+                    delete ctx;
+                    return nullptr;
+                }
+            } else {
+                if (record.m_parent >= i) {
+                    delete ctx;
+                    return nullptr;
+                }
+                parent = nodes[record.m_parent];
+            }
+
+            DDLNode *node(DDLNode::create(std::string(type, typeLen), std::string(name, nameLen), parent));
+            nodes.push_back(node);
+            if (0 == i) {
+                ctx->m_root = node;
+            }
+
+            if (!readNodeContent(record, node)) {
+                delete ctx;
+                return nullptr;
+            }
+        }
+
+        return ctx;
+    }
+
+private:
+    bool getSymbol(uint32 idx, const char **str, size_t &len) const {
+        if (idx >= m_header.m_numSymbols) {
+            return false;
+        }
+
+        uint64 start(0), end(0);
+        ::memcpy(&start, m_symbolOffsets + idx * sizeof(uint64), sizeof(uint64));
+        ::memcpy(&end, m_symbolOffsets + (idx + 1) * sizeof(uint64), sizeof(uint64));
+        if (start >= end || end > m_blobSize || '\0' != m_symbolBlob[end - 1]) {
+            return false;
+        }
+
+        *str = m_symbolBlob + start;
+        len = static_cast<size_t>(end - start - 1);
+
+        return true;
+    }
+
+    bool readBytes(uint64 &pos, void *out, size_t len) const {
+        if (pos > m_dataSize || m_dataSize - pos < len) {
+            return false;
+        }
+        ::memcpy(out, m_data + pos, len);
+        pos += len;
+
+        return true;
+    }
+
+    bool readU32(uint64 &pos, uint32 &value) const {
+        return readBytes(pos, &value, sizeof(uint32));
+    }
+
+    bool readU64(uint64 &pos, uint64 &value) const {
+        return readBytes(pos, &value, sizeof(uint64));
+    }
+
+    bool readNodeContent(const SnapshotNode &record, DDLNode *node) {
+        if (InvalidOffset != record.m_properties) {
+            uint64 pos(record.m_properties);
+            Property *props(nullptr);
+            if (!readProperties(pos, &props)) {
+                return false;
+            }
+            node->setProperties(props);
+        }
+
+        if (InvalidOffset != record.m_values) {
+            uint64 pos(record.m_values);
+            Value *values(nullptr);
+            if (!readValueList(pos, &values)) {
+                return false;
+            }
+            node->setValue(values);
+        }
+
+        if (InvalidOffset != record.m_dataArrayList) {
+            uint64 pos(record.m_dataArrayList);
+            DataArrayList *dtArrayList(nullptr);
+            if (!readDataArrayList(pos, &dtArrayList)) {
+                return false;
+            }
+            node->setDataArrayList(dtArrayList);
+        }
+
+        if (InvalidOffset != record.m_references) {
+            uint64 pos(record.m_references);
+            Reference *refs(nullptr);
+            if (!readReference(pos, &refs)) {
+                return false;
+            }
+            node->setReferences(refs);
+        }
+
+        return true;
+    }
+
+    bool readReference(uint64 &pos, Reference **ref) const {
+        *ref = nullptr;
+        uint32 numNames(0);
+        if (!readU32(pos, numNames)) {
+            return false;
+        }
+        if (static_cast<uint64>(numNames) * 2 * sizeof(uint32) > m_dataSize - pos) {
+            return false;
+        }
+
+        std::vector<Name *> names;
+        names.reserve(numNames);
+        bool ok(true);
+        for (uint32 i = 0; i < numNames; ++i) {
+            uint32 type(0), symbol(0);
+            const char *id(nullptr);
+            size_t len(0);
+            if (!readU32(pos, type) || !readU32(pos, symbol) || type > LocalName || !getSymbol(symbol, &id, len)) {
+                ok = false;
+                break;
+            }
+            names.push_back(new Name(static_cast<NameType>(type), new Text(id, len)));
+        }
+
+        if (!ok) {
+            for (size_t i = 0; i < names.size(); ++i) {
+                delete names[i];
+            }
+            return false;
+        }
+
+        if (names.empty()) {
+            *ref = new Reference();
+        } else {
+            *ref = new Reference(names.size(), &names[0]);
+        }
+
+        return true;
+    }
+
+    bool readValueList(uint64 &pos, Value **values) const {
+        *values = nullptr;
+        uint32 numRuns(0);
+        if (!readU32(pos, numRuns)) {
+            return false;
+        }
+
+        Value *first(nullptr), *prev(nullptr);
+        for (uint32 run = 0; run < numRuns; ++run) {
+            uint32 typeIdx(0), count(0);
+            if (!readU32(pos, typeIdx) || !readU32(pos, count) ||
+                    typeIdx >= static_cast<uint32>(Value::ValueType::ddl_types_max)) {
+                delete first;
+                return false;
+            }
+
+            const Value::ValueType type(static_cast<Value::ValueType>(typeIdx));
+            for (uint32 i = 0; i < count; ++i) {
+                Value *current(readValue(pos, type));
+                if (nullptr == current) {
+                    delete first;
+                    return false;
+                }
+                if (nullptr == first) {
+                    first = current;
+                } else {
+                    prev->setNext(current);
+                }
+                prev = current;
+            }
+        }
+        *values = first;
+
+        return true;
+    }
+
+    Value *readValue(uint64 &pos, Value::ValueType type) const {
+        switch (type) {
+            case Value::ValueType::ddl_string: {
+                uint32 symbol(0);
+                const char *str(nullptr);
+                size_t len(0);
+                if (!readU32(pos, symbol) || !getSymbol(symbol, &str, len)) {
+                    return nullptr;
+                }
+                Value *value(ValueAllocator::allocPrimData(type, len));
+                ::memcpy(value->m_data, str, len + 1);
+                return value;
+            }
+            case Value::ValueType::ddl_ref: {
+                Reference *ref(nullptr);
+                if (!readReference(pos, &ref)) {
+                    return nullptr;
+                }
+                Value *value(ValueAllocator::allocPrimData(type));
+                value->setRef(ref);
+                delete ref;
+                return value;
+            }
+            default: {
+                Value *value(ValueAllocator::allocPrimData(type));
+                if (nullptr == value) {
+                    return nullptr;
+                }
+                if (!readBytes(pos, value->m_data, value->m_size)) {
+                    delete value;
+                    return nullptr;
+                }
+                return value;
+            }
+        }
+    }
+
+    bool readProperties(uint64 &pos, Property **props) const {
+        *props = nullptr;
+        uint32 numProps(0);
+        if (!readU32(pos, numProps)) {
+            return false;
+        }
+
+        Property *first(nullptr), *prev(nullptr);
+        for (uint32 i = 0; i < numProps; ++i) {
+            uint32 symbol(0), flags(0);
+            const char *key(nullptr);
+            size_t len(0);
+            if (!readU32(pos, symbol) || !readU32(pos, flags) || !getSymbol(symbol, &key, len)) {
+                delete first;
+                return false;
+            }
+
+            Property *prop(new Property(new Text(key, len)));
+            if (nullptr == first) {
+                first = prop;
+            } else {
+                prev->m_next = prop;
+            }
+            prev = prop;
+
+            if (0 != (flags & PropertyHasValue) && !readValueList(pos, &prop->m_value)) {
+                delete first;
+                return false;
+            }
+            if (0 != (flags & PropertyHasReference) && !readReference(pos, &prop->m_ref)) {
+                delete first;
+                return false;
+            }
+        }
+        *props = first;
+
+        return true;
+    }
+
+    static uint64 countValues(const Value *values) {
+        uint64 numValues(0);
+        for (const Value *current = values; nullptr != current; current = current->m_next) {
+            ++numValues;
+        }
+
+        return numValues;
+    }
+
+    bool readDataArrayList(uint64 &pos, DataArrayList **dtArrayList) const {
+        *dtArrayList = nullptr;
+        uint32 numLists(0);
+        if (!readU32(pos, numLists)) {
+            return false;
+        }
+
+        DataArrayList *first(nullptr), *prev(nullptr);
+        for (uint32 i = 0; i < numLists; ++i) {
+            uint64 numItems(0), numRefs(0);
+            uint32 hasValues(0), hasRefs(0);
+            if (!readU64(pos, numItems) || !readU64(pos, numRefs) || !readU32(pos, hasValues) || !readU32(pos, hasRefs)) {
+                delete first;
+                return false;
+            }
+
+            DataArrayList *current(new DataArrayList);
+            current->m_numItems = static_cast<size_t>(numItems);
+            current->m_numRefs = static_cast<size_t>(numRefs);
+            if (nullptr == first) {
+                first = current;
+            } else {
+                prev->m_next = current;
+            }
+            prev = current;
+
+            if (0 != hasValues && !readValueList(pos, &current->m_dataList)) {
+                delete first;
+                return false;
+            }
+            if (0 != hasRefs && !readReference(pos, &current->m_refs)) {
+                delete first;
+                return false;
+            }
+
+            // the counts are used to walk the lists, so they must match the decoded content
+            const size_t numRefsRead(nullptr != current->m_refs ? current->m_refs->m_numRefs : 0);
+            if (numItems != countValues(current->m_dataList) || numRefs != numRefsRead) {
+                delete first;
+                return false;
+            }
+        }
+        *dtArrayList = first;
+
+        return true;
+    }
+
+private:
+    const char *m_buffer;
+    size_t m_len;
+    SnapshotHeader m_header;
+    const char *m_symbolOffsets;
+    const char *m_symbolBlob;
+    uint64 m_blobSize;
+    const char *m_nodeTable;
+    const char *m_data;
+    uint64 m_dataSize;
+    const char *m_source;
+};
+
+bool OpenDDLSnapshot::write(const Context *ctx, std::vector<char> &buffer, const char *source, size_t sourceLen) {
+    buffer.clear();
+    if (nullptr == ctx || nullptr == ctx->m_root || (nullptr == source && 0 != sourceLen)) {
+        return false;
+    }
+
+    SnapshotWriter writer;
+    writer.writeNodes(ctx->m_root, InvalidIndex);
+    writer.finish(buffer, source, sourceLen);
+
+    return true;
+}
+
+bool OpenDDLSnapshot::writeFile(const Context *ctx, const std::string &filename, const char *source, size_t sourceLen) {
+    std::vector<char> buffer;
+    if (!write(ctx, buffer, source, sourceLen)) {
+        return false;
+    }
+
+    FILE *file = ::fopen(filename.c_str(), "wb");
+    if (nullptr == file) {
+        return false;
+    }
+
+    const size_t written(::fwrite(&buffer[0], sizeof(char), buffer.size(), file));
+    const bool closed(0 == ::fclose(file));
+
+    return closed && written == buffer.size();
+}
+
+Context *OpenDDLSnapshot::read(const char *buffer, size_t len, const char *source, size_t sourceLen) {
+    SnapshotReader reader(buffer, len);
+    if (!reader.validate()) {
+        return nullptr;
+    }
+
+    // a snapshot found by a hash of the source is only valid for exactly the same source
+    if (nullptr != source && !reader.hasSource(source, sourceLen)) {
+        return nullptr;
+    }
+
+    return reader.createContext();
+}
+
+Context *OpenDDLSnapshot::readFile(const std::string &filename, const char *source, size_t sourceLen) {
+    MemoryMappedFile file;
+    if (!file.open(filename)) {
+        return nullptr;
+    }
+
+    return read(file.getData(), file.getSize(), source, sourceLen);
+}
+
+bool OpenDDLSnapshot::isSnapshot(const char *buffer, size_t len) {
+    if (nullptr == buffer || len < sizeof(SnapshotHeader)) {
+        return false;
+    }
+
+    return 0 == ::memcmp(buffer, SnapshotMagic, sizeof(SnapshotMagic));
+}
+
+END_ODDLPARSER_NS
@@ -22,6 +22,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <openddlparser/OpenDDLStream.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 BEGIN_ODDLPARSER_NS
 
 StreamFormatterBase::StreamFormatterBase() {
@@ -39,6 +52,7 @@ std::string StreamFormatterBase::format(const std::string &statement) {
 
 IOStreamBase::IOStreamBase(StreamFormatterBase *formatter) :
         m_formatter(formatter),
+        m_useFormatter(nullptr != formatter),
         m_file(nullptr) {
     if (nullptr == m_formatter) {
         m_formatter = new StreamFormatterBase;
@@ -89,8 +103,390 @@ size_t IOStreamBase::write(const std::string &statement) {
     if (nullptr == m_file) {
         return 0;
     }
-    std::string formatStatement = m_formatter->format(statement);
-    return ::fwrite(formatStatement.c_str(), sizeof(char), formatStatement.size(), m_file);
+
+    if (m_useFormatter) {
+        const std::string formatStatement = m_formatter->format(statement);
+        return ::fwrite(formatStatement.c_str(), sizeof(char), formatStatement.size(), m_file);
+    }
+
+    // the default formatter does not change anything, so skip the copy
+    return ::fwrite(statement.c_str(), sizeof(char), statement.size(), m_file);
+}
+
+size_t IOStreamBase::write(const char *data, size_t len) {
+    if (nullptr == data) {
+        return 0;
+    }
+
+    // the file of this class without a formatter takes the block as it is
+    if (nullptr != m_file && !m_useFormatter) {
+        return ::fwrite(data, sizeof(char), len, m_file);
+    }
+
+    // derived streams may only override the string version
+    return write(std::string(data, len));
+}
+
+MemoryStream::MemoryStream(std::string *target) :
+        IOStreamBase(),
+        m_data(),
+        m_target(nullptr != target ? target : &m_data),
+        m_isOpen(true) {
+    // empty
+}
+
+MemoryStream::~MemoryStream() {
+    // empty
+}
+
+bool MemoryStream::open(const std::string &) {
+    m_target->clear();
+    m_isOpen = true;
+
+    return true;
+}
+
+bool MemoryStream::close() {
+    m_isOpen = false;
+
+    return true;
+}
+
+bool MemoryStream::isOpen() const {
+    return m_isOpen;
+}
+
+size_t MemoryStream::write(const std::string &statement) {
+    return write(statement.c_str(), statement.size());
+}
+
+size_t MemoryStream::write(const char *data, size_t len) {
+    if (!m_isOpen || nullptr == data) {
+        return 0;
+    }
+    m_target->append(data, len);
+
+    return len;
+}
+
+const std::string &MemoryStream::getString() const {
+    return *m_target;
+}
+
+CallbackStream::CallbackStream(writeCallback callback) :
+        IOStreamBase(),
+        m_callback(callback),
+        m_isOpen(true) {
+    // empty
+}
+
+CallbackStream::~CallbackStream() {
+    // empty
+}
+
+bool CallbackStream::open(const std::string &) {
+    m_isOpen = true;
+
+    return isOpen();
+}
+
+bool CallbackStream::close() {
+    m_isOpen = false;
+
+    return true;
+}
+
+bool CallbackStream::isOpen() const {
+    return m_isOpen && m_callback;
+}
+
+size_t CallbackStream::write(const std::string &statement) {
+    return write(statement.c_str(), statement.size());
+}
+
+size_t CallbackStream::write(const char *data, size_t len) {
+    if (!isOpen() || nullptr == data) {
+        return 0;
+    }
+
+    return m_callback(data, len);
+}
+
+#ifdef _WIN32
+static int createOutputFile(const std::string &name) {
+    return ::_open(name.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+static void closeFile(int fd) {
+    ::_close(fd);
+}
+
+static bool writeAll(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        const unsigned int chunk(static_cast<unsigned int>(std::min<size_t>(len, 1u << 30)));
+        const int written(::_write(fd, data, chunk));
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        len -= static_cast<size_t>(written);
+    }
+
+    return true;
+}
+#else
+static int createOutputFile(const std::string &name) {
+    return ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+static void closeFile(int fd) {
+    ::close(fd);
+}
+#endif
+
+const size_t FileDescriptorStream::BufferSize;
+
+FileDescriptorStream::FileDescriptorStream(int fd, bool ownsFd) :
+        IOStreamBase(),
+        m_fd(fd),
+        m_ownsFd(ownsFd),
+        m_pending() {
+    // empty
+}
+
+FileDescriptorStream::~FileDescriptorStream() {
+    close();
+}
+
+bool FileDescriptorStream::open(const std::string &name) {
+    close();
+    m_fd = createOutputFile(name);
+    m_ownsFd = true;
+
+    return isOpen();
+}
+
+bool FileDescriptorStream::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+    const bool success(flush());
+    if (m_ownsFd) {
+        closeFile(m_fd);
+    }
+    m_fd = -1;
+    m_ownsFd = false;
+
+    return success;
+}
+
+bool FileDescriptorStream::isOpen() const {
+    return m_fd >= 0;
+}
+
+size_t FileDescriptorStream::write(const std::string &statement) {
+    return write(statement.c_str(), statement.size());
+}
+
+size_t FileDescriptorStream::write(const char *data, size_t len) {
+    if (!isOpen() || nullptr == data) {
+        return 0;
+    }
+
+    if (m_pending.size() + len <= BufferSize) {
+        if (m_pending.capacity() < BufferSize) {
+            m_pending.reserve(BufferSize);
+        }
+        m_pending.append(data, len);
+        return len;
+    }
+
+    // the pending data and the new block go out in one call
+    const bool success(writeBlocks(m_pending.c_str(), m_pending.size(), data, len));
+    m_pending.clear();
+
+    return success ? len : 0;
+}
+
+bool FileDescriptorStream::flush() {
+    if (!isOpen() || m_pending.empty()) {
+        return true;
+    }
+
+    const bool success(writeBlocks(m_pending.c_str(), m_pending.size(), nullptr, 0));
+    m_pending.clear();
+
+    return success;
+}
+
+bool FileDescriptorStream::writeBlocks(const char *first, size_t firstLen, const char *second, size_t secondLen) {
+#ifdef _WIN32
+    return writeAll(m_fd, first, firstLen) && writeAll(m_fd, second, secondLen);
+#else
+    struct iovec blocks[2];
+    blocks[0].iov_base = const_cast<char *>(first);
+    blocks[0].iov_len = firstLen;
+    blocks[1].iov_base = const_cast<char *>(second);
+    blocks[1].iov_len = secondLen;
+    struct iovec *current(blocks);
+    int numBlocks(2);
+    while (numBlocks > 0) {
+        if (0 == current->iov_len) {
+            ++current;
+            --numBlocks;
+            continue;
+        }
+
+        const ssize_t written(::writev(m_fd, current, numBlocks));
+        if (written < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+
+        // skip the written part, a short write can end in any of the blocks
+        size_t remaining(static_cast<size_t>(written));
+        while (numBlocks > 0 && remaining >= current->iov_len) {
+            remaining -= current->iov_len;
+            ++current;
+            --numBlocks;
+        }
+        if (numBlocks > 0) {
+            current->iov_base = static_cast<char *>(current->iov_base) + remaining;
+            current->iov_len -= remaining;
+        }
+    }
+
+    return true;
+#endif
+}
+
+const size_t MappedFileStream::MinGrowSize;
+
+MappedFileStream::MappedFileStream() :
+        IOStreamBase(),
+        m_fd(-1),
+        m_mapping(nullptr),
+        m_capacity(0),
+        m_size(0) {
+    // empty
+}
+
+MappedFileStream::~MappedFileStream() {
+    close();
+}
+
+bool MappedFileStream::open(const std::string &name) {
+    close();
+#ifdef _WIN32
+    m_fd = createOutputFile(name);
+#else
+    m_fd = ::open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+#endif
+
+    return isOpen();
+}
+
+bool MappedFileStream::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+    bool success(true);
+#ifndef _WIN32
+    if (nullptr != m_mapping) {
+        ::munmap(m_mapping, m_capacity);
+        m_mapping = nullptr;
+    }
+    // cut off the reserved but unused part
+    success = 0 == ::ftruncate(m_fd, static_cast<off_t>(m_size));
+#endif
+    closeFile(m_fd);
+    m_fd = -1;
+    m_capacity = 0;
+    m_size = 0;
+
+    return success;
+}
+
+bool MappedFileStream::isOpen() const {
+    return m_fd >= 0;
+}
+
+#ifndef _WIN32
+// Gives the file real blocks up to the new size. A file which is only extended by ftruncate is
+// sparse, then a write into the mapping raises SIGBUS instead of an error once the disk is full.
+static bool allocateFile(int fd, size_t offset, size_t len) {
+#ifdef __APPLE__
+    // there is no posix_fallocate, the file stays sparse
+    return 0 == ::ftruncate(fd, static_cast<off_t>(offset + len));
+#else
+    return 0 == ::posix_fallocate(fd, static_cast<off_t>(offset), static_cast<off_t>(len));
+#endif
+}
+#endif
+
+bool MappedFileStream::reserve(size_t size) {
+#ifdef _WIN32
+    (void)size;
+    return true;
+#else
+    if (size <= m_capacity) {
+        return true;
+    }
+
+    const size_t capacity(std::max(size, std::max(m_capacity * 2, MinGrowSize)));
+    if (!allocateFile(m_fd, m_capacity, capacity - m_capacity)) {
+        // the written data stays mapped, close() cuts off the new blocks
+        return false;
+    }
+
+    void *mapping(MAP_FAILED);
+    if (nullptr == m_mapping) {
+        mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    } else {
+#ifdef __linux__
+        // grows the mapping in place if possible, the written pages are never copied
+        mapping = ::mremap(m_mapping, m_capacity, capacity, MREMAP_MAYMOVE);
+#else
+        mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (MAP_FAILED != mapping) {
+            ::munmap(m_mapping, m_capacity);
+        }
+#endif
+    }
+    if (MAP_FAILED == mapping) {
+        return false;
+    }
+    m_mapping = static_cast<char *>(mapping);
+    m_capacity = capacity;
+
+    return true;
+#endif
+}
+
+size_t MappedFileStream::write(const std::string &statement) {
+    return write(statement.c_str(), statement.size());
+}
+
+size_t MappedFileStream::write(const char *data, size_t len) {
+    if (!isOpen() || nullptr == data) {
+        return 0;
+    }
+
+#ifdef _WIN32
+    return writeAll(m_fd, data, len) ? len : 0;
+#else
+    if (!reserve(m_size + len)) {
+        return 0;
+    }
+    ::memcpy(m_mapping + m_size, data, len);
+    m_size += len;
+
+    return len;
+#endif
 }
 
 END_ODDLPARSER_NS
@@ -0,0 +1,122 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/OpenDDLTrace.h>
+
+#include <atomic>
+#include <cstring>
+
+BEGIN_ODDLPARSER_NS
+
+static std::atomic<OpenDDLTracer *> s_tracer(nullptr);
+
+OpenDDLTracer::~OpenDDLTracer() {
+    // empty
+}
+
+void OpenDDLTracer::install(OpenDDLTracer *tracer) {
+    s_tracer.store(tracer);
+}
+
+OpenDDLTracer *OpenDDLTracer::getInstalled() {
+    return s_tracer.load(std::memory_order_acquire);
+}
+
+bool OpenDDLTracer::isAvailable() {
+#ifdef OPENDDL_TRACING
+    return true;
+#else
+    return false;
+#endif // OPENDDL_TRACING
+}
+
+const char *OpenDDLTracer::getEventName(TraceEvent event) {
+    static const char *Names[ddl_num_trace_events] = {
+        "structure_begin",
+        "structure_end",
+        "data_list",
+        "error",
+        "allocation"
+    };
+    if (event >= ddl_num_trace_events) {
+        return "";
+    }
+
+    return Names[event];
+}
+
+const size_t RingBufferTracer::DefaultCapacity;
+const size_t RingBufferTracer::MaxNameLen;
+
+RingBufferTracer::RingBufferTracer(size_t capacity) :
+        m_mutex(),
+        m_entries(),
+        m_numTraced(0) {
+    m_entries.resize(0 == capacity ? 1 : capacity);
+}
+
+RingBufferTracer::~RingBufferTracer() {
+    // empty
+}
+
+void RingBufferTracer::trace(const TraceRecord &record) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry &entry(m_entries[m_numTraced % m_entries.size()]);
+    entry.m_event = record.m_event;
+    entry.m_nanoseconds = record.m_nanoseconds;
+    entry.m_offset = record.m_offset;
+    entry.m_size = record.m_size;
+    entry.m_name[0] = '\0';
+    if (nullptr != record.m_name) {
+        strncat(entry.m_name, record.m_name, MaxNameLen);
+    }
+    ++m_numTraced;
+}
+
+std::vector<RingBufferTracer::Entry> RingBufferTracer::getEntries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Entry> entries;
+    if (m_numTraced <= m_entries.size()) {
+        entries.assign(m_entries.begin(), m_entries.begin() + m_numTraced);
+        return entries;
+    }
+
+    // the oldest entry is the one which will be overwritten next
+    const size_t oldest(m_numTraced % m_entries.size());
+    entries.reserve(m_entries.size());
+    entries.insert(entries.end(), m_entries.begin() + oldest, m_entries.end());
+    entries.insert(entries.end(), m_entries.begin(), m_entries.begin() + oldest);
+
+    return entries;
+}
+
+size_t RingBufferTracer::getNumTraced() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numTraced;
+}
+
+void RingBufferTracer::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_numTraced = 0;
+}
+
+END_ODDLPARSER_NS
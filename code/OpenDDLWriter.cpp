@@ -0,0 +1,310 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <openddlparser/OpenDDLFormat.h>
+#include <openddlparser/OpenDDLParser.h>
+#include <openddlparser/OpenDDLStream.h>
+#include <openddlparser/OpenDDLWriter.h>
+
+BEGIN_ODDLPARSER_NS
+
+static const size_t IndentWidth = 4;
+static const size_t FlushThreshold = 1024 * 1024;
+
+static void appendName(const char *name, std::string &out) {
+    if ('$' != name[0] && '%' != name[0]) {
+        out += '$';
+    }
+    out += name;
+}
+
+static std::string formatString(const char *value) {
+    std::string out("\"");
+    if (nullptr != value) {
+        out += value;
+    }
+    out += '"';
+
+    return out;
+}
+
+static std::string formatSigned(int64 value) {
+    char buffer[FormatBufferSize];
+    return std::string(buffer, formatInt64(value, buffer));
+}
+
+static std::string formatUnsigned(uint64 value) {
+    char buffer[FormatBufferSize];
+    return std::string(buffer, formatUInt64(value, buffer));
+}
+
+WriterProperty::WriterProperty() :
+        m_key(), m_value() {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, const char *value) :
+        m_key(key), m_value(formatString(value)) {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, const std::string &value) :
+        m_key(key), m_value(formatString(value.c_str())) {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, bool value) :
+        m_key(key), m_value(value ? "true" : "false") {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, int32 value) :
+        m_key(key), m_value(formatSigned(value)) {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, int64 value) :
+        m_key(key), m_value(formatSigned(value)) {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, uint32 value) :
+        m_key(key), m_value(formatUnsigned(value)) {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, uint64 value) :
+        m_key(key), m_value(formatUnsigned(value)) {
+    // empty
+}
+
+WriterProperty::WriterProperty(const char *key, float value) :
+        m_key(key), m_value() {
+    char buffer[FormatBufferSize];
+    m_value.assign(buffer, formatFloat(value, buffer));
+}
+
+WriterProperty::WriterProperty(const char *key, double value) :
+        m_key(key), m_value() {
+    char buffer[FormatBufferSize];
+    m_value.assign(buffer, formatDouble(value, buffer));
+}
+
+WriterProperty WriterProperty::reference(const char *key, const char *name) {
+    WriterProperty prop;
+    prop.m_key = key;
+    appendName(name, prop.m_value);
+
+    return prop;
+}
+
+OpenDDLWriter::OpenDDLWriter(IOStreamBase *stream) :
+        m_stream(stream),
+        m_buffer(),
+        m_level(0),
+        m_success(true) {
+    m_buffer.reserve(FlushThreshold + FlushThreshold / 4);
+}
+
+OpenDDLWriter::~OpenDDLWriter() {
+    flush();
+}
+
+bool OpenDDLWriter::beginStructure(const char *type, const char *name, const WriterProperty *props, size_t numProps) {
+    if (nullptr == type || '\0' == type[0] || (nullptr == props && 0 != numProps)) {
+        return false;
+    }
+
+    m_buffer.append(m_level * IndentWidth, ' ');
+    m_buffer += type;
+    if (nullptr != name && '\0' != name[0]) {
+        m_buffer += ' ';
+        appendName(name, m_buffer);
+    }
+    if (0 != numProps) {
+        m_buffer += " (";
+        for (size_t i = 0; i < numProps; ++i) {
+            if (i > 0) {
+                m_buffer += ", ";
+            }
+            m_buffer += props[i].m_key;
+            m_buffer += " = ";
+            m_buffer += props[i].m_value;
+        }
+        m_buffer += ')';
+    }
+    m_buffer += '\n';
+    m_buffer.append(m_level * IndentWidth, ' ');
+    m_buffer += "{\n";
+    ++m_level;
+
+    return true;
+}
+
+bool OpenDDLWriter::beginStructure(const char *type, const char *name, std::initializer_list<WriterProperty> props) {
+    return beginStructure(type, name, props.begin(), props.size());
+}
+
+bool OpenDDLWriter::endStructure() {
+    if (0 == m_level) {
+        return false;
+    }
+
+    --m_level;
+    m_buffer.append(m_level * IndentWidth, ' ');
+    m_buffer += "}\n";
+    if (m_buffer.size() >= FlushThreshold) {
+        flush();
+    }
+
+    return m_success;
+}
+
+bool OpenDDLWriter::writeReferences(const char *const *names, size_t count) {
+    if (nullptr == names && 0 != count) {
+        return false;
+    }
+
+    beginData(Value::ValueType::ddl_ref, 1);
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            writeSeparator();
+        }
+        appendName(names[i], m_buffer);
+    }
+
+    return endData();
+}
+
+bool OpenDDLWriter::flush() {
+    if (m_buffer.empty()) {
+        return m_success;
+    }
+
+    if (nullptr == m_stream || m_stream->write(m_buffer.c_str(), m_buffer.size()) != m_buffer.size()) {
+        m_success = false;
+    }
+    m_buffer.clear();
+
+    return m_success;
+}
+
+size_t OpenDDLWriter::getLevel() const {
+    return m_level;
+}
+
+void OpenDDLWriter::beginData(Value::ValueType type, size_t subarraySize) {
+    m_buffer.append(m_level * IndentWidth, ' ');
+    m_buffer += getTypeToken(type);
+    if (subarraySize > 1) {
+        m_buffer += '[';
+        writeItem(static_cast<uint64>(subarraySize));
+        m_buffer += ']';
+    }
+    m_buffer += " { ";
+}
+
+bool OpenDDLWriter::endData() {
+    m_buffer += " }\n";
+    if (m_buffer.size() >= FlushThreshold) {
+        flush();
+    }
+
+    return m_success;
+}
+
+void OpenDDLWriter::beginSubarray(bool first) {
+    if (!first) {
+        m_buffer += ", ";
+    }
+    m_buffer += "{ ";
+}
+
+void OpenDDLWriter::endSubarray() {
+    m_buffer += " }";
+}
+
+void OpenDDLWriter::writeSeparator() {
+    // big lists go out while they are written
+    if (m_buffer.size() >= FlushThreshold) {
+        flush();
+    }
+    m_buffer += ", ";
+}
+
+void OpenDDLWriter::writeItem(bool value) {
+    m_buffer += value ? "true" : "false";
+}
+
+void OpenDDLWriter::writeItem(int8 value) {
+    writeItem(static_cast<int64>(value));
+}
+
+void OpenDDLWriter::writeItem(int16 value) {
+    writeItem(static_cast<int64>(value));
+}
+
+void OpenDDLWriter::writeItem(int32 value) {
+    writeItem(static_cast<int64>(value));
+}
+
+void OpenDDLWriter::writeItem(int64 value) {
+    char buffer[FormatBufferSize];
+    m_buffer.append(buffer, formatInt64(value, buffer));
+}
+
+void OpenDDLWriter::writeItem(uint8 value) {
+    writeItem(static_cast<uint64>(value));
+}
+
+void OpenDDLWriter::writeItem(uint16 value) {
+    writeItem(static_cast<uint64>(value));
+}
+
+void OpenDDLWriter::writeItem(uint32 value) {
+    writeItem(static_cast<uint64>(value));
+}
+
+void OpenDDLWriter::writeItem(uint64 value) {
+    char buffer[FormatBufferSize];
+    m_buffer.append(buffer, formatUInt64(value, buffer));
+}
+
+void OpenDDLWriter::writeItem(float value) {
+    char buffer[FormatBufferSize];
+    m_buffer.append(buffer, formatFloat(value, buffer));
+}
+
+void OpenDDLWriter::writeItem(double value) {
+    char buffer[FormatBufferSize];
+    m_buffer.append(buffer, formatDouble(value, buffer));
+}
+
+void OpenDDLWriter::writeItem(const char *value) {
+    m_buffer += '"';
+    if (nullptr != value) {
+        m_buffer += value;
+    }
+    m_buffer += '"';
+}
+
+END_ODDLPARSER_NS
@@ -20,10 +20,13 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
+#include <openddlparser/OpenDDLHalf.h>
 #include <openddlparser/OpenDDLStream.h>
 #include <openddlparser/Value.h>
 
 #include <cassert>
+#include <limits>
+#include <type_traits>
 
 BEGIN_ODDLPARSER_NS
 
@@ -232,8 +235,24 @@ void Value::setFloat(float value) {
     ::memcpy(m_data, &value, m_size);
 }
 
+void Value::setHalf(float value) {
+    assert(ValueType::ddl_half == m_type);
+    const uint16 bits(floatToHalf(value));
+    ::memcpy(m_data, &bits, m_size);
+}
+
+float Value::getHalf() const {
+    assert(ValueType::ddl_half == m_type);
+    uint16 bits;
+    ::memcpy(&bits, m_data, m_size);
+
+    return halfToFloat(bits);
+}
+
 float Value::getFloat() const {
-    if (m_type == ValueType::ddl_float) {
+    if (m_type == ValueType::ddl_half) {
+        return getHalf();
+    } else if (m_type == ValueType::ddl_float) {
         float v;
         ::memcpy(&v, m_data, m_size);
         return (float)v;
@@ -250,12 +269,14 @@ void Value::setDouble(double value) {
 }
 
 double Value::getDouble() const {
-    if (m_type == ValueType::ddl_double) {
+    if (m_type == ValueType::ddl_half) {
+        return getHalf();
+    } else if (m_type == ValueType::ddl_double) {
         double v;
         ::memcpy(&v, m_data, m_size);
-        return (float)v;
+        return v;
     } else {
-        double tmp;
+        float tmp;
         ::memcpy(&tmp, m_data, 4);
         return (double)tmp;
     }
@@ -326,7 +347,7 @@ void Value::dump(IOStreamBase &stream) {
             stream.write("Not supported\n");
             break;
         case ValueType::ddl_half:
-            stream.write("Not supported\n");
+            stream.write(std::to_string(getHalf()) + "\n");
             break;
         case ValueType::ddl_float:
             stream.write(std::to_string(getFloat()) + "\n");
@@ -363,6 +384,130 @@ size_t Value::size() const {
     return result;
 }
 
+template<class T, class S>
+static inline typename std::enable_if<!std::is_integral<T>::value || !std::is_floating_point<S>::value, T>::type
+castValue(S value) {
+    return static_cast<T>(value);
+}
+
+// a cast of NaN or of a value out of the range of the integer type would be undefined, so the
+// value saturates and NaN becomes 0
+template<class T, class S>
+static inline typename std::enable_if<std::is_integral<T>::value && std::is_floating_point<S>::value, T>::type
+castValue(S value) {
+    if (value != value) {
+        return 0;
+    }
+    if (value <= static_cast<S>(std::numeric_limits<T>::min())) {
+        return std::numeric_limits<T>::min();
+    }
+    if (value >= static_cast<S>(std::numeric_limits<T>::max())) {
+        return std::numeric_limits<T>::max();
+    }
+
+    return static_cast<T>(value);
+}
+
+template<class T, class S>
+static inline T convertValue(const unsigned char *data) {
+    S value;
+    ::memcpy(&value, data, sizeof(S));
+
+    return castValue<T, S>(value);
+}
+
+// copies the run of values with the type of the first one, the type is only dispatched once per run
+template<class T, class S>
+static size_t copyRun(const Value *&value, T *out, size_t n) {
+    const Value::ValueType type(value->m_type);
+    size_t i(0);
+    for (; nullptr != value && i < n && type == value->m_type; value = value->m_next, ++i) {
+        out[i] = convertValue<T, S>(value->m_data);
+    }
+
+    return i;
+}
+
+template<class T>
+static size_t copyHalfRun(const Value *&value, T *out, size_t n) {
+    size_t i(0);
+    for (; nullptr != value && i < n && Value::ValueType::ddl_half == value->m_type; value = value->m_next, ++i) {
+        out[i] = castValue<T, float>(halfToFloat(convertValue<uint16, uint16>(value->m_data)));
+    }
+
+    return i;
+}
+
+template<class T>
+size_t Value::copyTo(T *out, size_t n) const {
+    if (nullptr == out) {
+        return 0;
+    }
+
+    size_t copied(0);
+    const Value *current(this);
+    while (nullptr != current && copied < n) {
+        size_t count(0);
+        switch (current->m_type) {
+            case ValueType::ddl_bool:
+                count = copyRun<T, bool>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_int8:
+                count = copyRun<T, int8>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_int16:
+                count = copyRun<T, int16>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_int32:
+                count = copyRun<T, int32>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_int64:
+                count = copyRun<T, int64>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_unsigned_int8:
+                count = copyRun<T, uint8>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_unsigned_int16:
+                count = copyRun<T, uint16>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_unsigned_int32:
+                count = copyRun<T, uint32>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_unsigned_int64:
+                count = copyRun<T, uint64>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_half:
+                count = copyHalfRun<T>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_float:
+                count = copyRun<T, float>(current, out + copied, n - copied);
+                break;
+            case ValueType::ddl_double:
+                count = copyRun<T, double>(current, out + copied, n - copied);
+                break;
+            default:
+                break;
+        }
+        if (0 == count) {
+            break;
+        }
+        copied += count;
+    }
+
+    return copied;
+}
+
+template size_t Value::copyTo<int8>(int8 *, size_t) const;
+template size_t Value::copyTo<int16>(int16 *, size_t) const;
+template size_t Value::copyTo<int32>(int32 *, size_t) const;
+template size_t Value::copyTo<int64>(int64 *, size_t) const;
+template size_t Value::copyTo<uint8>(uint8 *, size_t) const;
+template size_t Value::copyTo<uint16>(uint16 *, size_t) const;
+template size_t Value::copyTo<uint32>(uint32 *, size_t) const;
+template size_t Value::copyTo<uint64>(uint64 *, size_t) const;
+template size_t Value::copyTo<float>(float *, size_t) const;
+template size_t Value::copyTo<double>(double *, size_t) const;
+
 Value *ValueAllocator::allocPrimData(Value::ValueType type, size_t len) {
     if (type == Value::ValueType::ddl_none || Value::ValueType::ddl_types_max == type) {
         return nullptr;
@@ -398,7 +543,7 @@ Value *ValueAllocator::allocPrimData(Value::ValueType type, size_t len) {
             data->m_size = sizeof(uint64);
             break;
         case Value::ValueType::ddl_half:
-            data->m_size = sizeof(short);
+            data->m_size = sizeof(uint16);
             break;
         case Value::ValueType::ddl_float:
             data->m_size = sizeof(float);
@@ -22,7 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <openddlparser/OpenDDLExport.h>
 #include <openddlparser/OpenDDLParser.h>
-#include <cassert>
+#include <cstring>
 #include <iostream>
 
 USE_ODDLPARSER_NS
@@ -128,44 +128,23 @@ int main(int argc, char *argv[]) {
         std::cout << "file to import: " << filename << std::endl;
     }
 
-    FILE *fileStream = fopen(filename, "rb+");
-    if (nullptr == fileStream) {
-        std::cerr << "Cannot open file " << filename << std::endl;
+    // regular files will be memory-mapped, no need to read them into an own buffer
+    OpenDDLParser theParser;
+    const bool result(theParser.parseFile(filename));
+    if (!result) {
+        std::cerr << "Error while parsing file " << filename << "." << std::endl;
         return Error;
     }
 
-    // obtain file size:
-    fseek(fileStream, 0, SEEK_END);
-    const int size(ftell(fileStream));
-    if (-1 == size) {
-        std::cerr << "Error while obtaining file-size of file " << filename << ", aborting operation.\n";
-        return Error;
+    DDLNode *root = theParser.getRoot();
+    if (dump) {
+        IOStreamBase stream;
+        dumpDDLNodeTree(root, 0, stream);
     }
-
-    ::rewind(fileStream);
-    if (size > 0) {
-        char *buffer = new char[size];
-        const size_t readSize(fread(buffer, sizeof(char), size, fileStream));
-        assert(readSize == static_cast<size_t>(size));
-        OpenDDLParser theParser;
-        theParser.setBuffer(buffer, size);
-        const bool result(theParser.parse());
-        if (!result) {
-            std::cerr << "Error while parsing file " << filename << "." << std::endl;
-        } else {
-            DDLNode *root = theParser.getRoot();
-            if (dump) {
-                IOStreamBase stream;
-                dumpDDLNodeTree(root, 0, stream);
-            }
-            if (exportToFile) {
-                OpenDDLExport theExporter;
-                theExporter.exportContext(theParser.getContext(), exportFilename);
-            }
-        }
-        delete[] buffer;
+    if (exportToFile) {
+        OpenDDLExport theExporter;
+        theExporter.exportContext(theParser.getContext(), exportFilename);
     }
-    fclose(fileStream);
 
     return 0;
 }
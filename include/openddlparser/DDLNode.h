@@ -33,6 +33,7 @@ BEGIN_ODDLPARSER_NS
 class IOStreamBase;
 class Value;
 class OpenDDLParser;
+class OpenDDLPatch;
 
 struct Identifier;
 struct Reference;
@@ -51,6 +52,7 @@ struct DataArrayList;
 class DLL_ODDLPARSER_EXPORT DDLNode {
 public:
     friend class OpenDDLParser;
+    friend class OpenDDLPatch;
 
     /// @brief  The child-node-list type.
     using DllNodeList = std::vector<DDLNode *> ;
@@ -78,16 +80,26 @@ public:
     const DllNodeList &getChildNodeList() const;
 
     /// Set the type of the DDLNode instance.
-    /// @param  type    [in] The type.
-    void setType(const std::string &type);
+    /// @param  type    [in] The type, an rvalue will be moved.
+    void setType(std::string type);
+
+    /// Set the type of the DDLNode instance without creating a temporary string.
+    /// @param  type    [in] The first character of the type.
+    /// @param  len     [in] The length of the type.
+    void setType(const char *type, size_t len);
 
     /// @brief  Returns the type of the DDLNode instance.
     /// @return The type of the DDLNode instance.
     const std::string &getType() const;
 
     /// Set the name of the DDLNode instance.
-    /// @param  name        [in] The name.
-    void setName(const std::string &name);
+    /// @param  name        [in] The name, an rvalue will be moved.
+    void setName(std::string name);
+
+    /// Set the name of the DDLNode instance without creating a temporary string.
+    /// @param  name        [in] The first character of the name.
+    /// @param  len         [in] The length of the name.
+    void setName(const char *name, size_t len);
 
     /// @brief  Returns the name of the DDLNode instance.
     /// @return The name of the DDLNode instance.
@@ -139,23 +151,39 @@ public:
     ///	@return The first property of the assigned Reference set.
     Reference *getReferences() const;
 
+    /// @brief  Set the range of the node in the parsed source text.
+    /// @param  begin       [in] The offset of the first character of the node type.
+    /// @param  end         [in] The offset behind the closing bracket of the node.
+    void setSourceRange(size_t begin, size_t end);
+
+    /// @brief  Returns the offset of the node in the parsed source text.
+    /// @return The offset of the first character of the node type.
+    size_t getSourceBegin() const;
+
+    /// @brief  Returns the end offset of the node in the parsed source text.
+    /// @return The offset behind the closing bracket of the node.
+    size_t getSourceEnd() const;
+
     /// @brief  Will dump the node into the stream.
     /// @param  stream      [in] The stream to write to.
     void dump(IOStreamBase &stream);
 
     ///	@brief  The creation method.
-    /// @param  type        [in] The DDLNode type.
-    ///	@param  name        [in] The name for the new DDLNode instance.
+    /// @param  type        [in] The DDLNode type, an rvalue will be moved.
+    ///	@param  name        [in] The name for the new DDLNode instance, an rvalue will be moved.
     /// @param  parent      [in] The parent node instance or ddl_nullptr if no parent node is there.
     /// @return The new created node instance.
-    static DDLNode *create(const std::string &type, const std::string &name, DDLNode *parent = nullptr);
+    static DDLNode *create(std::string type, std::string name, DDLNode *parent = nullptr);
+
+    ///	@brief  Returns the number of created nodes which are not deleted yet.
+    /// @return The number of living nodes.
+    static size_t getNumAllocatedNodes();
 
 private:
-    DDLNode(const std::string &type, const std::string &name, size_t idx, DDLNode *parent = nullptr);
+    DDLNode(std::string &&type, std::string &&name, DDLNode *parent = nullptr);
     DDLNode();
     DDLNode(const DDLNode &) ddl_no_copy;
     DDLNode &operator=(const DDLNode &) ddl_no_copy;
-    static void releaseNodes();
 
 private:
     std::string m_type;
@@ -166,8 +194,8 @@ private:
     Value *m_value;
     DataArrayList *m_dtArrayList;
     Reference *m_references;
-    size_t m_idx;
-    static DllNodeList s_allocatedNodes;
+    size_t m_sourceBegin;
+    size_t m_sourceEnd;
 };
 
 END_ODDLPARSER_NS
@@ -0,0 +1,87 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+#include <string>
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      This class maps a file read-only into memory.
+///
+/// The file content stays valid until close() is called or the instance is destroyed. The mapping
+/// is advised for sequential access and supports files bigger than 4 GB on 64-bit platforms.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT MemoryMappedFile {
+public:
+    ///	@brief  The default class constructor.
+    MemoryMappedFile();
+
+    ///	@brief  The class destructor, will unmap the file.
+    ~MemoryMappedFile();
+
+    ///	@brief  Maps the given file into memory.
+    /// @param  filename    [in] The name of the file to map.
+    /// @return true, if the file was mapped successfully, false if not.
+    bool open(const std::string &filename);
+
+    ///	@brief  Unmaps the file.
+    void close();
+
+    ///	@brief  Returns true, if a file is mapped.
+    /// @return true, if a file is mapped.
+    bool isOpen() const;
+
+    ///	@brief  Returns the pointer to the mapped content.
+    /// @return The content or nullptr if no file is mapped or the file is empty.
+    const char *getData() const;
+
+    ///	@brief  Returns the size of the mapped content in bytes.
+    /// @return The size in bytes.
+    size_t getSize() const;
+
+    ///	@brief  Reads a whole file into a buffer, used for inputs which cannot be mapped.
+    /// @param  filename    [in] The name of the file, pipes and other streams are supported.
+    /// @param  buffer      [out] The content.
+    /// @return true, if the file was read successfully, false if not.
+    static bool readFile(const std::string &filename, std::vector<char> &buffer);
+
+private:
+    MemoryMappedFile(const MemoryMappedFile &) ddl_no_copy;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) ddl_no_copy;
+
+private:
+    const char *m_data;
+    size_t m_size;
+    bool m_open;
+#ifdef _WIN32
+    void *m_file;
+    void *m_mapping;
+#endif // _WIN32
+};
+
+END_ODDLPARSER_NS
@@ -0,0 +1,129 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      This class loads many files at once, reading and parsing overlap.
+///
+/// Reader threads read the files into buffers and push them into a bounded queue, parser threads
+/// take the buffers from the queue and parse them. So the next files are read while the current
+/// ones are parsed, the queue limits the memory held by buffers waiting for a parser. Compressed
+/// files ( @see CompressedInputStream ) are decompressed by the readers.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT OpenDDLBatchLoader {
+public:
+    /// @brief  The outcome for one file.
+    struct Result {
+        std::string m_filename; ///< The name of the file.
+        std::unique_ptr<Context> m_context; ///< The parsed context, empty in case of an error.
+        std::string m_error; ///< The error message, empty in case of success.
+
+        /// @brief  Returns true, if the file was loaded.
+        bool isValid() const {
+            return nullptr != m_context.get();
+        }
+    };
+
+    /// @brief  The statistics of the last load.
+    struct Statistics {
+        size_t m_numFiles; ///< The number of requested files.
+        size_t m_numFailed; ///< The number of files which could not be read or parsed.
+        size_t m_bytesRead; ///< The bytes read from the files, after decompression.
+        size_t m_maxQueueDepth; ///< The highest number of buffers waiting for a parser.
+        double m_readSeconds; ///< The time spent in reading, summed over all readers.
+        double m_parseSeconds; ///< The time spent in parsing, summed over all parsers.
+        double m_readerWaitSeconds; ///< The time readers waited for a free queue slot.
+        double m_parserWaitSeconds; ///< The time parsers waited for a buffer.
+        double m_wallSeconds; ///< The duration of the whole load.
+
+        /// @brief  Returns the throughput in bytes per second.
+        double getBytesPerSecond() const {
+            return m_wallSeconds > 0.0 ? static_cast<double>(m_bytesRead) / m_wallSeconds : 0.0;
+        }
+
+        /// @brief  Returns the throughput in files per second.
+        double getFilesPerSecond() const {
+            return m_wallSeconds > 0.0 ? static_cast<double>(m_numFiles) / m_wallSeconds : 0.0;
+        }
+    };
+
+    ///	@brief  The default class constructor.
+    OpenDDLBatchLoader();
+
+    ///	@brief  The class destructor.
+    ~OpenDDLBatchLoader();
+
+    ///	@brief  Sets the number of reader threads, 0 uses one reader.
+    /// @param  numReaders  [in] The number of reader threads.
+    void setNumReaders(size_t numReaders);
+
+    ///	@brief  Returns the number of reader threads.
+    /// @return The number of reader threads.
+    size_t getNumReaders() const;
+
+    ///	@brief  Sets the number of parser threads, 0 uses one parser per hardware thread.
+    /// @param  numParsers  [in] The number of parser threads.
+    void setNumParsers(size_t numParsers);
+
+    ///	@brief  Returns the number of parser threads.
+    /// @return The number of parser threads.
+    size_t getNumParsers() const;
+
+    ///	@brief  Sets the number of read buffers which may wait for a parser.
+    /// @param  capacity    [in] The queue capacity, at least 1.
+    void setQueueCapacity(size_t capacity);
+
+    ///	@brief  Returns the number of read buffers which may wait for a parser.
+    /// @return The queue capacity.
+    size_t getQueueCapacity() const;
+
+    ///	@brief  Loads a list of files.
+    /// @param  filenames   [in] The files to load.
+    /// @return One result per file, in the order of the list.
+    std::vector<Result> load(const std::vector<std::string> &filenames);
+
+    ///	@brief  Returns the statistics of the last load.
+    /// @return The statistics.
+    const Statistics &getStatistics() const;
+
+private:
+    OpenDDLBatchLoader(const OpenDDLBatchLoader &) ddl_no_copy;
+    OpenDDLBatchLoader &operator=(const OpenDDLBatchLoader &) ddl_no_copy;
+
+private:
+    size_t m_numReaders;
+    size_t m_numParsers;
+    size_t m_queueCapacity;
+    Statistics m_statistics;
+};
+
+END_ODDLPARSER_NS
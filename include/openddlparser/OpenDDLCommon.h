@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <cstddef>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -100,6 +101,13 @@ using uint16 = unsigned short ; ///< Unsigned integer, 2 byte
 using uint32 = unsigned int; ///< Unsigned integer, 4 byte
 using uint64 = uint64_impl ; ///< Unsigned integer, 8 byte
 
+///	@brief  Computes a fast, non-cryptographic 64-bit hash of a memory block.
+/// @param  data        [in] The memory block.
+/// @param  len         [in] The size of the block in bytes.
+/// @param  seed        [in] The seed for the hash.
+/// @return The hash value.
+DLL_ODDLPARSER_EXPORT uint64 computeHash(const void *data, size_t len, uint64 seed = 0);
+
 ///	@brief  Stores a text.
 ///
 /// A text is stored in a simple character buffer. Texts buffer can be
@@ -114,6 +122,15 @@ struct DLL_ODDLPARSER_EXPORT Text {
     /// @param  numChars    [in] The number of characters in the buffer.
     Text(const char *buffer, size_t numChars);
 
+    ///	@brief  The move constructor, takes over the buffer of the other text.
+    /// @param  rhs         [in] The text to move from, it will be empty afterwards.
+    Text(Text &&rhs);
+
+    ///	@brief  The move assignment, takes over the buffer of the other text.
+    /// @param  rhs         [in] The text to move from, it will be empty afterwards.
+    /// @return This text.
+    Text &operator=(Text &&rhs);
+
     ///	@brief  The destructor.
     ~Text();
 
@@ -151,7 +168,15 @@ struct DLL_ODDLPARSER_EXPORT Name {
     ///	@param  type    [in] The name type.
     ///	@param  id      [in] The id.
     Name(NameType type, Text *id);
+
+    ///	@brief  The constructor with the type and an id, which will be moved.
+    ///	@param  type    [in] The name type.
+    ///	@param  id      [in] The id, for instance Text(buffer, len).
+    Name(NameType type, Text &&id);
     Name(const Name &name);
+
+    ///	@brief  The move constructor, takes over the id of the other name.
+    Name(Name &&rhs);
     ///	@brief  The destructor.
     ~Name();
 
@@ -197,6 +222,10 @@ struct DLL_ODDLPARSER_EXPORT Property {
     /// @param  id      [in] The identifier
     Property(Text *id);
 
+    ///	@brief  The constructor with an identifier, which will be moved.
+    /// @param  id      [in] The identifier, for instance Text(buffer, len).
+    Property(Text &&id);
+
     ///	@brief  The destructor.
     ~Property();
 
@@ -222,11 +251,135 @@ struct DLL_ODDLPARSER_EXPORT DataArrayList {
     /// @brief  Gets the length of the array
     size_t size();
 
+    /// @brief  Copies the values of this list and the following lists into one array.
+    /// @param  out     [out] The array to copy into, for instance a vertex buffer.
+    /// @param  n       [in] The number of items in the array.
+    /// @return The number of copied values.
+    /// @remark The values are converted like Value::copyTo().
+    template<class T>
+    size_t copyTo(T *out, size_t n) const;
+
 private:
     DataArrayList(const DataArrayList &) ddl_no_copy;
     DataArrayList &operator=(const DataArrayList &) ddl_no_copy;
 };
 
+///	@brief  Defines the kinds of objects counted by the parse statistics.
+enum ParseObjectKind {
+    ddl_node_object = 0, ///< DDLNode
+    ddl_value_object, ///< Value, including its data
+    ddl_text_object, ///< Text, including its buffer
+    ddl_name_object, ///< Name
+    ddl_property_object, ///< Property
+    ddl_reference_object, ///< Reference, including its name array
+    ddl_data_array_list_object, ///< DataArrayList
+    ddl_num_object_kinds
+};
+
+///	@brief  Stores the statistics of one parse run ( @see OpenDDLParser::setParseStatsEnabled ).
+struct DLL_ODDLPARSER_EXPORT ParseStats {
+    ///	@brief  The allocations of one object kind.
+    struct Allocations {
+        size_t m_count; ///< The number of allocated objects.
+        size_t m_bytes; ///< The bytes allocated for the objects and the data owned by them.
+    };
+
+    Allocations m_allocations[ddl_num_object_kinds]; ///< The allocations per object kind.
+    size_t m_numNodes; ///< The number of created nodes, including the root.
+    size_t m_numValues; ///< The number of created values.
+    size_t m_maxDepth; ///< The deepest nesting level of the structures.
+    size_t m_inputBytes; ///< The size of the parsed text.
+
+    ///	@brief  The default constructor, all counters are zero.
+    ParseStats();
+
+    ///	@brief  Sets all counters to zero.
+    void clear();
+
+    ///	@brief  Returns the number of allocations of all object kinds.
+    /// @return The number of allocations.
+    size_t getTotalCount() const;
+
+    ///	@brief  Returns the allocated bytes of all object kinds.
+    /// @return The allocated bytes.
+    size_t getTotalBytes() const;
+
+    ///	@brief  Returns the name of an object kind.
+    /// @param  kind    [in] The object kind.
+    /// @return The name, for instance "DDLNode".
+    static const char *getKindName(ParseObjectKind kind);
+};
+
+///	@brief  Defines the phases measured by the parse timers.
+enum ParsePhase {
+    ddl_normalize_phase = 0, ///< Removal of comments and line breaks
+    ddl_header_phase, ///< Structure headers: identifier, name and properties
+    ddl_primitive_type_phase, ///< Matching of the primitive data types
+    ddl_numeric_conversion_phase, ///< Conversion of integer, floating-point and hex literals
+    ddl_node_creation_phase, ///< Creation of the DDLNode instances
+    ddl_allocation_phase, ///< Allocation of values and references
+    ddl_num_parse_phases
+};
+
+///	@brief  Stores the timings of one parse run ( @see OpenDDLParser::setParseTimingsEnabled ).
+///
+/// All times are self times: a phase running inside another one, for instance a node creation
+/// inside a header, is only added to the inner phase. The same is true for nested structures.
+struct DLL_ODDLPARSER_EXPORT ParseTimings {
+    ///	@brief  The measurements of one phase or structure type.
+    struct Timing {
+        size_t m_calls; ///< The number of measured calls.
+        double m_seconds; ///< The time spent in the calls.
+
+        ///	@brief  The default constructor, all counters are zero.
+        Timing();
+    };
+
+    typedef std::map<std::string, Timing> StructureTimings;
+
+    Timing m_phases[ddl_num_parse_phases]; ///< The timings per phase.
+    StructureTimings m_structures; ///< The timings per structure type.
+    double m_totalSeconds; ///< The time of the whole parse run.
+
+    ///	@brief  The default constructor, all timings are zero.
+    ParseTimings();
+
+    ///	@brief  Sets all timings to zero.
+    void clear();
+
+    ///	@brief  Returns the name of a phase.
+    /// @param  phase   [in] The phase.
+    /// @return The name, for instance "normalize".
+    static const char *getPhaseName(ParsePhase phase);
+};
+
+///	@brief  The memory held by a parsed context, broken down by kind ( @see Context::memoryUsage ).
+struct DLL_ODDLPARSER_EXPORT MemoryUsage {
+    size_t m_nodes; ///< The context, the DDLNodes and their child lists.
+    size_t m_strings; ///< Heap buffers of type names, names, identifiers and string values.
+    size_t m_values; ///< Values and their data, unless stored in a data array list.
+    size_t m_properties; ///< The properties, without their keys and values.
+    size_t m_references; ///< References, their name arrays and the names.
+    size_t m_arrays; ///< Data array lists and the values stored in them.
+    size_t m_overhead; ///< The estimated overhead of the heap allocator for all allocations.
+    size_t m_numAllocations; ///< The number of heap allocations.
+
+    ///	@brief  The default constructor, all counters are zero.
+    MemoryUsage();
+
+    ///	@brief  Sets all counters to zero.
+    void clear();
+
+    ///	@brief  Returns the bytes of all kinds, including the allocator overhead.
+    /// @return The total bytes.
+    size_t getTotal() const;
+
+    ///	@brief  Estimates the allocator overhead of one heap allocation.
+    /// @param  bytes   [in] The requested size.
+    /// @return The bookkeeping and alignment bytes of a typical malloc implementation.
+    static size_t getAllocatorOverhead(size_t bytes);
+};
+
 ///	@brief  Stores the context of a parsed OpenDDL declaration.
 struct DLL_ODDLPARSER_EXPORT Context {
     DDLNode *m_root; ///< The root node of the OpenDDL node tree.
@@ -240,6 +393,10 @@ struct DLL_ODDLPARSER_EXPORT Context {
     ///	@brief  Clears the whole node tree.
     void clear();
 
+    ///	@brief  Returns the heap memory held by the context and its node tree.
+    /// @return The memory usage, broken down by kind.
+    MemoryUsage memoryUsage() const;
+
 private:
     Context(const Context &) ddl_no_copy;
     Context &operator=(const Context &) ddl_no_copy;
@@ -0,0 +1,180 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLStream.h>
+
+#include <string>
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+struct CompressionState;
+
+///	@brief  Defines the supported compressed formats.
+enum CompressionFormat {
+    ddl_gzip_format = 0, ///< Deflate data with a gzip header, as written by gzip
+    ddl_zlib_format ///< Deflate data with a zlib header
+};
+
+///	@brief  Returns true, if the library was built with zlib support.
+/// @return true, if compressed streams can be used.
+DLL_ODDLPARSER_EXPORT bool isCompressionSupported();
+
+///	@brief  Checks the header of a buffer for gzip or zlib data.
+/// @param  data        [in] The start of the buffer.
+/// @param  len         [in] The size of the buffer.
+/// @return true, if the buffer starts with a gzip or zlib header.
+DLL_ODDLPARSER_EXPORT bool isCompressedBuffer(const char *data, size_t len);
+
+///	@brief  Decompresses a complete gzip or zlib buffer.
+/// @param  data        [in] The compressed data.
+/// @param  len         [in] The size of the compressed data.
+/// @param  buffer      [out] The decompressed data.
+/// @return true in case of success, false for corrupt data or without zlib support.
+DLL_ODDLPARSER_EXPORT bool decompressBuffer(const char *data, size_t len, std::vector<char> &buffer);
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    IOStreamBase
+///	@brief      This class implements a stream which reads a file and decompresses it on the fly.
+///
+/// The format is detected from the first bytes, gzip and zlib data will be decompressed, all other
+/// data is passed through unchanged. The input is read in blocks, so pipes are supported as well.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT CompressedInputStream : public IOStreamBase {
+public:
+    /// @brief  The size of the block read from the input.
+    static const size_t BufferSize = 256 * 1024;
+
+    /// @brief  The class constructor.
+    /// @param  fd          [in] An already open file descriptor or -1.
+    /// @param  ownsFd      [in] true, if the stream shall close the descriptor.
+    explicit CompressedInputStream(int fd = -1, bool ownsFd = false);
+
+    /// @brief  The class destructor, will close the file.
+    ~CompressedInputStream() ddl_override;
+
+    /// @brief  Opens the file for reading.
+    bool open(const std::string &name) ddl_override;
+
+    /// @brief  Closes the descriptor, if owned.
+    bool close() ddl_override;
+
+    /// @brief  Returns true, if a valid descriptor is assigned.
+    bool isOpen() const ddl_override;
+
+    /// @brief  Reads decompressed data, the statement is resized to the read size.
+    size_t read(size_t sizeToRead, std::string &statement) ddl_override;
+
+    /// @brief  Returns true, if the input is compressed, valid after the first read.
+    /// @return true for compressed input.
+    bool isCompressed() const;
+
+    /// @brief  Returns true, if the input could not be read or is corrupt.
+    /// @return true in case of an error.
+    bool hasError() const;
+
+private:
+    void reset();
+    bool fillInput();
+    bool detectFormat();
+    size_t readCompressed(char *out, size_t len);
+    CompressedInputStream(const CompressedInputStream &) ddl_no_copy;
+    CompressedInputStream &operator=(const CompressedInputStream &) ddl_no_copy;
+
+private:
+    int m_fd;
+    bool m_ownsFd;
+    bool m_detected;
+    bool m_compressed;
+    bool m_eof;
+    bool m_finished;
+    bool m_error;
+    std::vector<char> m_input;
+    size_t m_inputPos;
+    size_t m_inputEnd;
+    CompressionState *m_state;
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    IOStreamBase
+///	@brief      This class implements a stream which compresses all written data into another stream.
+///
+/// Without a target stream the compressed data will be written into the file passed to open. The
+/// compressed stream is completed when the stream gets closed.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT CompressedOutputStream : public IOStreamBase {
+public:
+    /// @brief  The size of the buffer for compressed data.
+    static const size_t BufferSize = 256 * 1024;
+
+    /// @brief  The default compression level of zlib.
+    static const int DefaultLevel = -1;
+
+    /// @brief  The class constructor.
+    /// @param  target      [in] The stream to write the compressed data into, not owned. nullptr to
+    ///                          write into a file.
+    /// @param  format      [in] The format to write.
+    /// @param  level       [in] The compression level from 0 to 9.
+    explicit CompressedOutputStream(IOStreamBase *target = nullptr, CompressionFormat format = ddl_gzip_format, int level = DefaultLevel);
+
+    /// @brief  The class destructor, will complete the compressed stream.
+    ~CompressedOutputStream() ddl_override;
+
+    /// @brief  Opens the target stream, a new compressed stream will be started.
+    bool open(const std::string &name) ddl_override;
+
+    /// @brief  Completes the compressed stream and closes the target stream.
+    bool close() ddl_override;
+
+    /// @brief  Returns true, if the target stream is open.
+    bool isOpen() const ddl_override;
+
+    /// @brief  Compresses the string.
+    size_t write(const std::string &statement) ddl_override;
+
+    /// @brief  Compresses a block of characters.
+    size_t write(const char *data, size_t len) ddl_override;
+
+    /// @brief  Returns true, if the data could not be compressed or written.
+    /// @return true in case of an error.
+    bool hasError() const;
+
+private:
+    bool start();
+    bool compress(const char *data, size_t len, bool finish);
+    CompressedOutputStream(const CompressedOutputStream &) ddl_no_copy;
+    CompressedOutputStream &operator=(const CompressedOutputStream &) ddl_no_copy;
+
+private:
+    IOStreamBase *m_target;
+    bool m_ownsTarget;
+    CompressionFormat m_format;
+    int m_level;
+    bool m_started;
+    bool m_error;
+    std::vector<char> m_output;
+    CompressionState *m_state;
+};
+
+END_ODDLPARSER_NS
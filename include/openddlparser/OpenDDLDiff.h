@@ -0,0 +1,125 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      Describes one operation of a patch.
+///
+/// The path contains the child indices from the root node down to the addressed node, an empty
+/// path addresses the root node itself.
+//-------------------------------------------------------------------------------------------------
+struct DLL_ODDLPARSER_EXPORT PatchOperation {
+    ///	@brief  The operation kinds.
+    enum class Kind {
+        RemoveNode, ///< Removes the node and its children.
+        InsertNode, ///< Inserts a copy of the stored node and its children.
+        UpdateNode ///< Replaces type, name, properties and data of the node, children are kept.
+    };
+
+    Kind m_kind; ///< The kind of operation.
+    std::vector<size_t> m_path; ///< The child indices from the root to the node.
+    DDLNode *m_node; ///< The new node content, owned by the patch ( nullptr for removals ).
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      A list of operations which turns one node tree into another one.
+///
+/// The operations are stored in the order they must be applied. A patch can be applied to any
+/// tree which is equal to the old tree the patch was created from.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT OpenDDLPatch {
+public:
+    ///	@brief  The default class constructor.
+    OpenDDLPatch();
+
+    ///	@brief  The class destructor.
+    ~OpenDDLPatch();
+
+    ///	@brief  Removes all operations.
+    void clear();
+
+    ///	@brief  Returns true, if the patch does not contain any operation.
+    /// @return true if there is no difference.
+    bool empty() const;
+
+    ///	@brief  Returns the number of operations.
+    /// @return The number of operations.
+    size_t size() const;
+
+    ///	@brief  Returns an operation.
+    /// @param  idx         [in] The index of the operation.
+    /// @return The operation.
+    const PatchOperation &get(size_t idx) const;
+
+    ///	@brief  Applies all operations to a live node tree.
+    /// @param  ctx         [in] The context to modify.
+    /// @return true in case of success, false if the tree does not fit to the patch.
+    bool apply(Context *ctx) const;
+
+private:
+    friend class OpenDDLDiff;
+    void add(PatchOperation::Kind kind, const std::vector<size_t> &path, DDLNode *node);
+    OpenDDLPatch(const OpenDDLPatch &) ddl_no_copy;
+    OpenDDLPatch &operator=(const OpenDDLPatch &) ddl_no_copy;
+
+private:
+    std::vector<PatchOperation> m_operations;
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      Computes the structural difference between two node trees.
+///
+/// Child nodes are matched by their type and name, unnamed nodes by their type and their position
+/// between the unnamed siblings of the same type. Matched nodes are compared by their properties,
+/// values, data array lists and references.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT OpenDDLDiff {
+public:
+    ///	@brief  Creates the patch which turns the old tree into the new one.
+    /// @param  oldCtx      [in] The old context.
+    /// @param  newCtx      [in] The new context.
+    /// @param  patch       [out] The patch, will be cleared before.
+    /// @return true in case of success, false if a context has no root node.
+    static bool diff(const Context *oldCtx, const Context *newCtx, OpenDDLPatch &patch);
+
+    ///	@brief  Compares type, name, properties and data of two nodes, the children are ignored.
+    /// @param  lhs         [in] The first node.
+    /// @param  rhs         [in] The second node.
+    /// @return true if the content is equal.
+    static bool isContentEqual(const DDLNode *lhs, const DDLNode *rhs);
+
+private:
+    static void diffNodes(const DDLNode *oldNode, const DDLNode *newNode, std::vector<size_t> &path, OpenDDLPatch &patch);
+    OpenDDLDiff() ddl_no_copy;
+};
+
+END_ODDLPARSER_NS
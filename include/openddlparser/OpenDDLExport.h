@@ -26,16 +26,23 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <openddlparser/OpenDDLStream.h>
 #include <openddlparser/Value.h>
 
+#include <vector>
+
 BEGIN_ODDLPARSER_NS
 
 // Forward declarations
 class IOStreamBase;
 
+struct ExportSegment;
+
 //-------------------------------------------------------------------------------------------------
 ///
 /// @ingroup    OpenDDLParser
 ///	@brief      This class represents the OpenDDLExporter.
 ///
+/// All statements are collected in one reusable output buffer, which is handed over to the stream
+/// in big blocks. Numbers are formatted in place, so the export does not allocate once the buffer
+/// has reached its working size.
 //-------------------------------------------------------------------------------------------------
 class DLL_ODDLPARSER_EXPORT OpenDDLExport {
 public:
@@ -51,6 +58,29 @@ public:
     /// @return True in case of success, false in case of an error.
     bool exportContext(Context *ctx, const std::string &filename);
 
+    ///	@brief  Export the data of a parser context as a binary snapshot ( @see OpenDDLSnapshot ).
+    /// @param  ctx         [in] Pointer to the context.
+    /// @param  filename    [in] The filename for the snapshot.
+    /// @return True in case of success, false in case of an error.
+    bool exportSnapshot(Context *ctx, const std::string &filename);
+
+    ///	@brief  Set the number of worker threads which format subtrees in parallel.
+    /// @param  numThreads  [in] The number of threads, 0 or 1 for a sequential export.
+    /// @remark The output is byte-identical to the sequential export.
+    void setNumThreads(size_t numThreads);
+
+    ///	@brief  Returns the number of worker threads.
+    /// @return The number of worker threads.
+    size_t getNumThreads() const;
+
+    ///	@brief  Set the depth of the subtrees which are formatted as one task.
+    /// @param  depth       [in] 1 for the top-level nodes, 2 for their children and so on.
+    void setParallelDepth(size_t depth);
+
+    ///	@brief  Returns the depth of the subtrees which are formatted as one task.
+    /// @return The depth.
+    size_t getParallelDepth() const;
+
     ///	@brief  Handles a node export.
     /// @param  node        [in] The node to handle with.
     /// @return True in case of success, false in case of an error.
@@ -61,20 +91,35 @@ public:
     /// @return True in case of success, false in case of an error.
     bool writeToStream(const std::string &statement);
 
+    ///	@brief  Hands all buffered statements over to the stream.
+    /// @return True in case of success, false in case of an error.
+    bool flush();
+
+    /// @brief  The number of buffered bytes which triggers a write to the stream.
+    static const size_t FlushThreshold = 1024 * 1024;
+
 protected:
-    bool writeNode(DDLNode *node, std::string &statement);
+    bool writeNode(DDLNode *node, size_t level, std::string &statement);
+    bool writeNodeBegin(DDLNode *node, size_t level, std::string &statement);
+    void writeNodeEnd(size_t level, std::string &statement);
     bool writeNodeHeader(DDLNode *node, std::string &statement);
     bool writeProperties(DDLNode *node, std::string &statement);
     bool writeValueType(Value::ValueType type, size_t numItems, std::string &statement);
     bool writeValue(Value *val, std::string &statement);
     bool writeValueArray(DataArrayList *al, std::string &statement);
+    bool writeReference(const Reference *ref, std::string &statement);
 
 private:
+    bool handleNodeParallel(DDLNode *node);
+    void collectSegments(DDLNode *node, size_t level, std::vector<ExportSegment> &segments);
     OpenDDLExport(const OpenDDLExport &) ddl_no_copy;
     OpenDDLExport &operator=(const OpenDDLExport &) ddl_no_copy;
 
 private:
     IOStreamBase *m_stream;
+    std::string m_buffer;
+    size_t m_numThreads;
+    size_t m_parallelDepth;
 };
 
 END_ODDLPARSER_NS
@@ -0,0 +1,59 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+BEGIN_ODDLPARSER_NS
+
+/// @brief  The buffer size needed by the number formatting functions, including the terminator.
+static const size_t FormatBufferSize = 32;
+
+///	@brief  Writes the decimal representation of a signed integer.
+/// @param  value       [in] The value to format.
+/// @param  buffer      [out] The target buffer, at least FormatBufferSize characters.
+/// @return The number of written characters, without the terminator.
+DLL_ODDLPARSER_EXPORT size_t formatInt64(int64 value, char *buffer);
+
+///	@brief  Writes the decimal representation of an unsigned integer.
+/// @param  value       [in] The value to format.
+/// @param  buffer      [out] The target buffer, at least FormatBufferSize characters.
+/// @return The number of written characters, without the terminator.
+DLL_ODDLPARSER_EXPORT size_t formatUInt64(uint64 value, char *buffer);
+
+///	@brief  Writes the shortest decimal representation which parses back into the same float.
+/// @param  value       [in] The value to format, infinity and NaN are written as hex literal.
+/// @remark The shorter one of the plain and the exponential notation is written, like 0.25 or
+///         1e-45. The output does not depend on the locale.
+/// @param  buffer      [out] The target buffer, at least FormatBufferSize characters.
+/// @return The number of written characters, without the terminator.
+DLL_ODDLPARSER_EXPORT size_t formatFloat(float value, char *buffer);
+
+///	@brief  Writes the shortest decimal representation which parses back into the same double.
+/// @param  value       [in] The value to format, infinity and NaN are written as hex literal.
+/// @remark The notation is chosen like the one of formatFloat.
+/// @param  buffer      [out] The target buffer, at least FormatBufferSize characters.
+/// @return The number of written characters, without the terminator.
+DLL_ODDLPARSER_EXPORT size_t formatDouble(double value, char *buffer);
+
+END_ODDLPARSER_NS
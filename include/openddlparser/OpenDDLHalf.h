@@ -0,0 +1,55 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+BEGIN_ODDLPARSER_NS
+
+///	@brief  Converts the bits of an IEEE 754 half to float, the conversion is exact.
+/// @param  bits        [in] The half.
+/// @return The float value.
+DLL_ODDLPARSER_EXPORT float halfToFloat(uint16 bits);
+
+///	@brief  Converts a float to the bits of an IEEE 754 half, rounded to nearest even.
+/// @param  value       [in] The float value, values beyond the range of half become infinity.
+/// @return The half.
+DLL_ODDLPARSER_EXPORT uint16 floatToHalf(float value);
+
+///	@brief  Converts an array of halfs to floats, with F16C instructions when the CPU has them.
+/// @param  in          [in] The halfs.
+/// @param  out         [out] The floats, at least n items.
+/// @param  n           [in] The number of items.
+DLL_ODDLPARSER_EXPORT void convertHalfToFloat(const uint16 *in, float *out, size_t n);
+
+///	@brief  Converts an array of floats to halfs, with F16C instructions when the CPU has them.
+/// @param  in          [in] The floats.
+/// @param  out         [out] The halfs, at least n items.
+/// @param  n           [in] The number of items.
+DLL_ODDLPARSER_EXPORT void convertFloatToHalf(const float *in, uint16 *out, size_t n);
+
+///	@brief  Returns true, if the array conversions use F16C instructions.
+/// @return true, if the library was built with DDL_WITH_F16C and the CPU supports F16C.
+DLL_ODDLPARSER_EXPORT bool hasHalfConversionInstructions();
+
+END_ODDLPARSER_NS
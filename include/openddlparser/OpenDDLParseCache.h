@@ -0,0 +1,159 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+#include <openddlparser/OpenDDLParser.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+BEGIN_ODDLPARSER_NS
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      This class implements a content-addressed cache for parsed contexts.
+///
+/// Entries are keyed by two independent 64-bit hashes of the input bytes, the input size and the
+/// parse options. A cache hit hands out the shared, already parsed context without any parse work
+/// and without touching the input again; the input is not stored. Entries are evicted in
+/// least-recently-used order as soon as the byte budget is exceeded, every entry is accounted
+/// with the memory held by its context ( @see Context::memoryUsage ). Optionally the cache keeps
+/// a second tier of binary snapshots ( @see OpenDDLSnapshot ) in a local directory, the snapshots
+/// store the input and are only used for the same input.
+/// All methods are thread-safe.
+///
+/// The contexts are shared between all callers and threads which pass the same input. They are
+/// read-only: neither the nodes nor their values, properties or references may be changed, moved
+/// or deleted. Copy the content if it has to be changed.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT OpenDDLParseCache {
+public:
+    /// @brief  The shared parsed context. All users of an entry get the same node tree, so it
+    ///         must not be changed. The context is const, but C++ cannot pass this on to the
+    ///         nodes: the non-const methods of DDLNode must not be called for any of them.
+    using ContextPtr = std::shared_ptr<const Context>;
+
+    /// @brief  The cache counters.
+    struct Statistics {
+        size_t m_hits; ///< Lookups served from memory.
+        size_t m_diskHits; ///< Lookups served from the snapshot directory.
+        size_t m_misses; ///< Lookups which needed a parse.
+        size_t m_evictions; ///< Entries evicted to stay in the byte budget.
+        size_t m_numEntries; ///< The number of entries in memory.
+        size_t m_usedBytes; ///< The memory held by the contexts of the entries.
+    };
+
+    ///	@brief  The class constructor.
+    /// @param  byteBudget  [in] The maximum number of bytes held in memory.
+    /// @param  directory   [in] The directory for the snapshot tier, empty to disable it.
+    explicit OpenDDLParseCache(size_t byteBudget, const std::string &directory = std::string());
+
+    ///	@brief  The class destructor.
+    ~OpenDDLParseCache();
+
+    ///	@brief  Returns the parsed context for a buffer, will parse it in case of a cache miss.
+    /// @param  buffer      [in] The buffer to parse.
+    /// @param  len         [in] The size of the buffer.
+    /// @param  options     [in] Caller-defined parse options, they are part of the cache key.
+    /// @param  callback    [in] The log callback used in case of a parse.
+    /// @return The parsed context or an empty pointer in case of a parse error.
+    /// @remark The context is shared and strictly read-only, see the class description. A change
+    ///         of a node is a data race with all other users and corrupts the entry for them.
+    ContextPtr parse(const char *buffer, size_t len, uint32 options = 0, OpenDDLParser::logCallback callback = nullptr);
+
+    ///	@brief  Returns the cached context for a buffer without parsing it.
+    /// @param  buffer      [in] The buffer.
+    /// @param  len         [in] The size of the buffer.
+    /// @param  options     [in] Caller-defined parse options, they are part of the cache key.
+    /// @return The cached context or an empty pointer.
+    /// @remark The context is shared and strictly read-only, see the class description.
+    ContextPtr find(const char *buffer, size_t len, uint32 options = 0);
+
+    ///	@brief  Sets a new byte budget, entries will be evicted if needed.
+    /// @param  byteBudget  [in] The maximum number of bytes held in memory.
+    void setByteBudget(size_t byteBudget);
+
+    ///	@brief  Returns the byte budget.
+    /// @return The maximum number of bytes held in memory.
+    size_t getByteBudget() const;
+
+    ///	@brief  Removes all entries from memory, the snapshot directory stays untouched.
+    void clear();
+
+    ///	@brief  Returns the cache counters.
+    /// @return The counters.
+    Statistics getStatistics() const;
+
+    ///	@brief  Resets the hit, miss and eviction counters.
+    void resetStatistics();
+
+private:
+    struct Key {
+        uint64 m_hash;
+        uint64 m_check;
+        uint64 m_len;
+        uint32 m_options;
+
+        bool operator==(const Key &rhs) const {
+            return m_hash == rhs.m_hash && m_check == rhs.m_check && m_len == rhs.m_len && m_options == rhs.m_options;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key &key) const {
+            return static_cast<size_t>(key.m_hash ^ (key.m_options * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
+    struct Entry {
+        Key m_key;
+        ContextPtr m_context;
+        size_t m_bytes;
+    };
+
+    using EntryList = std::list<Entry>;
+    using EntryMap = std::unordered_map<Key, EntryList::iterator, KeyHasher>;
+
+    static Key createKey(const char *buffer, size_t len, uint32 options);
+    ContextPtr lookup(const Key &key);
+    void insert(const Key &key, const ContextPtr &ctx, size_t bytes);
+    void evict();
+    std::string getSnapshotName(const Key &key) const;
+
+    OpenDDLParseCache(const OpenDDLParseCache &) ddl_no_copy;
+    OpenDDLParseCache &operator=(const OpenDDLParseCache &) ddl_no_copy;
+
+private:
+    mutable std::mutex m_mutex;
+    size_t m_byteBudget;
+    std::string m_directory;
+    EntryList m_entries;
+    EntryMap m_lookup;
+    Statistics m_stats;
+};
+
+END_ODDLPARSER_NS
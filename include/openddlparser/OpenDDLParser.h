@@ -35,6 +35,7 @@ BEGIN_ODDLPARSER_NS
 
 class DDLNode;
 class Value;
+class IOStreamBase;
 
 struct Identifier;
 struct Reference;
@@ -73,11 +74,76 @@ enum LogSeverity {
     ddl_debug_msg = 0, ///< Debug message, for debugging
     ddl_info_msg, ///< Info messages, normal mode
     ddl_warn_msg, ///< Parser warnings
-    ddl_error_msg ///< Parser errors
+    ddl_error_msg, ///< Parser errors
+    ddl_no_msg ///< Filter level to suppress all messages
 };
 
 DLL_ODDLPARSER_EXPORT const char *getTypeToken(Value::ValueType type);
 
+///	@brief  Defines the kinds of diagnostics reported by the parser.
+enum DiagnosticCode {
+    ddl_unexpected_token = 0, ///< Another token was expected ( @see ParseDiagnostic::m_expected )
+    ddl_invalid_array_size, ///< An array with the size 0
+    ddl_invalid_structure, ///< No node could be created for a structure
+    ddl_invalid_literal, ///< A malformed literal, like a hex literal with too many digits for its type
+    ddl_num_diagnostic_codes
+};
+
+///	@brief  One diagnostic of the parser, the message is only formatted on demand.
+struct ParseDiagnostic {
+    DiagnosticCode m_code; ///< The kind of the diagnostic.
+    LogSeverity m_severity; ///< The severity.
+    size_t m_offset; ///< The offset in the source text.
+    const char *m_expected; ///< The expected token, empty if none, never nullptr.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@class		SourceMap
+///	@ingroup	OpenDDLParser
+///
+///	@brief  Maps offsets in the normalized parse buffer back to offsets in the source text.
+///
+/// The normalization removes comments and line breaks. The map stores one entry for every
+/// position where a removed block ends, so its size is proportional to the number of lines.
+/// It also stores the offsets of the line breaks, so lines and columns can be computed on demand.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT SourceMap {
+public:
+    ///	@brief  The default class constructor.
+    SourceMap();
+
+    ///	@brief  Removes all entries.
+    void clear();
+
+    ///	@brief  Adds a new entry, entries must be added in ascending order.
+    /// @param  normalizedOffset    [in] The offset in the normalized buffer.
+    /// @param  sourceOffset        [in] The corresponding offset in the source text.
+    void addJump(size_t normalizedOffset, size_t sourceOffset);
+
+    ///	@brief  Maps an offset in the normalized buffer to the source text.
+    /// @param  normalizedOffset    [in] The offset in the normalized buffer.
+    /// @return The offset in the source text.
+    size_t toSource(size_t normalizedOffset) const;
+
+    ///	@brief  Adds a line break, line breaks must be added in ascending order.
+    /// @param  sourceOffset        [in] The offset of the line break in the source text.
+    void addLineBreak(size_t sourceOffset);
+
+    ///	@brief  Computes the line and the column of an offset in the source text.
+    /// @param  sourceOffset        [in] The offset in the source text.
+    /// @param  line                [out] The line, starting with 1.
+    /// @param  column              [out] The column, starting with 1.
+    void getLineColumn(size_t sourceOffset, size_t &line, size_t &column) const;
+
+private:
+    struct Jump {
+        size_t m_normalized;
+        size_t m_source;
+    };
+    std::vector<Jump> m_jumps;
+    std::vector<size_t> m_lineBreaks;
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@class		OpenDDLParser
 ///	@ingroup	OpenDDLParser
@@ -92,6 +158,10 @@ public:
     ///	@brief  The log callback function.
     typedef std::function<void (LogSeverity severity, const std::string &msg)> logCallback;
 
+    ///	@brief  The log sink function, receives the preformatted message without a copy.
+    /// @remark msg is not zero-terminated and only valid during the call.
+    typedef void (*logSink)(LogSeverity severity, const char *msg, size_t len, void *userData);
+
 public:
     ///	@brief  The default class constructor.
     OpenDDLParser();
@@ -117,6 +187,41 @@ public:
     /// @return A callback that you can pass to setLogCallback.
     static logCallback StdLogCallback(FILE *destination = nullptr);
 
+    ///	@brief  Setter for a log sink, it takes precedence over the log callback.
+    /// @param  sink        [in] The sink, nullptr to use the log callback again.
+    /// @param  userData    [in] Passed to every call of the sink.
+    void setLogSink(logSink sink, void *userData = nullptr);
+
+    ///	@brief  Getter for the log sink.
+    /// @return The current log sink.
+    logSink getLogSink() const;
+
+    ///	@brief  Sets the lowest severity passed to the log callback, the default is ddl_info_msg.
+    /// @param  severity    [in] The lowest severity.
+    /// @remark Messages below the severity will not be formatted at all. The environment variable
+    ///         OPENDDL_LOG_LEVEL (debug, info, warn, error or none) overrides the default of a new
+    ///         parser and logs to stderr when neither a callback nor a sink is set.
+    void setLogSeverity(LogSeverity severity);
+
+    ///	@brief  Returns the lowest severity passed to the log callback.
+    /// @return The lowest severity.
+    LogSeverity getLogSeverity() const;
+
+    ///	@brief  Returns the diagnostics of the last parse.
+    /// @return The diagnostics, they are collected even without a log callback.
+    const std::vector<ParseDiagnostic> &getDiagnostics() const;
+
+    ///	@brief  Computes the line and the column of an offset in the text of the last parse.
+    /// @param  offset      [in] The offset in the source text, for instance of a diagnostic.
+    /// @param  line        [out] The line, starting with 1.
+    /// @param  column      [out] The column, starting with 1.
+    void getLineColumn(size_t offset, size_t &line, size_t &column) const;
+
+    ///	@brief  Formats the message of a diagnostic of the last parse, including line and column.
+    /// @param  diagnostic  [in] The diagnostic.
+    /// @return The message.
+    std::string formatDiagnostic(const ParseDiagnostic &diagnostic) const;
+
     ///	@brief  Assigns a new buffer to parse.
     ///	@param  buffer      [in] The buffer
     ///	@param  len         [in] Size of the buffer
@@ -126,6 +231,42 @@ public:
     /// @param  buffer      [in] The buffer as a std::vector.
     void setBuffer(const std::vector<char> &buffer);
 
+    ///	@brief  Assigns a new buffer to parse, the content is moved without a copy.
+    /// @param  buffer      [in] The buffer as a std::vector.
+    void setBuffer(std::vector<char> &&buffer);
+
+    ///	@brief  Enables the collection of the parse statistics, they are disabled by default.
+    /// @param  enabled     [in] true to collect the statistics.
+    /// @remark Disabled statistics cost one check per allocation.
+    void setParseStatsEnabled(bool enabled);
+
+    ///	@brief  Returns true, if the parse statistics will be collected.
+    /// @return true, if enabled.
+    bool isParseStatsEnabled() const;
+
+    ///	@brief  Returns the statistics of the last parse, empty if they were disabled.
+    /// @remark An incremental re-parse resets them ( @see reparse ).
+    /// @return The statistics.
+    const ParseStats &getParseStats() const;
+
+    ///	@brief  Enables the phase timers, they are disabled by default.
+    /// @param  enabled     [in] true to measure the phases.
+    /// @remark The timers are only available when built with DDL_PHASE_TIMERS ( @see hasParseTimers ).
+    ///         The timings of every parse will be sent to the log callback as an info message.
+    void setParseTimingsEnabled(bool enabled);
+
+    ///	@brief  Returns true, if the phase timers are enabled.
+    /// @return true, if enabled.
+    bool isParseTimingsEnabled() const;
+
+    ///	@brief  Returns the timings of the last parse, empty if they were disabled.
+    /// @return The timings.
+    const ParseTimings &getParseTimings() const;
+
+    ///	@brief  Returns true, if the library was built with the phase timers.
+    /// @return true, if the timers are compiled in.
+    static bool hasParseTimers();
+
     ///	@brief  Returns the buffer pointer.
     /// @return The buffer pointer.
     const char *getBuffer() const;
@@ -144,6 +285,43 @@ public:
     /// @remark In case of errors check log.
     bool parse();
 
+    ///	@brief  Parses a file, regular files are memory-mapped and parsed without an extra copy.
+    /// @param  filename    [in] The name of the file.
+    /// @return True in case of success, false in case of an error.
+    /// @remark Inputs which cannot be mapped, like pipes, are read in blocks. Files compressed with
+    ///         gzip or zlib are decompressed block by block ( @see CompressedInputStream ).
+    bool parseFile(const std::string &filename);
+
+    ///	@brief  Parses everything which can be read from a stream.
+    /// @param  stream      [in] The stream to read from, it has to be open.
+    /// @return True in case of success, false in case of an error.
+    /// @remark The stream is read in blocks, which are normalized one by one.
+    bool parseStream(IOStreamBase &stream);
+
+    ///	@brief  Loads a binary snapshot instead of parsing a text buffer ( @see OpenDDLSnapshot ).
+    /// @param  filename    [in] The name of the snapshot file.
+    /// @return True in case of success, false in case of an error.
+    /// @remark The current buffer and context will be cleared.
+    bool loadSnapshot(const std::string &filename);
+
+    ///	@brief  Re-parses only the structures touched by an edit of the previously parsed text.
+    ///
+    /// The smallest structure enclosing the edit will be parsed again and spliced into the
+    /// active context, all other nodes keep their identity. Every node stores its range in the
+    /// source text ( @see DDLNode::getSourceBegin ), the ranges will be updated. If no
+    /// enclosing structure can be re-parsed, the whole buffer will be parsed again.
+    /// @param  buffer      [in] The complete edited text.
+    /// @param  len         [in] The size of the edited text.
+    /// @param  editOffset  [in] The offset of the first changed byte.
+    /// @param  removedLen  [in] The number of bytes removed at the offset from the previous text.
+    /// @param  insertedLen [in] The number of bytes inserted at the offset in the edited text.
+    /// @return True in case of success, false in case of an error.
+    /// @remark The parse buffer ( @see getBuffer ) and the source map are updated to the edited
+    ///         text in both cases, so getLineColumn refers to it. After an incremental re-parse
+    ///         the diagnostics are empty and the parse statistics are reset, they only describe
+    ///         a full parse.
+    bool reparse(const char *buffer, size_t len, size_t editOffset, size_t removedLen, size_t insertedLen);
+
     
     bool exportContext(Context *ctx, const std::string &filename);
 
@@ -155,6 +333,10 @@ public:
     /// @return Pointer to the active context or ddl_nullptr.
     Context *getContext() const;
 
+    ///	@brief  Hands the parser context over to the caller.
+    /// @return Pointer to the context or nullptr, the caller is responsible for deleting it.
+    Context *detachContext();
+
 public: // parser helpers
     char *parseNextNode(char *current, char *end);
     char *parseHeader(char *in, char *end);
@@ -164,6 +346,8 @@ public: // parser helpers
     DDLNode *popNode();
     DDLNode *top();
     static void normalizeBuffer(std::vector<char> &buffer);
+    static void normalizeBuffer(std::vector<char> &buffer, SourceMap *sourceMap);
+    static void normalizeBuffer(const char *buffer, size_t len, std::vector<char> &normalized, SourceMap *sourceMap);
     static char *parseName(char *in, char *end, Name **name);
     static char *parseIdentifier(char *in, char *end, Text **id);
     static char *parsePrimitiveDataType(char *in, char *end, Value::ValueType &type, size_t &len);
@@ -179,19 +363,39 @@ public: // parser helpers
     static const char *getVersion();
 
 private:
+    size_t normalizeStream(IOStreamBase &stream);
+    bool parseNormalized(size_t sourceLen);
+    bool isLogged(LogSeverity severity) const;
+    void logMessage(LogSeverity severity, const char *msg, size_t len) const;
+    void logFormat(LogSeverity severity, const char *format, ...) const;
+    void applyLogEnvironment();
+    OpenDDLParser(const char *buffer, size_t len, LogSeverity severity);
+    void reportDiagnostic(DiagnosticCode code, const char *pos, const char *expected);
     OpenDDLParser(const OpenDDLParser &) ddl_no_copy;
     OpenDDLParser &operator=(const OpenDDLParser &) ddl_no_copy;
 
 private:
     logCallback m_logCallback;
+    logSink m_logSink;
+    void *m_logSinkData;
+    LogSeverity m_logSeverity;
     std::vector<char> m_buffer;
 
     typedef std::vector<DDLNode *> DDLNodeStack;
     DDLNodeStack m_stack;
     Context *m_context;
+    SourceMap m_sourceMap;
+    std::vector<ParseDiagnostic> m_diagnostics;
+    bool m_parseStatsEnabled;
+    ParseStats m_parseStats;
+    bool m_parseTimingsEnabled;
+    ParseTimings m_parseTimings;
 
     ///	@brief  Callback for StdLogCallback(). Not meant to be called directly.
     static void logToStream (FILE *, LogSeverity, const std::string &);
+
+    ///	@brief  Sink for OPENDDL_LOG_LEVEL, writes to stderr.
+    static void logToStderr(LogSeverity severity, const char *msg, size_t len, void *userData);
 };
 
 END_ODDLPARSER_NS
@@ -467,8 +467,8 @@ inline bool isComment(T *in, T *end) {
     if (*in == '/') {
         if (in + 1 != end) {
             if (*(in + 1) == '/') {
-                char *drive((in + 2));
-                if ((isUpperCase<T>(*drive) || isLowerCase<T>(*drive)) && *(drive + 1) == '/') {
+                T *drive((in + 2));
+                if (drive != end && drive + 1 != end && (isUpperCase<T>(*drive) || isLowerCase<T>(*drive)) && *(drive + 1) == '/') {
                     return false;
                 } else {
                     return true;
@@ -0,0 +1,94 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+#include <string>
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      This class implements the binary snapshot format for parsed contexts.
+///
+/// A snapshot stores the node tree of a context in a compact binary layout:
+///  - a header with a magic, the format version, the payload size and a checksum of the payload,
+///  - a symbol table with all node types, names, property keys, reference names and strings,
+///  - a node table in pre-order, every node refers to its parent by index,
+///  - the packed data section with properties, value runs, data array lists and references,
+///  - optionally the source text the context was parsed from.
+/// Values of the same type are stored as contiguous runs. Loading a snapshot skips the lexing and
+/// the number conversion of the text, but the complete node tree is still rebuilt on the heap:
+/// every node, value, property and reference is allocated again, so the load time grows with
+/// the size of the tree.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT OpenDDLSnapshot {
+public:
+    ///	@brief  Serializes the node tree of a context into a snapshot.
+    /// @param  ctx         [in] The context to serialize.
+    /// @param  buffer      [out] Will contain the snapshot.
+    /// @param  source      [in] The source text to store for a later check, nullptr for none.
+    /// @param  sourceLen   [in] The size of the source text.
+    /// @return true in case of success, false in case of an error.
+    static bool write(const Context *ctx, std::vector<char> &buffer, const char *source = nullptr, size_t sourceLen = 0);
+
+    ///	@brief  Serializes the node tree of a context into a snapshot file.
+    /// @param  ctx         [in] The context to serialize.
+    /// @param  filename    [in] The name of the snapshot file, an existing file will be overwritten.
+    /// @param  source      [in] The source text to store for a later check, nullptr for none.
+    /// @param  sourceLen   [in] The size of the source text.
+    /// @return true in case of success, false in case of an error.
+    static bool writeFile(const Context *ctx, const std::string &filename, const char *source = nullptr, size_t sourceLen = 0);
+
+    ///	@brief  Creates a new context from a snapshot in memory.
+    /// @param  buffer      [in] The snapshot.
+    /// @param  len         [in] The size of the snapshot in bytes.
+    /// @param  source      [in] The expected source text, nullptr to skip the check.
+    /// @param  sourceLen   [in] The size of the expected source text.
+    /// @return The new context or nullptr in case of an invalid or corrupted snapshot or a snapshot
+    ///         of another source text.
+    static Context *read(const char *buffer, size_t len, const char *source = nullptr, size_t sourceLen = 0);
+
+    ///	@brief  Creates a new context from a snapshot file, the file will be memory-mapped.
+    /// @param  filename    [in] The name of the snapshot file.
+    /// @param  source      [in] The expected source text, nullptr to skip the check.
+    /// @param  sourceLen   [in] The size of the expected source text.
+    /// @return The new context or nullptr in case of an invalid or corrupted snapshot or a snapshot
+    ///         of another source text.
+    static Context *readFile(const std::string &filename, const char *source = nullptr, size_t sourceLen = 0);
+
+    ///	@brief  Checks if a memory block starts with a snapshot header.
+    /// @param  buffer      [in] The memory block.
+    /// @param  len         [in] The size of the memory block in bytes.
+    /// @return true, if the block starts with a snapshot header.
+    static bool isSnapshot(const char *buffer, size_t len);
+
+private:
+    OpenDDLSnapshot() ddl_no_copy;
+    OpenDDLSnapshot(const OpenDDLSnapshot &) ddl_no_copy;
+    OpenDDLSnapshot &operator=(const OpenDDLSnapshot &) ddl_no_copy;
+};
+
+END_ODDLPARSER_NS
@@ -24,6 +24,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <openddlparser/OpenDDLCommon.h>
 
+#include <functional>
+#include <string>
+
 BEGIN_ODDLPARSER_NS
 
 //-------------------------------------------------------------------------------------------------
@@ -81,9 +84,195 @@ public:
     /// @return The bytes written into the stream.
     virtual size_t write(const std::string &statement);
 
+    /// @brief  Will write a block of characters into the stream.
+    /// @param  data        [in] The characters to write.
+    /// @param  len         [in] The number of characters.
+    /// @return The bytes written into the stream.
+    /// @remark The exporter writes all data by this method. The default implementation writes a
+    ///         block into the file opened by this class without a copy, as long as there is no
+    ///         user-defined formatter. Otherwise it copies the block into a string and forwards it
+    ///         to write( const std::string & ), so streams which only override that method still
+    ///         receive everything. Streams which can take the block without a copy override both
+    ///         methods.
+    virtual size_t write(const char *data, size_t len);
+
 private:
     StreamFormatterBase *m_formatter;
+    bool m_useFormatter;
     FILE *m_file;
 };
 
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    IOStreamBase
+///	@brief      This class implements a stream which collects everything in a growable memory buffer.
+///
+/// The stream is open after the construction, writing into it does not need any system call.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT MemoryStream : public IOStreamBase {
+public:
+    /// @brief  The class constructor.
+    /// @param  target      [in] An external string to write into, nullptr to use the own buffer.
+    explicit MemoryStream(std::string *target = nullptr);
+
+    /// @brief  The class destructor.
+    ~MemoryStream() ddl_override;
+
+    /// @brief  Clears the buffer, the name is ignored.
+    bool open(const std::string &name) ddl_override;
+
+    /// @brief  Marks the stream as closed, the content is kept.
+    bool close() ddl_override;
+
+    /// @brief  Returns true, if the stream is open.
+    bool isOpen() const ddl_override;
+
+    /// @brief  Appends the string to the buffer.
+    size_t write(const std::string &statement) ddl_override;
+
+    /// @brief  Appends a block of characters to the buffer.
+    size_t write(const char *data, size_t len) ddl_override;
+
+    /// @brief  Returns the written content.
+    /// @return The content.
+    const std::string &getString() const;
+
+private:
+    std::string m_data;
+    std::string *m_target;
+    bool m_isOpen;
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    IOStreamBase
+///	@brief      This class implements a stream which hands all written blocks over to a callback.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT CallbackStream : public IOStreamBase {
+public:
+    /// @brief  The write callback, returns the number of consumed characters.
+    typedef std::function<size_t(const char *data, size_t len)> writeCallback;
+
+    /// @brief  The class constructor.
+    /// @param  callback    [in] The callback which receives the written blocks.
+    explicit CallbackStream(writeCallback callback);
+
+    /// @brief  The class destructor.
+    ~CallbackStream() ddl_override;
+
+    /// @brief  Opens the stream again, the name is ignored.
+    bool open(const std::string &name) ddl_override;
+
+    /// @brief  Marks the stream as closed.
+    bool close() ddl_override;
+
+    /// @brief  Returns true, if the stream is open and a callback is set.
+    bool isOpen() const ddl_override;
+
+    /// @brief  Hands the string over to the callback.
+    size_t write(const std::string &statement) ddl_override;
+
+    /// @brief  Hands a block of characters over to the callback.
+    size_t write(const char *data, size_t len) ddl_override;
+
+private:
+    writeCallback m_callback;
+    bool m_isOpen;
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    IOStreamBase
+///	@brief      This class implements a stream which writes into a file descriptor.
+///
+/// Small blocks are collected in an internal buffer, which is written together with the next big
+/// block by one vectored write call.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT FileDescriptorStream : public IOStreamBase {
+public:
+    /// @brief  The size of the internal buffer.
+    static const size_t BufferSize = 256 * 1024;
+
+    /// @brief  The class constructor.
+    /// @param  fd          [in] An already open file descriptor or -1.
+    /// @param  ownsFd      [in] true, if the stream shall close the descriptor.
+    explicit FileDescriptorStream(int fd = -1, bool ownsFd = false);
+
+    /// @brief  The class destructor, will write the pending data.
+    ~FileDescriptorStream() ddl_override;
+
+    /// @brief  Creates or truncates the file and opens it for writing.
+    bool open(const std::string &name) ddl_override;
+
+    /// @brief  Writes the pending data and closes the descriptor, if owned.
+    bool close() ddl_override;
+
+    /// @brief  Returns true, if a valid descriptor is assigned.
+    bool isOpen() const ddl_override;
+
+    /// @brief  Writes the string.
+    size_t write(const std::string &statement) ddl_override;
+
+    /// @brief  Writes a block of characters.
+    size_t write(const char *data, size_t len) ddl_override;
+
+    /// @brief  Writes the pending data.
+    /// @return true in case of success.
+    bool flush();
+
+private:
+    bool writeBlocks(const char *first, size_t firstLen, const char *second, size_t secondLen);
+    FileDescriptorStream(const FileDescriptorStream &) ddl_no_copy;
+    FileDescriptorStream &operator=(const FileDescriptorStream &) ddl_no_copy;
+
+private:
+    int m_fd;
+    bool m_ownsFd;
+    std::string m_pending;
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    IOStreamBase
+///	@brief      This class implements a stream which copies the data into a memory-mapped output file.
+///
+/// The file grows in big steps and is truncated to the written size when the stream gets closed.
+/// The blocks of every step are allocated before they are mapped, so a full disk makes the write
+/// fail instead of raising SIGBUS. On Linux the mapping grows with mremap. On platforms without
+/// memory mapping the data is written with plain write calls.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT MappedFileStream : public IOStreamBase {
+public:
+    /// @brief  The smallest growth step of the file.
+    static const size_t MinGrowSize = 1024 * 1024;
+
+    /// @brief  The class constructor.
+    MappedFileStream();
+
+    /// @brief  The class destructor, will close the file.
+    ~MappedFileStream() ddl_override;
+
+    /// @brief  Creates or truncates the file and opens it for writing.
+    bool open(const std::string &name) ddl_override;
+
+    /// @brief  Unmaps the file and truncates it to the written size.
+    bool close() ddl_override;
+
+    /// @brief  Returns true, if a file is open.
+    bool isOpen() const ddl_override;
+
+    /// @brief  Copies the string into the mapping.
+    size_t write(const std::string &statement) ddl_override;
+
+    /// @brief  Copies a block of characters into the mapping.
+    size_t write(const char *data, size_t len) ddl_override;
+
+private:
+    bool reserve(size_t size);
+    MappedFileStream(const MappedFileStream &) ddl_no_copy;
+    MappedFileStream &operator=(const MappedFileStream &) ddl_no_copy;
+
+private:
+    int m_fd;
+    char *m_mapping;
+    size_t m_capacity;
+    size_t m_size;
+};
+
 END_ODDLPARSER_NS
@@ -0,0 +1,143 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+
+#include <mutex>
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+///	@brief  Defines the events reported by the tracing probes of the parser.
+enum TraceEvent {
+    ddl_trace_structure_begin = 0, ///< A structure header was parsed, the name is the structure type
+    ddl_trace_structure_end, ///< A structure was closed, the size is its number of children
+    ddl_trace_data_list, ///< A data list was decoded, the name is the data type, the size the number of items
+    ddl_trace_error, ///< A syntax error, the name is the expected token
+    ddl_trace_allocation, ///< An object was allocated, the name is the object kind, the size its bytes, no offset
+    ddl_num_trace_events
+};
+
+///	@brief  One event of the parser, passed to the installed tracer.
+struct TraceRecord {
+    TraceEvent m_event; ///< The event.
+    uint64 m_nanoseconds; ///< The time stamp of a steady clock in nanoseconds.
+    size_t m_offset; ///< The offset in the parsed text.
+    size_t m_size; ///< The size, the meaning depends on the event.
+    const char *m_name; ///< The name, only valid during the call of the tracer.
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      The interface for a tracer, which receives the events of all parsers.
+///
+/// The probes are compiled out by default, configure with DDL_TRACING to build them. Once compiled
+/// in, a tracer can be installed at any time. On Linux the probes are also available as USDT probes
+/// of the provider openddlparser, when sys/sdt.h was found, so perf or bpftrace can attach to them.
+/// The tracer will be called from every thread which runs a parser.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT OpenDDLTracer {
+public:
+    ///	@brief  The class destructor.
+    virtual ~OpenDDLTracer();
+
+    ///	@brief  Will be called for every event.
+    /// @param  record      [in] The event.
+    virtual void trace(const TraceRecord &record) = 0;
+
+    ///	@brief  Installs the tracer for all parsers.
+    /// @param  tracer      [in] The tracer, nullptr to uninstall it. The caller keeps the ownership.
+    /// @remark Uninstall the tracer before deleting it, parsers running at the same time may still use it.
+    static void install(OpenDDLTracer *tracer);
+
+    ///	@brief  Returns the installed tracer.
+    /// @return The tracer or nullptr.
+    static OpenDDLTracer *getInstalled();
+
+    ///	@brief  Returns true, if the library was built with the tracing probes.
+    /// @return true, if the probes are compiled in.
+    static bool isAvailable();
+
+    ///	@brief  Returns the name of an event.
+    /// @param  event       [in] The event.
+    /// @return The name, for instance "structure_begin".
+    static const char *getEventName(TraceEvent event);
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      A tracer, which keeps the latest events in a ring buffer.
+///
+/// When the buffer is full the oldest events are overwritten, so it can stay installed in
+/// production and be read when a slow parse was noticed.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT RingBufferTracer : public OpenDDLTracer {
+public:
+    /// @brief  The default number of stored events.
+    static const size_t DefaultCapacity = 4096;
+
+    /// @brief  The maximum length of a stored name, longer names are cut.
+    static const size_t MaxNameLen = 31;
+
+    ///	@brief  One stored event.
+    struct Entry {
+        TraceEvent m_event; ///< The event.
+        uint64 m_nanoseconds; ///< The time stamp of a steady clock in nanoseconds.
+        size_t m_offset; ///< The offset in the parsed text.
+        size_t m_size; ///< The size, the meaning depends on the event.
+        char m_name[MaxNameLen + 1]; ///< The name.
+    };
+
+    ///	@brief  The class constructor.
+    /// @param  capacity    [in] The number of events to keep.
+    explicit RingBufferTracer(size_t capacity = DefaultCapacity);
+
+    ///	@brief  The class destructor.
+    ~RingBufferTracer() ddl_override;
+
+    ///	@brief  Stores the event.
+    void trace(const TraceRecord &record) ddl_override;
+
+    ///	@brief  Returns the stored events.
+    /// @return The events, the oldest one first.
+    std::vector<Entry> getEntries() const;
+
+    ///	@brief  Returns the number of events traced since the last clear, including overwritten ones.
+    /// @return The number of events.
+    size_t getNumTraced() const;
+
+    ///	@brief  Removes all events.
+    void clear();
+
+private:
+    RingBufferTracer(const RingBufferTracer &) ddl_no_copy;
+    RingBufferTracer &operator=(const RingBufferTracer &) ddl_no_copy;
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    size_t m_numTraced;
+};
+
+END_ODDLPARSER_NS
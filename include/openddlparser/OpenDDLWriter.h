@@ -0,0 +1,210 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <openddlparser/OpenDDLCommon.h>
+#include <openddlparser/Value.h>
+
+#include <initializer_list>
+#include <string>
+
+BEGIN_ODDLPARSER_NS
+
+// Forward declarations
+class IOStreamBase;
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      Maps a C++ type to the OpenDDL primitive data type written for it.
+//-------------------------------------------------------------------------------------------------
+template <class T>
+struct WriterTypeTraits;
+
+template <> struct WriterTypeTraits<bool> { static const Value::ValueType Type = Value::ValueType::ddl_bool; };
+template <> struct WriterTypeTraits<int8> { static const Value::ValueType Type = Value::ValueType::ddl_int8; };
+template <> struct WriterTypeTraits<int16> { static const Value::ValueType Type = Value::ValueType::ddl_int16; };
+template <> struct WriterTypeTraits<int32> { static const Value::ValueType Type = Value::ValueType::ddl_int32; };
+template <> struct WriterTypeTraits<int64> { static const Value::ValueType Type = Value::ValueType::ddl_int64; };
+template <> struct WriterTypeTraits<uint8> { static const Value::ValueType Type = Value::ValueType::ddl_unsigned_int8; };
+template <> struct WriterTypeTraits<uint16> { static const Value::ValueType Type = Value::ValueType::ddl_unsigned_int16; };
+template <> struct WriterTypeTraits<uint32> { static const Value::ValueType Type = Value::ValueType::ddl_unsigned_int32; };
+template <> struct WriterTypeTraits<uint64> { static const Value::ValueType Type = Value::ValueType::ddl_unsigned_int64; };
+template <> struct WriterTypeTraits<float> { static const Value::ValueType Type = Value::ValueType::ddl_float; };
+template <> struct WriterTypeTraits<double> { static const Value::ValueType Type = Value::ValueType::ddl_double; };
+template <> struct WriterTypeTraits<const char *> { static const Value::ValueType Type = Value::ValueType::ddl_string; };
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      A property for OpenDDLWriter::beginStructure, the value is formatted on construction.
+//-------------------------------------------------------------------------------------------------
+struct DLL_ODDLPARSER_EXPORT WriterProperty {
+    std::string m_key; ///< The key of the property.
+    std::string m_value; ///< The formatted value literal.
+
+    WriterProperty(const char *key, const char *value);
+    WriterProperty(const char *key, const std::string &value);
+    WriterProperty(const char *key, bool value);
+    WriterProperty(const char *key, int32 value);
+    WriterProperty(const char *key, int64 value);
+    WriterProperty(const char *key, uint32 value);
+    WriterProperty(const char *key, uint64 value);
+    WriterProperty(const char *key, float value);
+    WriterProperty(const char *key, double value);
+
+    ///	@brief  Creates a property with a reference value.
+    /// @param  key         [in] The key.
+    /// @param  name        [in] The referenced name, a global name if it has no $ or % prefix.
+    /// @return The property.
+    static WriterProperty reference(const char *key, const char *name);
+
+private:
+    WriterProperty();
+};
+
+//-------------------------------------------------------------------------------------------------
+/// @ingroup    OpenDDLParser
+///	@brief      This class writes OpenDDL text directly, without building a DDLNode tree.
+///
+/// Structures are opened and closed explicitly, data lists and data arrays are written from
+/// contiguous memory without any per-element objects:
+/// @code
+/// OpenDDLWriter writer(&stream);
+/// writer.beginStructure("VertexArray", nullptr, { WriterProperty("attrib", "position") });
+/// writer.writeDataArray(positions, numVertices * 3, 3);
+/// writer.endStructure();
+/// @endcode
+/// The output uses the same layout as OpenDDLExport. It is collected in a buffer and handed over
+/// to the stream in big blocks, the stream is not owned by the writer.
+//-------------------------------------------------------------------------------------------------
+class DLL_ODDLPARSER_EXPORT OpenDDLWriter {
+public:
+    ///	@brief  The class constructor.
+    /// @param  stream      [in] The stream to write to.
+    explicit OpenDDLWriter(IOStreamBase *stream);
+
+    ///	@brief  The class destructor, will flush the buffered output.
+    ~OpenDDLWriter();
+
+    ///	@brief  Opens a new structure.
+    /// @param  type        [in] The structure type.
+    /// @param  name        [in] The name, nullptr or empty for none. A global name if it has no $ or % prefix.
+    /// @param  props       [in] The properties.
+    /// @param  numProps    [in] The number of properties.
+    /// @return true in case of success.
+    bool beginStructure(const char *type, const char *name = nullptr, const WriterProperty *props = nullptr, size_t numProps = 0);
+
+    ///	@brief  Opens a new structure with a property list.
+    bool beginStructure(const char *type, const char *name, std::initializer_list<WriterProperty> props);
+
+    ///	@brief  Closes the current structure.
+    /// @return false if there is no open structure.
+    bool endStructure();
+
+    ///	@brief  Writes a data list like "float { 1, 2, 3 }".
+    /// @param  data        [in] The items.
+    /// @param  count       [in] The number of items.
+    /// @return true in case of success.
+    template <class T>
+    bool writeDataList(const T *data, size_t count) {
+        if (nullptr == data && 0 != count) {
+            return false;
+        }
+        beginData(WriterTypeTraits<T>::Type, 1);
+        for (size_t i = 0; i < count; ++i) {
+            if (i > 0) {
+                writeSeparator();
+            }
+            writeItem(data[i]);
+        }
+        return endData();
+    }
+
+    ///	@brief  Writes a data array like "float[3] { { 1, 2, 3 }, { 4, 5, 6 } }".
+    /// @param  data        [in] The items of all subarrays.
+    /// @param  count       [in] The number of items, a multiple of the subarray size.
+    /// @param  subarraySize [in] The number of items per subarray, at least 2.
+    /// @return true in case of success, false and no output for an invalid size.
+    /// @remark The parser reads a data array with subarrays of one item like a data list, so these
+    ///         are rejected. Use writeDataList for them.
+    template <class T>
+    bool writeDataArray(const T *data, size_t count, size_t subarraySize) {
+        if ((nullptr == data && 0 != count) || subarraySize < 2 || 0 != count % subarraySize) {
+            return false;
+        }
+        beginData(WriterTypeTraits<T>::Type, subarraySize);
+        for (size_t i = 0; i < count; i += subarraySize) {
+            beginSubarray(0 == i);
+            for (size_t j = 0; j < subarraySize; ++j) {
+                if (j > 0) {
+                    writeSeparator();
+                }
+                writeItem(data[i + j]);
+            }
+            endSubarray();
+        }
+        return endData();
+    }
+
+    ///	@brief  Writes a reference list like "ref { $a, %b }".
+    /// @param  names       [in] The names, global names if they have no $ or % prefix.
+    /// @param  count       [in] The number of names.
+    /// @return true in case of success.
+    bool writeReferences(const char *const *names, size_t count);
+
+    ///	@brief  Hands the buffered output over to the stream.
+    /// @return true in case of success.
+    bool flush();
+
+    ///	@brief  Returns the number of open structures.
+    /// @return The nesting level.
+    size_t getLevel() const;
+
+private:
+    void beginData(Value::ValueType type, size_t subarraySize);
+    bool endData();
+    void beginSubarray(bool first);
+    void endSubarray();
+    void writeSeparator();
+    void writeItem(bool value);
+    void writeItem(int8 value);
+    void writeItem(int16 value);
+    void writeItem(int32 value);
+    void writeItem(int64 value);
+    void writeItem(uint8 value);
+    void writeItem(uint16 value);
+    void writeItem(uint32 value);
+    void writeItem(uint64 value);
+    void writeItem(float value);
+    void writeItem(double value);
+    void writeItem(const char *value);
+    OpenDDLWriter(const OpenDDLWriter &) ddl_no_copy;
+    OpenDDLWriter &operator=(const OpenDDLWriter &) ddl_no_copy;
+
+private:
+    IOStreamBase *m_stream;
+    std::string m_buffer;
+    size_t m_level;
+    bool m_success;
+};
+
+END_ODDLPARSER_NS
@@ -199,6 +199,14 @@ public:
     /// @return The unsigned int64 value.
     uint64 getUnsignedInt64() const;
 
+    ///	@brief  Assigns a float to a half value, it is rounded to the nearest half.
+    /// @param  value       [in] The value.
+    void setHalf( float value );
+
+    ///	@brief  Returns the half value.
+    /// @return The half value converted to float.
+    float getHalf() const;
+
     ///	@brief  Assigns a float to the value.
     /// @param  value       [in] The value.
     void setFloat( float value );
@@ -247,6 +255,17 @@ public:
     /// @return The number of items in the array.
     size_t size() const;
 
+    /// @brief  Copies this value and the following values of the list into an array.
+    /// @param  out     [out] The array to copy into.
+    /// @param  n       [in] The number of items in the array.
+    /// @return The number of copied values.
+    /// @remark T can be any integer type, float or double. The values are converted like a
+    ///         static_cast, half values are converted to float first. Floating-point values
+    ///         saturate at the range of an integer type, NaN becomes 0. The copy ends at the
+    ///         first value that is no bool or number.
+    template<class T>
+    size_t copyTo(T *out, size_t n) const;
+
     ValueType m_type;
     size_t m_size;
     unsigned char *m_data;
@@ -89,6 +89,24 @@ TEST_F(DDLNodeTest, accessNameTest) {
     delete myNode;
 }
 
+TEST_F(DDLNodeTest, moveTypeAndNameTest) {
+    std::string type("Metric");
+    std::string name("distance");
+    DDLNode *myNode = DDLNode::create(std::move(type), std::move(name));
+    EXPECT_EQ("Metric", myNode->getType());
+    EXPECT_EQ("distance", myNode->getName());
+
+    static const char buffer[] = "GeometryNode node1";
+    myNode->setType(buffer, 12);
+    myNode->setName(buffer + 13, 5);
+    EXPECT_EQ("GeometryNode", myNode->getType());
+    EXPECT_EQ("node1", myNode->getName());
+
+    myNode->setName(std::string("node2"));
+    EXPECT_EQ("node2", myNode->getName());
+    delete myNode;
+}
+
 TEST_F(DDLNodeTest, accessParentTest) {
     static const std::string parent = "test";
     static const std::string parentName = "testparent_name";
@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLBatchLoader.h>
+#include <openddlparser/OpenDDLCompression.h>
+
+#include "UnitTestCommon.h"
+
+#include <cstdio>
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLBatchLoaderTest : public testing::Test {
+protected:
+    enum { NumFiles = 40 };
+
+    void SetUp() override {
+        char filename[64], content[256];
+        for (size_t i = 0; i < static_cast<size_t>(NumFiles); ++i) {
+            snprintf(filename, sizeof(filename), "batchLoaderTest%u.ogex", static_cast<unsigned int>(i));
+            snprintf(content, sizeof(content), "// file %u\nMetric $m%u { float { %u.5 } }\nGeometryNode { Name { string { \"n\" } } }",
+                    static_cast<unsigned int>(i), static_cast<unsigned int>(i), static_cast<unsigned int>(i));
+            FILE *file(::fopen(filename, "wb"));
+            ASSERT_NE(nullptr, file);
+            ::fwrite(content, 1, strlen(content), file);
+            ::fclose(file);
+            m_filenames.push_back(filename);
+        }
+    }
+
+    void TearDown() override {
+        for (size_t i = 0; i < m_filenames.size(); ++i) {
+            ::remove(m_filenames[i].c_str());
+        }
+    }
+
+    std::vector<std::string> m_filenames;
+};
+
+TEST_F(OpenDDLBatchLoaderTest, loadTest) {
+    OpenDDLBatchLoader loader;
+    loader.setNumReaders(3);
+    loader.setNumParsers(4);
+    loader.setQueueCapacity(2);
+    EXPECT_EQ(3u, loader.getNumReaders());
+    EXPECT_EQ(4u, loader.getNumParsers());
+    EXPECT_EQ(2u, loader.getQueueCapacity());
+
+    std::vector<OpenDDLBatchLoader::Result> results(loader.load(m_filenames));
+    ASSERT_EQ(static_cast<size_t>(NumFiles), results.size());
+    char name[32];
+    for (size_t i = 0; i < static_cast<size_t>(NumFiles); ++i) {
+        EXPECT_EQ(m_filenames[i], results[i].m_filename);
+        ASSERT_TRUE(results[i].isValid());
+        EXPECT_TRUE(results[i].m_error.empty());
+        const DDLNode::DllNodeList &nodes(results[i].m_context->m_root->getChildNodeList());
+        ASSERT_EQ(2u, nodes.size());
+        snprintf(name, sizeof(name), "m%u", static_cast<unsigned int>(i));
+        EXPECT_EQ(name, nodes[0]->getName());
+        EXPECT_FLOAT_EQ(static_cast<float>(i) + 0.5f, nodes[0]->getValue()->getFloat());
+    }
+
+    const OpenDDLBatchLoader::Statistics &stats(loader.getStatistics());
+    EXPECT_EQ(static_cast<size_t>(NumFiles), stats.m_numFiles);
+    EXPECT_EQ(0u, stats.m_numFailed);
+    EXPECT_LT(0u, stats.m_bytesRead);
+    EXPECT_LE(stats.m_maxQueueDepth, 2u);
+    EXPECT_LT(0.0, stats.getBytesPerSecond());
+}
+
+TEST_F(OpenDDLBatchLoaderTest, errorPerFileTest) {
+    static const char *invalidFile = "batchLoaderInvalid.ogex";
+    FILE *file(::fopen(invalidFile, "wb"));
+    ASSERT_NE(nullptr, file);
+    ::fputs("{ 1 }", file);
+    ::fclose(file);
+
+    std::vector<std::string> filenames(m_filenames.begin(), m_filenames.begin() + 3);
+    filenames.insert(filenames.begin() + 1, "batchLoaderDoesNotExist.ogex");
+    filenames.push_back(invalidFile);
+
+    OpenDDLBatchLoader loader;
+    loader.setNumParsers(1);
+    std::vector<OpenDDLBatchLoader::Result> results(loader.load(filenames));
+    EXPECT_EQ(0, ::remove(invalidFile));
+    ASSERT_EQ(5u, results.size());
+    EXPECT_TRUE(results[0].isValid());
+    EXPECT_FALSE(results[1].isValid());
+    EXPECT_NE(std::string::npos, results[1].m_error.find("batchLoaderDoesNotExist.ogex"));
+    EXPECT_TRUE(results[2].isValid());
+    EXPECT_TRUE(results[3].isValid());
+    EXPECT_FALSE(results[4].isValid());
+    EXPECT_FALSE(results[4].m_error.empty());
+    EXPECT_EQ(2u, loader.getStatistics().m_numFailed);
+
+    EXPECT_TRUE(loader.load(std::vector<std::string>()).empty());
+}
+
+TEST_F(OpenDDLBatchLoaderTest, compressedFileTest) {
+    if (!isCompressionSupported()) {
+        return;
+    }
+
+    static const char *filename = "batchLoaderTest.ogex.gz";
+    static const char Document[] = "Metric { float { 2.5 } }";
+    {
+        CompressedOutputStream stream;
+        ASSERT_TRUE(stream.open(filename));
+        stream.write(Document, strlen(Document));
+    }
+
+    OpenDDLBatchLoader loader;
+    std::vector<OpenDDLBatchLoader::Result> results(loader.load(std::vector<std::string>(1, filename)));
+    EXPECT_EQ(0, ::remove(filename));
+    ASSERT_EQ(1u, results.size());
+    ASSERT_TRUE(results[0].isValid());
+    ASSERT_EQ(1u, results[0].m_context->m_root->getChildNodeList().size());
+    EXPECT_FLOAT_EQ(2.5f, results[0].m_context->m_root->getChildNodeList()[0]->getValue()->getFloat());
+    EXPECT_EQ(strlen(Document), loader.getStatistics().m_bytesRead);
+}
+
+END_ODDLPARSER_NS
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "gtest/gtest.h"
 
 #include <openddlparser/OpenDDLCommon.h>
+#include <openddlparser/OpenDDLParser.h>
 #include <openddlparser/Value.h>
 
 BEGIN_ODDLPARSER_NS
@@ -121,6 +122,34 @@ TEST_F(OpenDDLCommonTest, setTextTest) {
     EXPECT_EQ(0, res);
 }
 
+TEST_F(OpenDDLCommonTest, moveTextTest) {
+    Text text("Hello", 5);
+    const char *buffer(text.m_buffer);
+    Text moved(std::move(text));
+    EXPECT_EQ(buffer, moved.m_buffer);
+    EXPECT_EQ(5U, moved.m_len);
+    EXPECT_EQ(nullptr, text.m_buffer);
+    EXPECT_EQ(0U, text.m_len);
+
+    Text assigned("World", 5);
+    assigned = std::move(moved);
+    EXPECT_EQ(buffer, assigned.m_buffer);
+    EXPECT_EQ(nullptr, moved.m_buffer);
+
+    // the ids of names and properties take over the buffer as well
+    Name name(LocalName, std::move(assigned));
+    ASSERT_NE(nullptr, name.m_id);
+    EXPECT_EQ(buffer, name.m_id->m_buffer);
+    Name movedName(std::move(name));
+    EXPECT_EQ(nullptr, name.m_id);
+    EXPECT_EQ(LocalName, movedName.m_type);
+    EXPECT_EQ(buffer, movedName.m_id->m_buffer);
+
+    Property prop(Text("key", 3));
+    ASSERT_NE(nullptr, prop.m_key);
+    EXPECT_TRUE(*prop.m_key == std::string("key"));
+}
+
 TEST_F(OpenDDLCommonTest, CompareIdentifierTest) {
     Text id1("test", 4), id2("test", 4);
     EXPECT_EQ(id1, id2);
@@ -150,4 +179,59 @@ TEST_F(OpenDDLCommonTest, sizeInBytesReferenceTest) {
     delete ref2;
 }
 
+TEST_F(OpenDDLCommonTest, allocatorOverheadTest) {
+    const size_t alignment(2 * sizeof(void *));
+    for (size_t bytes = 1; bytes < 256; ++bytes) {
+        const size_t chunk(bytes + MemoryUsage::getAllocatorOverhead(bytes));
+        EXPECT_EQ(0U, chunk % alignment);
+        EXPECT_LE(bytes + sizeof(size_t), chunk);
+    }
+}
+
+TEST_F(OpenDDLCommonTest, contextMemoryUsageTest) {
+    Context empty;
+    const MemoryUsage emptyUsage(empty.memoryUsage());
+    EXPECT_EQ(sizeof(Context), emptyUsage.m_nodes);
+    EXPECT_EQ(1U, emptyUsage.m_numAllocations);
+    EXPECT_EQ(sizeof(Context) + MemoryUsage::getAllocatorOverhead(sizeof(Context)), emptyUsage.getTotal());
+
+    const std::string source =
+            "Metric (key = \"distance\") {float {1, 2, 3, 4, 5, 6, 7, 8}}\n"
+            "GeometryNode $node1 { ObjectRef {ref {$a, $b}} Transform { float[2] {{1, 2}, {3, 4}} } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+    const MemoryUsage usage(parser.getContext()->memoryUsage());
+    EXPECT_LE(sizeof(Context) + 5 * sizeof(DDLNode), usage.m_nodes);
+    EXPECT_EQ(sizeof(Property), usage.m_properties);
+    EXPECT_LE(8 * (sizeof(Value) + sizeof(float)), usage.m_values);
+    EXPECT_LE(4 * (sizeof(Value) + sizeof(float)) + sizeof(DataArrayList), usage.m_arrays);
+    EXPECT_LE(sizeof(Reference) + 2 * (sizeof(Name *) + sizeof(Name)), usage.m_references);
+    EXPECT_LT(0U, usage.m_strings);
+    EXPECT_LT(0U, usage.m_overhead);
+    EXPECT_EQ(usage.m_nodes + usage.m_strings + usage.m_values + usage.m_properties + usage.m_references +
+                    usage.m_arrays + usage.m_overhead,
+            usage.getTotal());
+
+    // every value is a separate object, so the parsed document is much bigger than its text
+    EXPECT_LT(source.size() * 5, usage.getTotal());
+}
+
+TEST_F(OpenDDLCommonTest, copyDataArrayListTest) {
+    static const char token[] = "VertexArray { float[3] {{1, 2, 3}, {4, 5, 6}} }";
+    OpenDDLParser parser(token, strlen(token));
+    ASSERT_TRUE(parser.parse());
+    const DDLNode *node(parser.getRoot()->getChildNodeList()[0]);
+    ASSERT_NE(nullptr, node->getDataArrayList());
+
+    float vertices[8] = {};
+    EXPECT_EQ(6U, node->getDataArrayList()->copyTo(vertices, 8));
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_FLOAT_EQ(static_cast<float>(i + 1), vertices[i]);
+    }
+
+    double partial[4] = {};
+    EXPECT_EQ(4U, node->getDataArrayList()->copyTo(partial, 4));
+    EXPECT_DOUBLE_EQ(4.0, partial[3]);
+}
+
 END_ODDLPARSER_NS
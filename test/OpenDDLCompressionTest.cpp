@@ -0,0 +1,239 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLCompression.h>
+#include <openddlparser/OpenDDLExport.h>
+
+#include "UnitTestCommon.h"
+
+#include <cstdio>
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLCompressionTest : public testing::Test {
+protected:
+    static bool writeFile(const char *filename, const std::string &content) {
+        FILE *file(::fopen(filename, "wb"));
+        if (nullptr == file) {
+            return false;
+        }
+        const size_t written(::fwrite(content.c_str(), 1, content.size(), file));
+        ::fclose(file);
+
+        return written == content.size();
+    }
+
+    static std::string compress(const std::string &content, CompressionFormat format) {
+        std::string compressed;
+        MemoryStream target(&compressed);
+        CompressedOutputStream stream(&target, format);
+        EXPECT_EQ(content.size(), stream.write(content.c_str(), content.size()));
+        EXPECT_TRUE(stream.close());
+
+        return compressed;
+    }
+
+    static std::string readAll(IOStreamBase &stream, size_t blockSize) {
+        std::string content, block;
+        while (stream.read(blockSize, block) > 0) {
+            content += block;
+        }
+
+        return content;
+    }
+
+    // a document bigger than one read block, with comments across the block borders
+    static std::string createDocument() {
+        std::string document;
+        char line[128];
+        for (int i = 0; i < 20000; ++i) {
+            snprintf(line, sizeof(line), "Metric $m%d { float { %d.5 } } /* node\n %d */ // comment %d\r\n", i, i, i, i);
+            document += line;
+        }
+
+        return document;
+    }
+};
+
+// returns the data in blocks of one character, to test the carry-over between the blocks
+class SingleCharStream : public IOStreamBase {
+public:
+    explicit SingleCharStream(const std::string &data) :
+            m_data(data), m_pos(0) {
+        // empty
+    }
+
+    size_t read(size_t sizeToRead, std::string &statement) ddl_override {
+        if (0 == sizeToRead || m_pos == m_data.size()) {
+            return 0;
+        }
+        statement.assign(1, m_data[m_pos++]);
+        return 1;
+    }
+
+private:
+    std::string m_data;
+    size_t m_pos;
+};
+
+TEST_F(OpenDDLCompressionTest, detectFormatTest) {
+    EXPECT_FALSE(isCompressedBuffer(nullptr, 0));
+    EXPECT_FALSE(isCompressedBuffer("Metric {}", 9));
+    EXPECT_FALSE(isCompressedBuffer("x {}", 4));
+    EXPECT_TRUE(isCompressedBuffer("\x1f\x8b", 2));
+    EXPECT_TRUE(isCompressedBuffer("\x78\x9c", 2));
+    EXPECT_TRUE(isCompressedBuffer("\x78\xda", 2));
+}
+
+TEST_F(OpenDDLCompressionTest, roundTripTest) {
+    if (!isCompressionSupported()) {
+        return;
+    }
+
+    static const char *filename = "compressionRoundTripTest.gz";
+    const std::string document(createDocument());
+    const CompressionFormat formats[] = { ddl_gzip_format, ddl_zlib_format };
+    for (size_t i = 0; i < 2; ++i) {
+        const std::string compressed(compress(document, formats[i]));
+        EXPECT_TRUE(isCompressedBuffer(compressed.c_str(), compressed.size()));
+        EXPECT_LT(compressed.size(), document.size());
+        ASSERT_TRUE(writeFile(filename, compressed));
+
+        CompressedInputStream stream;
+        ASSERT_TRUE(stream.open(filename));
+        EXPECT_TRUE(document == readAll(stream, 1000));
+        EXPECT_TRUE(stream.isCompressed());
+        EXPECT_FALSE(stream.hasError());
+    }
+
+    // gzip members may be concatenated
+    ASSERT_TRUE(writeFile(filename, compress("Metric ", ddl_gzip_format) + compress("{}", ddl_gzip_format)));
+    CompressedInputStream stream;
+    ASSERT_TRUE(stream.open(filename));
+    EXPECT_EQ("Metric {}", readAll(stream, 3));
+    EXPECT_EQ(0, ::remove(filename));
+}
+
+TEST_F(OpenDDLCompressionTest, plainInputTest) {
+    static const char *filename = "compressionPlainTest.ogex";
+    const std::string document(createDocument());
+    ASSERT_TRUE(writeFile(filename, document));
+
+    CompressedInputStream stream;
+    ASSERT_TRUE(stream.open(filename));
+    EXPECT_TRUE(document == readAll(stream, 100000));
+    EXPECT_FALSE(stream.isCompressed());
+    EXPECT_FALSE(stream.hasError());
+    EXPECT_EQ(0, ::remove(filename));
+
+    EXPECT_FALSE(stream.open("doesNotExist.gz"));
+}
+
+TEST_F(OpenDDLCompressionTest, parseStreamTest) {
+    const std::string document(createDocument().substr(0, 5000) + "Metric { float { 1 } } //");
+    OpenDDLParser expected(document.c_str(), document.size());
+    ASSERT_TRUE(expected.parse());
+
+    SingleCharStream stream(document);
+    OpenDDLParser parser;
+    ASSERT_TRUE(parser.parseStream(stream));
+    EXPECT_EQ(expected.getBufferSize(), parser.getBufferSize());
+    EXPECT_EQ(0, ::memcmp(expected.getBuffer(), parser.getBuffer(), parser.getBufferSize()));
+
+    const DDLNode::DllNodeList &expectedNodes(expected.getRoot()->getChildNodeList());
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(expectedNodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        EXPECT_EQ(expectedNodes[i]->getSourceBegin(), nodes[i]->getSourceBegin());
+        EXPECT_EQ(expectedNodes[i]->getSourceEnd(), nodes[i]->getSourceEnd());
+    }
+}
+
+TEST_F(OpenDDLCompressionTest, parseCompressedFileTest) {
+    if (!isCompressionSupported()) {
+        return;
+    }
+
+    static const char *filename = "compressionParseTest.ogex.gz";
+    const std::string document(createDocument());
+    ASSERT_TRUE(writeFile(filename, compress(document, ddl_gzip_format)));
+
+    OpenDDLParser parser;
+    ASSERT_TRUE(parser.parseFile(filename));
+    EXPECT_EQ(0, ::remove(filename));
+
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(20000u, nodes.size());
+    EXPECT_EQ("m19999", nodes[19999]->getName());
+    ASSERT_NE(nullptr, nodes[19999]->getValue());
+    EXPECT_FLOAT_EQ(19999.5f, nodes[19999]->getValue()->getFloat());
+
+    // the ranges refer to the decompressed text
+    const DDLNode *node(nodes[12345]);
+    EXPECT_EQ("Metric $m12345 { float { 12345.5 } }", document.substr(node->getSourceBegin(), node->getSourceEnd() - node->getSourceBegin()));
+}
+
+TEST_F(OpenDDLCompressionTest, parseCorruptFileTest) {
+    if (!isCompressionSupported()) {
+        return;
+    }
+
+    static const char *filename = "compressionCorruptTest.ogex.gz";
+    const std::string compressed(compress(createDocument(), ddl_gzip_format));
+    ASSERT_TRUE(writeFile(filename, compressed.substr(0, compressed.size() / 2)));
+
+    OpenDDLParser parser;
+    EXPECT_FALSE(parser.parseFile(filename));
+    EXPECT_EQ(nullptr, parser.getContext());
+    EXPECT_EQ(0, ::remove(filename));
+}
+
+TEST_F(OpenDDLCompressionTest, compressedExportTest) {
+    if (!isCompressionSupported()) {
+        return;
+    }
+
+    static const char Document[] =
+            "Metric (key = \"distance\") { float { 1.5 } }\n"
+            "GeometryNode $node1 { Name { string { \"Box001\" } } }";
+    OpenDDLParser parser(Document, strlen(Document));
+    ASSERT_TRUE(parser.parse());
+
+    static const char *filename = "compressionExportTest.ogex.gz";
+    {
+        OpenDDLExport exporter(new CompressedOutputStream());
+        EXPECT_TRUE(exporter.exportContext(parser.getContext(), filename));
+    }
+
+    OpenDDLParser reader;
+    ASSERT_TRUE(reader.parseFile(filename));
+    EXPECT_EQ(0, ::remove(filename));
+    const DDLNode::DllNodeList &nodes(reader.getRoot()->getChildNodeList());
+    ASSERT_EQ(2u, nodes.size());
+    EXPECT_EQ("Metric", nodes[0]->getType());
+    EXPECT_EQ("node1", nodes[1]->getName());
+}
+
+END_ODDLPARSER_NS
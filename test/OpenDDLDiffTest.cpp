@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLDiff.h>
+
+#include "UnitTestCommon.h"
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLDiffTest : public testing::Test {
+protected:
+    Context *parse(const char *buffer) {
+        OpenDDLParser parser(buffer, strlen(buffer));
+        if (!parser.parse()) {
+            return nullptr;
+        }
+        return parser.detachContext();
+    }
+};
+
+static const char OldDocument[] =
+        "Metric (key = \"distance\") { float { 1.0 } }\n"
+        "GeometryNode $node1 { Name { string { \"Box001\" } } float[3] { { 1, 2, 3 } } }\n"
+        "GeometryNode $node2 { Name { string { \"Box002\" } } }\n"
+        "Material $material1 { Color { float[3] { { 1, 0, 0 } } } }";
+
+static const char NewDocument[] =
+        "Metric (key = \"distance\") { float { 1.0 } }\n"
+        "GeometryNode $node1 { Name { string { \"Box001\" } } float[3] { { 1, 2, 4 } } }\n"
+        "Material $material1 { Color { float[3] { { 1, 0, 0 } } } }\n"
+        "LightNode $light1 { Name { string { \"Light\" } } }";
+
+TEST_F(OpenDDLDiffTest, equalDocumentsTest) {
+    Context *lhs(parse(OldDocument));
+    Context *rhs(parse(OldDocument));
+    ASSERT_NE(nullptr, lhs);
+    ASSERT_NE(nullptr, rhs);
+
+    OpenDDLPatch patch;
+    EXPECT_TRUE(OpenDDLDiff::diff(lhs, rhs, patch));
+    EXPECT_TRUE(patch.empty());
+
+    delete lhs;
+    delete rhs;
+}
+
+TEST_F(OpenDDLDiffTest, diffTest) {
+    Context *oldCtx(parse(OldDocument));
+    Context *newCtx(parse(NewDocument));
+    ASSERT_NE(nullptr, oldCtx);
+    ASSERT_NE(nullptr, newCtx);
+
+    OpenDDLPatch patch;
+    ASSERT_TRUE(OpenDDLDiff::diff(oldCtx, newCtx, patch));
+    ASSERT_EQ(3U, patch.size());
+
+    EXPECT_EQ(PatchOperation::Kind::RemoveNode, patch.get(0).m_kind);
+    ASSERT_EQ(1U, patch.get(0).m_path.size());
+    EXPECT_EQ(2U, patch.get(0).m_path[0]);
+
+    EXPECT_EQ(PatchOperation::Kind::InsertNode, patch.get(1).m_kind);
+    ASSERT_EQ(1U, patch.get(1).m_path.size());
+    EXPECT_EQ(3U, patch.get(1).m_path[0]);
+    EXPECT_EQ("LightNode", patch.get(1).m_node->getType());
+
+    EXPECT_EQ(PatchOperation::Kind::UpdateNode, patch.get(2).m_kind);
+    ASSERT_EQ(1U, patch.get(2).m_path.size());
+    EXPECT_EQ(1U, patch.get(2).m_path[0]);
+
+    delete oldCtx;
+    delete newCtx;
+}
+
+TEST_F(OpenDDLDiffTest, applyTest) {
+    Context *oldCtx(parse(OldDocument));
+    Context *newCtx(parse(NewDocument));
+    ASSERT_NE(nullptr, oldCtx);
+    ASSERT_NE(nullptr, newCtx);
+
+    const DDLNode::DllNodeList &children(oldCtx->m_root->getChildNodeList());
+    DDLNode *metric(children[0]), *geometry(children[1]), *material(children[3]);
+
+    OpenDDLPatch patch;
+    ASSERT_TRUE(OpenDDLDiff::diff(oldCtx, newCtx, patch));
+    ASSERT_TRUE(patch.apply(oldCtx));
+
+    // unchanged nodes are kept alive
+    ASSERT_EQ(4U, children.size());
+    EXPECT_EQ(metric, children[0]);
+    EXPECT_EQ(geometry, children[1]);
+    EXPECT_EQ(material, children[2]);
+    EXPECT_EQ("LightNode", children[3]->getType());
+    EXPECT_EQ(oldCtx->m_root, children[3]->getParent());
+
+    OpenDDLPatch check;
+    ASSERT_TRUE(OpenDDLDiff::diff(oldCtx, newCtx, check));
+    EXPECT_TRUE(check.empty());
+
+    delete oldCtx;
+    delete newCtx;
+}
+
+TEST_F(OpenDDLDiffTest, reorderTest) {
+    Context *oldCtx(parse("A { float { 1 } }\nB { float { 2 } }\nC { float { 3 } }"));
+    Context *newCtx(parse("C { float { 3 } }\nA { float { 1 } }\nB { float { 2 } }"));
+    ASSERT_NE(nullptr, oldCtx);
+    ASSERT_NE(nullptr, newCtx);
+
+    OpenDDLPatch patch;
+    ASSERT_TRUE(OpenDDLDiff::diff(oldCtx, newCtx, patch));
+    EXPECT_EQ(2U, patch.size());
+    ASSERT_TRUE(patch.apply(oldCtx));
+
+    OpenDDLPatch check;
+    ASSERT_TRUE(OpenDDLDiff::diff(oldCtx, newCtx, check));
+    EXPECT_TRUE(check.empty());
+
+    delete oldCtx;
+    delete newCtx;
+}
+
+END_ODDLPARSER_NS
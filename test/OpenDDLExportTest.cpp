@@ -24,9 +24,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "UnitTestCommon.h"
 #include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLDiff.h>
 #include <openddlparser/OpenDDLExport.h>
 #include <openddlparser/Value.h>
 
+#include <limits>
+
 BEGIN_ODDLPARSER_NS
 
 class OpenDDLExportMock : public OpenDDLExport {
@@ -61,6 +64,22 @@ public:
     }
 };
 
+static std::vector<char> readFile(const std::string &filename) {
+    std::vector<char> buffer;
+    FILE *file(::fopen(filename.c_str(), "rb"));
+    if (nullptr == file) {
+        return buffer;
+    }
+    char block[4096];
+    size_t readBytes(0);
+    while ((readBytes = ::fread(block, 1, sizeof(block), file)) > 0) {
+        buffer.insert(buffer.end(), block, block + readBytes);
+    }
+    ::fclose(file);
+
+    return buffer;
+}
+
 class OpenDDLExportTest : public testing::Test {
 public:
     DDLNode *m_root;
@@ -309,4 +328,130 @@ TEST_F(OpenDDLExportTest, writeValueArrayTest) {
     delete dataArrayList;
 }
 
+TEST_F(OpenDDLExportTest, roundTripTest) {
+    static const char Document[] =
+            "Metric (key = \"distance\") { float { 1.5 } }\n"
+            "GeometryNode $node1\n"
+            "{\n"
+            "    Name { string { \"Box001\" } }\n"
+            "    ObjectRef { ref { $geometry1 } }\n"
+            "    Transform { float[4] { { 1, 0, 0, 0 }, { 0, 1, 0, 0 } } }\n"
+            "    IndexArray { unsigned_int32 { 0, 1, 4294967295 } }\n"
+            "    Weights { float { 0.123456789, 3.4028235e38, 1e-30 } }\n"
+            "    Scale { double { 0.1, 3.141592653589793, 2.5e-300 } }\n"
+            "    Offsets { int64 { -9223372036854775807, 42 } }\n"
+            "    Ids { unsigned_int64 { 18446744073709551615 } }\n"
+            "    Normals { half { 1.5, -0.000061035156, 65504, 1e-7, 0x7C00, 0xFE00 } }\n"
+            "}\n";
+    OpenDDLParser parser(Document, strlen(Document));
+    ASSERT_TRUE(parser.parse());
+
+    const std::string filename("OpenDDLExportTest.ogex");
+    ::remove(filename.c_str());
+    {
+        OpenDDLExport myExport;
+        EXPECT_TRUE(myExport.exportContext(parser.getContext(), filename));
+    }
+
+    std::vector<char> buffer(readFile(filename));
+    ::remove(filename.c_str());
+    ASSERT_FALSE(buffer.empty());
+
+    OpenDDLParser reader(&buffer[0], buffer.size());
+    ASSERT_TRUE(reader.parse());
+
+    OpenDDLPatch patch;
+    ASSERT_TRUE(OpenDDLDiff::diff(parser.getContext(), reader.getContext(), patch));
+    EXPECT_TRUE(patch.empty());
+}
+
+TEST_F(OpenDDLExportTest, nonFiniteRoundTripTest) {
+    const float floats[] = { std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN() };
+    const double doubles[] = { std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN() };
+
+    Context ctx;
+    ctx.m_root = DDLNode::create("root", "");
+    DDLNode *floatNode(DDLNode::create("Floats", "", ctx.m_root));
+    DDLNode *doubleNode(DDLNode::create("Doubles", "", ctx.m_root));
+    Value *floatValues(nullptr), *doubleValues(nullptr);
+    for (size_t i = 0; i < 3; ++i) {
+        Value *floatValue(ValueAllocator::allocPrimData(Value::ValueType::ddl_float));
+        floatValue->setFloat(floats[i]);
+        floatValue->setNext(floatValues);
+        floatValues = floatValue;
+        Value *doubleValue(ValueAllocator::allocPrimData(Value::ValueType::ddl_double));
+        doubleValue->setDouble(doubles[i]);
+        doubleValue->setNext(doubleValues);
+        doubleValues = doubleValue;
+    }
+    floatNode->setValue(floatValues);
+    doubleNode->setValue(doubleValues);
+
+    const std::string filename("OpenDDLExportNonFiniteTest.ogex");
+    ::remove(filename.c_str());
+    {
+        OpenDDLExport myExport;
+        EXPECT_TRUE(myExport.exportContext(&ctx, filename));
+    }
+    std::vector<char> buffer(readFile(filename));
+    ::remove(filename.c_str());
+    ASSERT_FALSE(buffer.empty());
+
+    OpenDDLParser reader(&buffer[0], buffer.size());
+    ASSERT_TRUE(reader.parse());
+    const DDLNode::DllNodeList &children(reader.getRoot()->getChildNodeList());
+    ASSERT_EQ(2U, children.size());
+
+    // the lists were built in reverse order
+    Value *floatValue(children[0]->getValue());
+    Value *doubleValue(children[1]->getValue());
+    for (size_t i = 3; i > 0; --i) {
+        ASSERT_NE(nullptr, floatValue);
+        ASSERT_NE(nullptr, doubleValue);
+        EXPECT_EQ(Value::ValueType::ddl_float, floatValue->m_type);
+        EXPECT_EQ(Value::ValueType::ddl_double, doubleValue->m_type);
+        EXPECT_EQ(0, ::memcmp(floatValue->m_data, &floats[i - 1], sizeof(float)));
+        EXPECT_EQ(0, ::memcmp(doubleValue->m_data, &doubles[i - 1], sizeof(double)));
+        floatValue = floatValue->getNext();
+        doubleValue = doubleValue->getNext();
+    }
+    EXPECT_EQ(nullptr, floatValue);
+}
+
+TEST_F(OpenDDLExportTest, parallelExportTest) {
+    std::string document;
+    for (size_t i = 0; i < 200; ++i) {
+        document += "GeometryNode $node" + std::to_string(i) + "\n{\n";
+        document += "    Name { string { \"Node\" } }\n";
+        document += "    Mesh { VertexArray { float[3] { { 1.5, 2, 3 }, { 0.25, " + std::to_string(i) + ", 6 } } } }\n";
+        document += "}\n";
+    }
+    OpenDDLParser parser(document.c_str(), document.size());
+    ASSERT_TRUE(parser.parse());
+
+    const std::string sequentialName("OpenDDLExportTest_sequential.ogex"), parallelName("OpenDDLExportTest_parallel.ogex");
+    ::remove(sequentialName.c_str());
+    {
+        OpenDDLExport myExport;
+        EXPECT_TRUE(myExport.exportContext(parser.getContext(), sequentialName));
+    }
+    const std::vector<char> expected(readFile(sequentialName));
+    ::remove(sequentialName.c_str());
+    ASSERT_FALSE(expected.empty());
+
+    for (size_t depth = 1; depth <= 3; ++depth) {
+        ::remove(parallelName.c_str());
+        {
+            OpenDDLExport myExport;
+            myExport.setNumThreads(4);
+            myExport.setParallelDepth(depth);
+            EXPECT_TRUE(myExport.exportContext(parser.getContext(), parallelName));
+        }
+        EXPECT_TRUE(expected == readFile(parallelName));
+        ::remove(parallelName.c_str());
+    }
+}
+
 END_ODDLPARSER_NS
@@ -0,0 +1,169 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/OpenDDLFormat.h>
+
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLFormatTest : public testing::Test {
+protected:
+    // simple deterministic generator, so failures are reproducible
+    uint64 next() {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return m_state;
+    }
+
+    uint64 m_state = 42;
+};
+
+TEST_F(OpenDDLFormatTest, formatIntegerTest) {
+    char buffer[FormatBufferSize];
+    EXPECT_EQ(1U, formatInt64(0, buffer));
+    EXPECT_STREQ("0", buffer);
+    EXPECT_EQ(3U, formatInt64(-42, buffer));
+    EXPECT_STREQ("-42", buffer);
+    formatInt64(std::numeric_limits<int64>::max(), buffer);
+    EXPECT_STREQ("9223372036854775807", buffer);
+    formatInt64(std::numeric_limits<int64>::min(), buffer);
+    EXPECT_STREQ("-9223372036854775808", buffer);
+    formatUInt64(std::numeric_limits<uint64>::max(), buffer);
+    EXPECT_STREQ("18446744073709551615", buffer);
+    formatUInt64(100, buffer);
+    EXPECT_STREQ("100", buffer);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        const int64 value(static_cast<int64>(next()));
+        formatInt64(value, buffer);
+        EXPECT_EQ(value, static_cast<int64>(::strtoll(buffer, nullptr, 10)));
+    }
+}
+
+TEST_F(OpenDDLFormatTest, formatShortestTest) {
+    char buffer[FormatBufferSize];
+    formatFloat(1.1f, buffer);
+    EXPECT_STREQ("1.1", buffer);
+    formatFloat(0.1f, buffer);
+    EXPECT_STREQ("0.1", buffer);
+    formatFloat(100.0f, buffer);
+    EXPECT_STREQ("100", buffer);
+    formatFloat(-0.0f, buffer);
+    EXPECT_STREQ("-0", buffer);
+    formatFloat(16777216.0f * 4.0f, buffer);
+    EXPECT_FLOAT_EQ(16777216.0f * 4.0f, ::strtof(buffer, nullptr));
+    formatDouble(0.1, buffer);
+    EXPECT_STREQ("0.1", buffer);
+    formatDouble(1.0 / 3.0, buffer);
+    EXPECT_STREQ("0.3333333333333333", buffer);
+    formatFloat(std::numeric_limits<float>::infinity(), buffer);
+    EXPECT_STREQ("0x7F800000", buffer);
+}
+
+TEST_F(OpenDDLFormatTest, formatNotationTest) {
+    char buffer[FormatBufferSize];
+    EXPECT_EQ(5U, formatFloat(1e-45f, buffer));
+    EXPECT_STREQ("1e-45", buffer);
+    formatFloat(std::numeric_limits<float>::max(), buffer);
+    EXPECT_STREQ("3.4028235e38", buffer);
+    formatFloat(-0.0025f, buffer);
+    EXPECT_STREQ("-0.0025", buffer);
+    formatFloat(1e-5f, buffer);
+    EXPECT_STREQ("1e-5", buffer);
+    formatFloat(123456.5f, buffer);
+    EXPECT_STREQ("123456.5", buffer);
+    formatFloat(1e10f, buffer);
+    EXPECT_STREQ("1e10", buffer);
+    formatDouble(std::numeric_limits<double>::denorm_min(), buffer);
+    EXPECT_STREQ("5e-324", buffer);
+    formatDouble(std::numeric_limits<double>::max(), buffer);
+    EXPECT_STREQ("1.7976931348623157e308", buffer);
+    formatDouble(9007199254740992.0, buffer);
+    EXPECT_STREQ("9007199254740992", buffer);
+    formatDouble(1e23, buffer);
+    EXPECT_STREQ("1e23", buffer);
+}
+
+TEST_F(OpenDDLFormatTest, floatShortestTest) {
+    // no representation with one digit less parses back into the same float
+    char buffer[FormatBufferSize], shorter[FormatBufferSize];
+    for (size_t i = 0; i < 100000; ++i) {
+        const uint32 bits(static_cast<uint32>(next() >> 32));
+        float value;
+        ::memcpy(&value, &bits, sizeof(float));
+        if (value != value || value - value != 0.0f || value == 0.0f) {
+            continue;
+        }
+        formatFloat(value, buffer);
+        // the significant digits are the ones of the mantissa without leading and trailing zeros
+        std::string digits;
+        for (const char *c = buffer; *c != '\0' && *c != 'e'; ++c) {
+            if (*c >= '0' && *c <= '9') {
+                digits += *c;
+            }
+        }
+        const size_t first(digits.find_first_not_of('0')), last(digits.find_last_not_of('0'));
+        const size_t numDigits(last - first + 1);
+        if (numDigits < 2) {
+            continue;
+        }
+        ::snprintf(shorter, sizeof(shorter), "%.*e", static_cast<int>(numDigits) - 2, static_cast<double>(value));
+        const float parsed(::strtof(shorter, nullptr));
+        ASSERT_NE(0, ::memcmp(&value, &parsed, sizeof(float))) << buffer << " " << shorter;
+    }
+}
+
+TEST_F(OpenDDLFormatTest, floatRoundTripTest) {
+    char buffer[FormatBufferSize];
+    for (size_t i = 0; i < 100000; ++i) {
+        const uint32 bits(static_cast<uint32>(next() >> 32));
+        float value;
+        ::memcpy(&value, &bits, sizeof(float));
+        if (value != value || value - value != 0.0f) {
+            continue;
+        }
+        formatFloat(value, buffer);
+        const float parsed(::strtof(buffer, nullptr));
+        ASSERT_EQ(0, ::memcmp(&value, &parsed, sizeof(float))) << buffer;
+    }
+}
+
+TEST_F(OpenDDLFormatTest, doubleRoundTripTest) {
+    char buffer[FormatBufferSize];
+    for (size_t i = 0; i < 100000; ++i) {
+        const uint64 bits(next());
+        double value;
+        ::memcpy(&value, &bits, sizeof(double));
+        if (value != value || value - value != 0.0) {
+            continue;
+        }
+        formatDouble(value, buffer);
+        const double parsed(::strtod(buffer, nullptr));
+        ASSERT_EQ(0, ::memcmp(&value, &parsed, sizeof(double))) << buffer;
+    }
+}
+
+END_ODDLPARSER_NS
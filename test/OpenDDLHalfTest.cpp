@@ -0,0 +1,126 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/OpenDDLHalf.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLHalfTest : public testing::Test {
+    // empty
+};
+
+static uint32 getBits(float value) {
+    uint32 bits;
+    ::memcpy(&bits, &value, sizeof(float));
+
+    return bits;
+}
+
+TEST_F(OpenDDLHalfTest, halfToFloatTest) {
+    EXPECT_EQ(0.0f, halfToFloat(0x0000));
+    EXPECT_EQ(0x80000000u, getBits(halfToFloat(0x8000)));
+    EXPECT_EQ(1.0f, halfToFloat(0x3c00));
+    EXPECT_EQ(-2.0f, halfToFloat(0xc000));
+    EXPECT_EQ(65504.0f, halfToFloat(0x7bff));
+    EXPECT_EQ(std::ldexp(1.0f, -14), halfToFloat(0x0400));
+    EXPECT_EQ(std::ldexp(1.0f, -24), halfToFloat(0x0001));
+    EXPECT_EQ(std::ldexp(1023.0f, -24), halfToFloat(0x03ff));
+    EXPECT_TRUE(std::isinf(halfToFloat(0x7c00)));
+    EXPECT_TRUE(std::isinf(halfToFloat(0xfc00)));
+    EXPECT_TRUE(std::isnan(halfToFloat(0x7e00)));
+}
+
+TEST_F(OpenDDLHalfTest, floatToHalfTest) {
+    EXPECT_EQ(0x3c00, floatToHalf(1.0f));
+    EXPECT_EQ(0xc000, floatToHalf(-2.0f));
+    EXPECT_EQ(0x7bff, floatToHalf(65504.0f));
+    EXPECT_EQ(0x7bff, floatToHalf(65519.0f));
+    EXPECT_EQ(0x7c00, floatToHalf(65520.0f));
+    EXPECT_EQ(0xfc00, floatToHalf(-1e10f));
+    EXPECT_EQ(0x0001, floatToHalf(std::ldexp(1.0f, -24)));
+    EXPECT_EQ(0x0000, floatToHalf(std::ldexp(1.0f, -25)));
+    EXPECT_EQ(0x0001, floatToHalf(std::ldexp(1.5f, -25)));
+    EXPECT_EQ(0x8000, floatToHalf(-1e-10f));
+
+    // ties round to even
+    EXPECT_EQ(0x3c00, floatToHalf(1.0f + std::ldexp(1.0f, -11)));
+    EXPECT_EQ(0x3c02, floatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)));
+    EXPECT_EQ(0x0002, floatToHalf(std::ldexp(3.0f, -25)));
+
+    EXPECT_EQ(0x7c00, floatToHalf(HUGE_VALF));
+    EXPECT_EQ(0x7e00, floatToHalf(std::nanf("")) & 0x7e00);
+}
+
+TEST_F(OpenDDLHalfTest, roundTripTest) {
+    for (uint32 bits = 0; bits <= 0xffffu; ++bits) {
+        const uint16 half(static_cast<uint16>(bits));
+        const float value(halfToFloat(half));
+        if (std::isnan(value)) {
+            EXPECT_TRUE(std::isnan(halfToFloat(floatToHalf(value))));
+        } else {
+            ASSERT_EQ(half, floatToHalf(value)) << bits;
+        }
+    }
+}
+
+TEST_F(OpenDDLHalfTest, convertArrayTest) {
+    // the array conversions must match the scalar ones, whichever path is used
+    std::vector<uint16> halfs(0x10000);
+    for (size_t i = 0; i < halfs.size(); ++i) {
+        halfs[i] = static_cast<uint16>(i);
+    }
+    std::vector<float> floats(halfs.size());
+    convertHalfToFloat(&halfs[0], &floats[0], halfs.size());
+    for (size_t i = 0; i < halfs.size(); ++i) {
+        const float expected(halfToFloat(halfs[i]));
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(floats[i]));
+        } else {
+            ASSERT_EQ(getBits(expected), getBits(floats[i])) << i;
+        }
+    }
+
+    std::vector<float> values;
+    for (uint32 bits = 0; bits < 0x7f800000u; bits += 0x1357u) {
+        float value;
+        ::memcpy(&value, &bits, sizeof(float));
+        values.push_back(value);
+        values.push_back(-value);
+    }
+    std::vector<uint16> converted(values.size());
+    convertFloatToHalf(&values[0], &converted[0], values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(floatToHalf(values[i]), converted[i]) << values[i];
+    }
+
+    // must not crash
+    convertHalfToFloat(nullptr, &floats[0], 1);
+    convertFloatToHalf(&values[0], nullptr, 1);
+}
+
+END_ODDLPARSER_NS
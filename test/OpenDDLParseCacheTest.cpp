@@ -0,0 +1,154 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLParseCache.h>
+#include <openddlparser/OpenDDLSnapshot.h>
+
+#include "UnitTestCommon.h"
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLParseCacheTest : public testing::Test {
+    // empty
+};
+
+static const char Document1[] = "Metric (key = \"distance\") {float {1}}";
+static const char Document2[] = "Metric (key = \"up\") {string {\"z\"}}";
+static const char Document3[] = "GeometryNode $node1 { Name {string {\"Box001\"}} }";
+
+TEST_F(OpenDDLParseCacheTest, hitAndMissTest) {
+    OpenDDLParseCache cache(1024 * 1024);
+    EXPECT_EQ(nullptr, cache.find(Document1, strlen(Document1)).get());
+
+    OpenDDLParseCache::ContextPtr first(cache.parse(Document1, strlen(Document1)));
+    ASSERT_NE(nullptr, first.get());
+    ASSERT_NE(nullptr, first->m_root);
+    ASSERT_EQ(1U, first->m_root->getChildNodeList().size());
+    EXPECT_EQ("Metric", first->m_root->getChildNodeList()[0]->getType());
+
+    OpenDDLParseCache::ContextPtr second(cache.parse(Document1, strlen(Document1)));
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(first.get(), cache.find(Document1, strlen(Document1)).get());
+
+    // the options are part of the key
+    OpenDDLParseCache::ContextPtr third(cache.parse(Document1, strlen(Document1), 1));
+    EXPECT_NE(first.get(), third.get());
+
+    const OpenDDLParseCache::Statistics stats(cache.getStatistics());
+    EXPECT_EQ(2U, stats.m_hits);
+    EXPECT_EQ(2U, stats.m_misses);
+    EXPECT_EQ(0U, stats.m_evictions);
+    EXPECT_EQ(2U, stats.m_numEntries);
+    // only the contexts are accounted, the input is not stored
+    EXPECT_EQ(first->memoryUsage().getTotal() + third->memoryUsage().getTotal(), stats.m_usedBytes);
+
+    cache.resetStatistics();
+    EXPECT_EQ(0U, cache.getStatistics().m_hits);
+    EXPECT_EQ(2U, cache.getStatistics().m_numEntries);
+}
+
+TEST_F(OpenDDLParseCacheTest, invalidInputTest) {
+    OpenDDLParseCache cache(1024);
+    EXPECT_EQ(nullptr, cache.parse(nullptr, 0).get());
+
+    static const char invalid[] = "{ 1 }";
+    EXPECT_EQ(nullptr, cache.parse(invalid, strlen(invalid)).get());
+    EXPECT_EQ(0U, cache.getStatistics().m_numEntries);
+}
+
+TEST_F(OpenDDLParseCacheTest, lruEvictionTest) {
+    OpenDDLParser parser1(Document1, strlen(Document1)), parser3(Document3, strlen(Document3));
+    ASSERT_TRUE(parser1.parse());
+    ASSERT_TRUE(parser3.parse());
+    const size_t budget(parser1.getContext()->memoryUsage().getTotal() + parser3.getContext()->memoryUsage().getTotal());
+    OpenDDLParseCache cache(budget);
+    OpenDDLParseCache::ContextPtr first(cache.parse(Document1, strlen(Document1)));
+    cache.parse(Document2, strlen(Document2));
+
+    // touch the first document, so the second one is the least recently used entry
+    EXPECT_NE(nullptr, cache.find(Document1, strlen(Document1)).get());
+    cache.parse(Document3, strlen(Document3));
+
+    EXPECT_NE(nullptr, cache.find(Document1, strlen(Document1)).get());
+    EXPECT_EQ(nullptr, cache.find(Document2, strlen(Document2)).get());
+    EXPECT_EQ(1U, cache.getStatistics().m_evictions);
+    EXPECT_LE(cache.getStatistics().m_usedBytes, budget);
+
+    // evicted contexts stay valid as long as they are referenced
+    cache.setByteBudget(0);
+    EXPECT_EQ(0U, cache.getStatistics().m_numEntries);
+    ASSERT_NE(nullptr, first->m_root);
+    EXPECT_EQ(1U, first->m_root->getChildNodeList().size());
+}
+
+TEST_F(OpenDDLParseCacheTest, snapshotTierTest) {
+    OpenDDLParseCache cache(0, ".");
+    OpenDDLParseCache::ContextPtr ctx(cache.parse(Document3, strlen(Document3)));
+    ASSERT_NE(nullptr, ctx.get());
+    EXPECT_EQ(1U, cache.getStatistics().m_misses);
+
+    OpenDDLParseCache otherCache(1024, ".");
+    ctx = otherCache.parse(Document3, strlen(Document3));
+    ASSERT_NE(nullptr, ctx.get());
+    EXPECT_EQ(1U, otherCache.getStatistics().m_diskHits);
+    EXPECT_EQ(0U, otherCache.getStatistics().m_misses);
+    ASSERT_EQ(1U, ctx->m_root->getChildNodeList().size());
+    EXPECT_EQ("node1", ctx->m_root->getChildNodeList()[0]->getName());
+
+    char name[64];
+    snprintf(name, sizeof(name), "./%016llx-%u-0.ddlsnap",
+            static_cast<unsigned long long>(computeHash(Document3, strlen(Document3))),
+            static_cast<unsigned int>(strlen(Document3)));
+    EXPECT_EQ(0, ::remove(name));
+}
+
+TEST_F(OpenDDLParseCacheTest, snapshotOfOtherInputTest) {
+    OpenDDLParser parser(Document3, strlen(Document3));
+    ASSERT_TRUE(parser.parse());
+
+    // a snapshot stored under the name of another input, like in case of a hash collision
+    char name[64];
+    snprintf(name, sizeof(name), "./%016llx-%u-0.ddlsnap",
+            static_cast<unsigned long long>(computeHash(Document1, strlen(Document1))),
+            static_cast<unsigned int>(strlen(Document1)));
+    ASSERT_TRUE(OpenDDLSnapshot::writeFile(parser.getContext(), name, Document3, strlen(Document3)));
+
+    OpenDDLParseCache cache(1024 * 1024, ".");
+    OpenDDLParseCache::ContextPtr ctx(cache.parse(Document1, strlen(Document1)));
+    ASSERT_NE(nullptr, ctx.get());
+    EXPECT_EQ(0U, cache.getStatistics().m_diskHits);
+    EXPECT_EQ(1U, cache.getStatistics().m_misses);
+    ASSERT_EQ(1U, ctx->m_root->getChildNodeList().size());
+    EXPECT_EQ("Metric", ctx->m_root->getChildNodeList()[0]->getType());
+
+    // the miss has replaced the snapshot with the one of the right input
+    OpenDDLParseCache otherCache(1024 * 1024, ".");
+    ctx = otherCache.parse(Document1, strlen(Document1));
+    ASSERT_NE(nullptr, ctx.get());
+    EXPECT_EQ(1U, otherCache.getStatistics().m_diskHits);
+    EXPECT_EQ(0, ::remove(name));
+}
+
+END_ODDLPARSER_NS
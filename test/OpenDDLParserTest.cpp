@@ -22,11 +22,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "gtest/gtest.h"
 
+#include <openddlparser/MemoryMappedFile.h>
 #include <openddlparser/OpenDDLParser.h>
 
 #include "UnitTestCommon.h"
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#ifdef __linux__
+#   include <unistd.h>
+#endif
 
 BEGIN_ODDLPARSER_NS
 
@@ -204,6 +211,17 @@ TEST_F(OpenDDLParserTest, accessBufferTest) {
     delete[] buffer;
 }
 
+TEST_F(OpenDDLParserTest, moveBufferTest) {
+    static const char Token[] = "a { float { 1 } }";
+    std::vector<char> buffer(Token, Token + strlen(Token));
+    const char *data(&buffer[0]);
+    OpenDDLParser myParser;
+    myParser.setBuffer(std::move(buffer));
+    EXPECT_EQ(data, myParser.getBuffer());
+    EXPECT_EQ(strlen(Token), myParser.getBufferSize());
+    EXPECT_TRUE(myParser.parse());
+}
+
 TEST_F(OpenDDLParserTest, clearTest) {
     OpenDDLParser myParser;
     EXPECT_EQ(nullptr, myParser.getRoot());
@@ -227,6 +245,25 @@ TEST_F(OpenDDLParserTest, clearTest) {
     EXPECT_EQ(nullptr, myParser.getRoot());
 }
 
+TEST_F(OpenDDLParserTest, clearAfterFailedParseTest) {
+    OpenDDLParser myParser;
+    myParser.setLogCallback([](LogSeverity, const std::string &) {});
+    char invalid[] = "a { b { float { 1 } }";
+    myParser.setBuffer(invalid, strlen(invalid));
+    myParser.parse();
+
+    // the stack of the failed parse is gone, so the root popped by the structure without a
+    // header does not uncover one of its deleted nodes
+    char valid[] = "c { float { 2 } } { float { 3 } } d { float { 4 } }";
+    myParser.setBuffer(valid, strlen(valid));
+    myParser.parse();
+    DDLNode *root(myParser.getRoot());
+    ASSERT_NE(nullptr, root);
+    ASSERT_EQ(1U, root->getChildNodeList().size());
+    EXPECT_EQ("c", root->getChildNodeList()[0]->getType());
+    EXPECT_EQ(root, root->getChildNodeList()[0]->getParent());
+}
+
 TEST_F(OpenDDLParserTest, normalizeBufferTest) {
     char token[] = {
         "line 1 // comment\n"
@@ -498,6 +535,34 @@ TEST_F(OpenDDLParserTest, parseFloatingLiteralTest) {
     registerValueForDeletion(data);
 }
 
+TEST_F(OpenDDLParserTest, parseNegativeIntegerLiteralTest) {
+    size_t len(0);
+    Value *data(nullptr);
+    char token1[] = "-42", *end1(findEnd(token1, len));
+    char *out = OpenDDLParser::parseIntegerLiteral(token1, end1, &data, Value::ValueType::ddl_int64);
+    EXPECT_NE(out, token1);
+    ASSERT_FALSE(nullptr == data);
+    EXPECT_EQ(-42, data->getInt64());
+    registerValueForDeletion(data);
+
+    data = nullptr;
+    char token2[] = "-42", *end2(findEnd(token2, len));
+    out = OpenDDLParser::parseIntegerLiteral(token2, end2, &data, Value::ValueType::ddl_unsigned_int32);
+    EXPECT_EQ(nullptr, data);
+}
+
+TEST_F(OpenDDLParserTest, parseFloatingLiteralRoundingTest) {
+    size_t len(0);
+    Value *data(nullptr);
+    // just above the midpoint of 1 and the next float, a detour over double rounds down
+    char token[] = "1.00000005960464478", *end(findEnd(token, len));
+    char *out = OpenDDLParser::parseFloatingLiteral(token, end, &data);
+    EXPECT_NE(out, token);
+    ASSERT_FALSE(nullptr == data);
+    EXPECT_EQ(1.00000011920928955f, data->getFloat());
+    registerValueForDeletion(data);
+}
+
 TEST_F(OpenDDLParserTest, parseStringLiteralTest) {
     size_t len1(0);
     Value *data(nullptr);
@@ -582,6 +647,31 @@ TEST_F(OpenDDLParserTest, parsePropertyTest) {
     res = strncmp("angle", (char *)prop->m_value->m_data, prop->m_value->m_size);
     EXPECT_EQ(0, res);
     delete prop;
+
+    // no property and no key left behind without a value
+    char prop3[] = "key = ", *end3(findEnd(prop3, len));
+    in = OpenDDLParser::parseProperty(prop3, end3, &prop);
+    EXPECT_EQ(nullptr, prop);
+    char prop4[] = "key", *end4(findEnd(prop4, len));
+    in = OpenDDLParser::parseProperty(prop4, end4, &prop);
+    EXPECT_EQ(nullptr, prop);
+}
+
+TEST_F(OpenDDLParserTest, parsePropertyListTest) {
+    char token[] = "Metric (key = \"distance\", unit = 2) { float { 1 } }";
+    OpenDDLParser myParser(token, strlen(token));
+    ASSERT_TRUE(myParser.parse());
+
+    DDLNode *root(myParser.getRoot());
+    ASSERT_NE(nullptr, root);
+    ASSERT_EQ(1U, root->getChildNodeList().size());
+    DDLNode *node(root->getChildNodeList()[0]);
+    Property *prop(node->getProperties());
+    ASSERT_NE(nullptr, prop);
+    EXPECT_EQ(0, strncmp("key", prop->m_key->m_buffer, prop->m_key->m_len));
+    ASSERT_NE(nullptr, prop->m_next);
+    EXPECT_EQ(0, strncmp("unit", prop->m_next->m_key->m_buffer, prop->m_next->m_key->m_len));
+    EXPECT_EQ(nullptr, prop->m_next->m_next);
 }
 
 TEST_F(OpenDDLParserTest, parseDataArrayListTest) {
@@ -851,4 +941,538 @@ TEST_F(OpenDDLParserTest, validateTest) {
     EXPECT_TRUE(result);
 }
 
+TEST_F(OpenDDLParserTest, sourceRangeTest) {
+    const std::string source =
+            "// first node\n"
+            "Metric { float { 1.0 } }\n"
+            "GeometryNode $node1 { Name { string { \"a\" } } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(2u, nodes.size());
+    EXPECT_EQ("Metric { float { 1.0 } }", source.substr(nodes[0]->getSourceBegin(), nodes[0]->getSourceEnd() - nodes[0]->getSourceBegin()));
+    EXPECT_EQ("GeometryNode $node1 { Name { string { \"a\" } } }", source.substr(nodes[1]->getSourceBegin(), nodes[1]->getSourceEnd() - nodes[1]->getSourceBegin()));
+
+    const DDLNode *name(nodes[1]->getChildNodeList()[0]);
+    EXPECT_EQ("Name { string { \"a\" } }", source.substr(name->getSourceBegin(), name->getSourceEnd() - name->getSourceBegin()));
+}
+
+TEST_F(OpenDDLParserTest, reparseTest) {
+    std::string source =
+            "Metric { float { 1.0 } }\n"
+            "GeometryNode $node1 { Name { string { \"a\" } } }\n"
+            "Metric { string { \"up\" } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(3u, nodes.size());
+    DDLNode *first(nodes[0]), *geometry(nodes[1]), *last(nodes[2]);
+
+    // change the string inside of the name node
+    const size_t offset(source.find("\"a\""));
+    source.replace(offset, 3, "\"abcd\"");
+    ASSERT_TRUE(parser.reparse(source.c_str(), source.size(), offset, 3, 6));
+
+    ASSERT_EQ(3u, nodes.size());
+    EXPECT_EQ(first, nodes[0]);
+    EXPECT_EQ(geometry, nodes[1]);
+    EXPECT_EQ(last, nodes[2]);
+
+    DDLNode *name(geometry->getChildNodeList()[0]);
+    EXPECT_EQ(geometry, name->getParent());
+    ASSERT_NE(nullptr, name->getValue());
+    EXPECT_EQ(std::string("abcd"), name->getValue()->getString());
+    EXPECT_EQ("Name { string { \"abcd\" } }", source.substr(name->getSourceBegin(), name->getSourceEnd() - name->getSourceBegin()));
+    EXPECT_EQ("Metric { string { \"up\" } }", source.substr(last->getSourceBegin(), last->getSourceEnd() - last->getSourceBegin()));
+    EXPECT_EQ(source.size(), parser.getRoot()->getSourceEnd());
+}
+
+TEST_F(OpenDDLParserTest, reparseFallbackTest) {
+    std::string source =
+            "Metric { float { 1.0 } }\n"
+            "Metric { float { 2.0 } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+
+    // insert a new top-level structure between the existing ones
+    const std::string inserted("Metric { float { 3.0 } }\n");
+    const size_t offset(source.find('\n') + 1);
+    source.insert(offset, inserted);
+    ASSERT_TRUE(parser.reparse(source.c_str(), source.size(), offset, 0, inserted.size()));
+
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(3u, nodes.size());
+    ASSERT_NE(nullptr, nodes[1]->getValue());
+    EXPECT_FLOAT_EQ(3.0f, nodes[1]->getValue()->getFloat());
+}
+
+TEST_F(OpenDDLParserTest, reparseLineColumnTest) {
+    std::string source =
+            "Metric { float { 1.0 } }\n"
+            "Metric { string { \"a\" } }\n"
+            "Metric { float { 2.0 } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    parser.setParseStatsEnabled(true);
+    ASSERT_TRUE(parser.parse());
+
+    // break the string over new lines, the last node moves two lines down
+    const size_t offset(source.find("\"a\""));
+    source.replace(offset, 3, "\"a\"\n\n");
+    ASSERT_TRUE(parser.reparse(source.c_str(), source.size(), offset, 3, 5));
+
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(3u, nodes.size());
+    size_t line(0), column(0);
+    parser.getLineColumn(nodes[2]->getSourceBegin(), line, column);
+    EXPECT_EQ(5u, line);
+    EXPECT_EQ(1u, column);
+    parser.getLineColumn(source.find("2.0"), line, column);
+    EXPECT_EQ(5u, line);
+    EXPECT_EQ(18u, column);
+
+    // the buffer is the normalized edited text, the results of the first run are gone
+    OpenDDLParser fullParser(source.c_str(), source.size());
+    ASSERT_TRUE(fullParser.parse());
+    ASSERT_EQ(fullParser.getBufferSize(), parser.getBufferSize());
+    EXPECT_EQ(0, ::memcmp(fullParser.getBuffer(), parser.getBuffer(), parser.getBufferSize()));
+    EXPECT_TRUE(parser.getDiagnostics().empty());
+    EXPECT_EQ(0u, parser.getParseStats().m_numNodes);
+}
+
+static void expectSameAsFullParse(OpenDDLParser &parser, bool reparsed, const std::string &source) {
+    OpenDDLParser fullParser(source.c_str(), source.size());
+    ASSERT_EQ(fullParser.parse(), reparsed);
+    if (!reparsed) {
+        return;
+    }
+
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    const DDLNode::DllNodeList &fullNodes(fullParser.getRoot()->getChildNodeList());
+    ASSERT_EQ(fullNodes.size(), nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        EXPECT_EQ(fullNodes[i]->getType(), nodes[i]->getType());
+        EXPECT_EQ(fullNodes[i]->getChildNodeList().size(), nodes[i]->getChildNodeList().size());
+        EXPECT_EQ(fullNodes[i]->getSourceBegin(), nodes[i]->getSourceBegin());
+        EXPECT_EQ(fullNodes[i]->getSourceEnd(), nodes[i]->getSourceEnd());
+    }
+}
+
+TEST_F(OpenDDLParserTest, reparseOpenCommentTest) {
+    std::string source =
+            "Metric { float { 1.0 } }\n"
+            "Metric { float { 2.0 } }\n"
+            "// */\n"
+            "Metric { float { 3.0 } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+
+    // the first structure stays complete, but the comment swallows the second one
+    const size_t offset(source.find('\n') - 1);
+    source.insert(offset, "} /*");
+    const bool reparsed(parser.reparse(source.c_str(), source.size(), offset, 0, 4));
+    expectSameAsFullParse(parser, reparsed, source);
+    ASSERT_TRUE(reparsed);
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(2u, nodes.size());
+    ASSERT_NE(nullptr, nodes[1]->getValue());
+    EXPECT_FLOAT_EQ(3.0f, nodes[1]->getValue()->getFloat());
+}
+
+TEST_F(OpenDDLParserTest, reparseOpenStringTest) {
+    std::string source =
+            "Metric { string { \"a\" } }\n"
+            "Metric { string { \"b\" } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+
+    // the new string is not closed inside of the first structure
+    const size_t offset(source.find("\" }") + 1);
+    source.insert(offset, ", \"");
+    const bool reparsed(parser.reparse(source.c_str(), source.size(), offset, 0, 3));
+    expectSameAsFullParse(parser, reparsed, source);
+}
+
+TEST_F(OpenDDLParserTest, reparseReleasesNodesTest) {
+    std::string source =
+            "Metric { float { 1.0 } }\n"
+            "GeometryNode { Name { string { \"a\" } } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+
+    const size_t numNodes(DDLNode::getNumAllocatedNodes());
+    for (int i = 0; i < 8; ++i) {
+        const size_t offset(source.find('"') + 1);
+        source[offset] = static_cast<char>('a' + i);
+        ASSERT_TRUE(parser.reparse(source.c_str(), source.size(), offset, 1, 1));
+        EXPECT_EQ(numNodes, DDLNode::getNumAllocatedNodes());
+    }
+}
+
+#ifndef _WIN32
+TEST_F(OpenDDLParserTest, reparseWithoutLoggingTest) {
+    std::string source = "GeometryNode { Name { string { \"a\" } } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+
+    // the structure parsed again must not pick up the log level of the environment
+    ASSERT_EQ(0, setenv("OPENDDL_LOG_LEVEL", "debug", 1));
+    const size_t offset(source.find('"') + 1);
+    source.replace(offset, 1, "abc");
+    testing::internal::CaptureStderr();
+    const bool reparsed(parser.reparse(source.c_str(), source.size(), offset, 1, 3));
+    const std::string output(testing::internal::GetCapturedStderr());
+    ASSERT_EQ(0, unsetenv("OPENDDL_LOG_LEVEL"));
+
+    ASSERT_TRUE(reparsed);
+    EXPECT_EQ("", output);
+}
+#endif // _WIN32
+
+static bool writeTextFile(const char *filename, const std::string &content) {
+    FILE *file(::fopen(filename, "wb"));
+    if (nullptr == file) {
+        return false;
+    }
+    const size_t written(::fwrite(content.c_str(), 1, content.size(), file));
+    ::fclose(file);
+
+    return written == content.size();
+}
+
+TEST_F(OpenDDLParserTest, parseFileTest) {
+    static const char *filename = "parseFileTest.ogex";
+    const std::string source =
+            "/* header */\n"
+            "Metric { float { 1.0 } } // distance\n"
+            "GeometryNode $node1 { Name { string { \"a\" } } }\n";
+    ASSERT_TRUE(writeTextFile(filename, source));
+
+    OpenDDLParser parser;
+    EXPECT_TRUE(parser.parseFile(filename));
+    EXPECT_EQ(0, ::remove(filename));
+
+    ASSERT_NE(nullptr, parser.getRoot());
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(2u, nodes.size());
+    ASSERT_NE(nullptr, nodes[0]->getValue());
+    EXPECT_FLOAT_EQ(1.0f, nodes[0]->getValue()->getFloat());
+    EXPECT_EQ("node1", nodes[1]->getName());
+    EXPECT_EQ("GeometryNode $node1 { Name { string { \"a\" } } }", source.substr(nodes[1]->getSourceBegin(), nodes[1]->getSourceEnd() - nodes[1]->getSourceBegin()));
+}
+
+TEST_F(OpenDDLParserTest, parseFileInvalidTest) {
+    OpenDDLParser parser;
+    EXPECT_FALSE(parser.parseFile("doesNotExist.ogex"));
+    EXPECT_EQ(nullptr, parser.getContext());
+
+    static const char *filename = "parseFileEmptyTest.ogex";
+    ASSERT_TRUE(writeTextFile(filename, ""));
+    EXPECT_FALSE(parser.parseFile(filename));
+    EXPECT_EQ(0, ::remove(filename));
+}
+
+TEST_F(OpenDDLParserTest, readFileTest) {
+    static const char *filename = "readFileTest.ogex";
+    const std::string source("Metric { float { 1.0 } }");
+    ASSERT_TRUE(writeTextFile(filename, source));
+
+    std::vector<char> buffer;
+    EXPECT_TRUE(MemoryMappedFile::readFile(filename, buffer));
+    EXPECT_EQ(0, ::remove(filename));
+    EXPECT_EQ(source, std::string(buffer.begin(), buffer.end()));
+    EXPECT_FALSE(MemoryMappedFile::readFile("doesNotExist.ogex", buffer));
+
+#ifdef __linux__
+    // pipes cannot be mapped or read with pread
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    ASSERT_EQ(static_cast<ssize_t>(source.size()), ::write(fds[1], source.c_str(), source.size()));
+    ::close(fds[1]);
+    char pipeName[64];
+    snprintf(pipeName, sizeof(pipeName), "/proc/self/fd/%d", fds[0]);
+
+    OpenDDLParser parser;
+    EXPECT_TRUE(parser.parseFile(pipeName));
+    ::close(fds[0]);
+    ASSERT_NE(nullptr, parser.getRoot());
+    ASSERT_EQ(1u, parser.getRoot()->getChildNodeList().size());
+    EXPECT_EQ("Metric", parser.getRoot()->getChildNodeList()[0]->getType());
+#endif
+}
+
+TEST_F(OpenDDLParserTest, parseStatsTest) {
+    const std::string source =
+            "Metric (key = \"distance\") {float {1, 2}}\n"
+            "GeometryNode $node1 { ObjectRef {ref {$a, $b}} Transform { float[2] {{1, 2}, {3, 4}} } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    EXPECT_FALSE(parser.isParseStatsEnabled());
+    ASSERT_TRUE(parser.parse());
+    EXPECT_EQ(0u, parser.getParseStats().getTotalCount());
+    EXPECT_EQ(0u, parser.getParseStats().m_numNodes);
+
+    parser.setBuffer(source.c_str(), source.size());
+    parser.setParseStatsEnabled(true);
+    EXPECT_TRUE(parser.isParseStatsEnabled());
+    ASSERT_TRUE(parser.parse());
+
+    const ParseStats &stats(parser.getParseStats());
+    EXPECT_EQ(source.size(), stats.m_inputBytes);
+    EXPECT_EQ(5u, stats.m_numNodes);
+    EXPECT_EQ(7u, stats.m_numValues);
+    EXPECT_EQ(2u, stats.m_maxDepth);
+    EXPECT_EQ(5u, stats.m_allocations[ddl_node_object].m_count);
+    EXPECT_EQ(7u, stats.m_allocations[ddl_value_object].m_count);
+    EXPECT_EQ(1u, stats.m_allocations[ddl_property_object].m_count);
+    EXPECT_EQ(1u, stats.m_allocations[ddl_reference_object].m_count);
+    // the node name is copied into the node directly, only the references allocate names
+    EXPECT_EQ(2u, stats.m_allocations[ddl_name_object].m_count);
+    EXPECT_LT(0u, stats.m_allocations[ddl_text_object].m_count);
+    EXPECT_LT(0u, stats.m_allocations[ddl_data_array_list_object].m_count);
+    EXPECT_LE(sizeof(Reference) + 2 * sizeof(Name *), stats.m_allocations[ddl_reference_object].m_bytes);
+
+    size_t bytes(0);
+    for (size_t i = 0; i < ddl_num_object_kinds; ++i) {
+        bytes += stats.m_allocations[i].m_bytes;
+    }
+    EXPECT_EQ(bytes, stats.getTotalBytes());
+    EXPECT_STREQ("DDLNode", ParseStats::getKindName(ddl_node_object));
+    EXPECT_STREQ("DataArrayList", ParseStats::getKindName(ddl_data_array_list_object));
+}
+
+TEST_F(OpenDDLParserTest, parseTimingsTest) {
+    const std::string source =
+            "Metric (key = \"distance\") {float {1, 2}}\n"
+            "GeometryNode $node1 { Transform { float[2] {{1, 2}, {3, 4}} } }\n"
+            "GeometryNode $node2 { Name {string {\"Box\"}} }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    EXPECT_FALSE(parser.isParseTimingsEnabled());
+    ASSERT_TRUE(parser.parse());
+    EXPECT_EQ(0.0, parser.getParseTimings().m_totalSeconds);
+    EXPECT_TRUE(parser.getParseTimings().m_structures.empty());
+
+    std::vector<std::string> messages;
+    parser.setLogCallback([&messages](LogSeverity severity, const std::string &msg) {
+        if (ddl_info_msg == severity) {
+            messages.push_back(msg);
+        }
+    });
+    parser.setBuffer(source.c_str(), source.size());
+    parser.setParseTimingsEnabled(true);
+    EXPECT_TRUE(parser.isParseTimingsEnabled());
+    ASSERT_TRUE(parser.parse());
+
+    const ParseTimings &timings(parser.getParseTimings());
+    if (!OpenDDLParser::hasParseTimers()) {
+        EXPECT_TRUE(messages.empty());
+        EXPECT_TRUE(timings.m_structures.empty());
+        EXPECT_EQ(0u, timings.m_phases[ddl_header_phase].m_calls);
+        return;
+    }
+
+    ASSERT_EQ(1u, messages.size());
+    EXPECT_NE(std::string::npos, messages[0].find("GeometryNode"));
+    EXPECT_EQ(1u, timings.m_phases[ddl_normalize_phase].m_calls);
+    EXPECT_EQ(5u, timings.m_phases[ddl_header_phase].m_calls);
+    EXPECT_EQ(5u, timings.m_phases[ddl_node_creation_phase].m_calls);
+    EXPECT_LT(0u, timings.m_phases[ddl_primitive_type_phase].m_calls);
+    EXPECT_LT(0u, timings.m_phases[ddl_numeric_conversion_phase].m_calls);
+    EXPECT_LT(0u, timings.m_phases[ddl_allocation_phase].m_calls);
+    ASSERT_EQ(4u, timings.m_structures.size());
+    EXPECT_EQ(2u, timings.m_structures.find("GeometryNode")->second.m_calls);
+    EXPECT_EQ(1u, timings.m_structures.find("Transform")->second.m_calls);
+
+    double seconds(0.0);
+    for (size_t i = 0; i < ddl_num_parse_phases; ++i) {
+        seconds += timings.m_phases[i].m_seconds;
+    }
+    EXPECT_LE(seconds, timings.m_totalSeconds);
+    EXPECT_STREQ("normalize", ParseTimings::getPhaseName(ddl_normalize_phase));
+    EXPECT_STREQ("allocation", ParseTimings::getPhaseName(ddl_allocation_phase));
+}
+
+TEST_F(OpenDDLParserTest, diagnosticsTest) {
+    static const char token[] =
+            "// leading comment\n"
+            "Metric (key = \"distance\") {float {1}}\n"
+            "/* block\n   comment */ Metric (key = \"up\" {string {\"z\"}}\n";
+    OpenDDLParser parser(token, strlen(token));
+    std::vector<std::string> messages;
+    parser.setLogCallback([&messages](LogSeverity, const std::string &msg) {
+        messages.push_back(msg);
+    });
+
+    // errors below the filter are collected, but never formatted
+    parser.setLogSeverity(ddl_no_msg);
+    EXPECT_EQ(ddl_no_msg, parser.getLogSeverity());
+    parser.parse();
+    EXPECT_TRUE(messages.empty());
+    ASSERT_FALSE(parser.getDiagnostics().empty());
+
+    const ParseDiagnostic &diagnostic(parser.getDiagnostics()[0]);
+    EXPECT_EQ(ddl_unexpected_token, diagnostic.m_code);
+    EXPECT_EQ(ddl_error_msg, diagnostic.m_severity);
+    EXPECT_STREQ(")", diagnostic.m_expected);
+    EXPECT_EQ(std::string(token).find("{string"), diagnostic.m_offset);
+
+    size_t line(0), column(0);
+    parser.getLineColumn(diagnostic.m_offset, line, column);
+    EXPECT_EQ(4u, line);
+    EXPECT_EQ(34u, column);
+    EXPECT_EQ("Invalid token (expected \")\") at line 4, column 34", parser.formatDiagnostic(diagnostic));
+
+    // parsing again replaces the nodes of the first parse
+    const size_t numNodes(DDLNode::getNumAllocatedNodes());
+    parser.setLogSeverity(ddl_error_msg);
+    parser.parse();
+    EXPECT_EQ(numNodes, DDLNode::getNumAllocatedNodes());
+    ASSERT_FALSE(messages.empty());
+    EXPECT_EQ(0u, messages[0].find(parser.formatDiagnostic(diagnostic)));
+
+    parser.clear();
+    EXPECT_TRUE(parser.getDiagnostics().empty());
+}
+
+TEST_F(OpenDDLParserTest, sourceMapLineColumnTest) {
+    SourceMap sourceMap;
+    sourceMap.addLineBreak(3);
+    sourceMap.addLineBreak(4);
+    sourceMap.addLineBreak(10);
+
+    size_t line(0), column(0);
+    sourceMap.getLineColumn(0, line, column);
+    EXPECT_EQ(1u, line);
+    EXPECT_EQ(1u, column);
+    sourceMap.getLineColumn(3, line, column);
+    EXPECT_EQ(1u, line);
+    EXPECT_EQ(4u, column);
+    sourceMap.getLineColumn(4, line, column);
+    EXPECT_EQ(2u, line);
+    EXPECT_EQ(1u, column);
+    sourceMap.getLineColumn(7, line, column);
+    EXPECT_EQ(3u, line);
+    EXPECT_EQ(3u, column);
+    sourceMap.getLineColumn(11, line, column);
+    EXPECT_EQ(4u, line);
+    EXPECT_EQ(1u, column);
+
+    sourceMap.clear();
+    sourceMap.getLineColumn(11, line, column);
+    EXPECT_EQ(1u, line);
+    EXPECT_EQ(12u, column);
+}
+
+struct LogSinkData {
+    std::vector<LogSeverity> m_severities;
+    std::vector<std::string> m_messages;
+};
+
+static void collectLogSink(LogSeverity severity, const char *msg, size_t len, void *userData) {
+    LogSinkData *data(static_cast<LogSinkData *>(userData));
+    data->m_severities.push_back(severity);
+    data->m_messages.push_back(std::string(msg, len));
+}
+
+TEST_F(OpenDDLParserTest, logSinkTest) {
+    static const char token[] = "Metric (key = \"distance\") {float {1, 2}}";
+    OpenDDLParser parser(token, strlen(token));
+    EXPECT_EQ(nullptr, parser.getLogSink());
+    EXPECT_EQ(ddl_info_msg, parser.getLogSeverity());
+
+    // debug messages are dropped by default, the callback is not used while a sink is set
+    size_t numCallbacks(0);
+    parser.setLogCallback([&numCallbacks](LogSeverity, const std::string &) {
+        ++numCallbacks;
+    });
+    LogSinkData data;
+    parser.setLogSink(collectLogSink, &data);
+    EXPECT_TRUE(parser.parse());
+    EXPECT_TRUE(data.m_messages.empty());
+
+    // every parse replaces the nodes of the previous one
+    const size_t numNodes(DDLNode::getNumAllocatedNodes());
+    parser.setLogSeverity(ddl_debug_msg);
+    EXPECT_TRUE(parser.parse());
+    EXPECT_EQ(numNodes, DDLNode::getNumAllocatedNodes());
+    ASSERT_EQ(3u, data.m_messages.size());
+    EXPECT_EQ(ddl_debug_msg, data.m_severities[0]);
+    EXPECT_EQ("Structure \"Metric\" begins at offset 0", data.m_messages[0]);
+    EXPECT_EQ("Data list of 2 values and 0 references", data.m_messages[1]);
+    EXPECT_EQ("Structure \"Metric\" ends with 0 children", data.m_messages[2]);
+    EXPECT_EQ(0u, numCallbacks);
+
+    parser.setLogSink(nullptr);
+    EXPECT_TRUE(parser.parse());
+    EXPECT_EQ(3u, numCallbacks);
+    EXPECT_EQ(numNodes, DDLNode::getNumAllocatedNodes());
+}
+
+TEST_F(OpenDDLParserTest, logEnvironmentTest) {
+#ifndef _WIN32
+    ASSERT_EQ(0, setenv("OPENDDL_LOG_LEVEL", "debug", 1));
+    OpenDDLParser debugParser;
+    ASSERT_EQ(0, setenv("OPENDDL_LOG_LEVEL", "unknown", 1));
+    OpenDDLParser unknownParser;
+    ASSERT_EQ(0, unsetenv("OPENDDL_LOG_LEVEL"));
+
+    EXPECT_EQ(ddl_debug_msg, debugParser.getLogSeverity());
+    EXPECT_NE(nullptr, debugParser.getLogSink());
+    EXPECT_EQ(ddl_info_msg, unknownParser.getLogSeverity());
+    EXPECT_EQ(nullptr, unknownParser.getLogSink());
+
+    debugParser.setLogCallback(OpenDDLParser::StdLogCallback());
+    EXPECT_EQ(nullptr, debugParser.getLogSink());
+    EXPECT_EQ(ddl_debug_msg, debugParser.getLogSeverity());
+#endif // _WIN32
+}
+
+TEST_F(OpenDDLParserTest, parseHalfTest) {
+    static const char token[] = "Normals { half { 1.5, -2, 0.1, 0x7C00 } }";
+    OpenDDLParser parser(token, strlen(token));
+    ASSERT_TRUE(parser.parse());
+    Value *value(parser.getRoot()->getChildNodeList()[0]->getValue());
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(Value::ValueType::ddl_half, value->m_type);
+    EXPECT_EQ(sizeof(uint16), value->m_size);
+    EXPECT_FLOAT_EQ(1.5f, value->getHalf());
+    EXPECT_FLOAT_EQ(1.5f, value->getFloat());
+    EXPECT_DOUBLE_EQ(-2.0, value->getNext()->getDouble());
+
+    float floats[4] = {};
+    ASSERT_EQ(4U, value->copyTo(floats, 4));
+    EXPECT_FLOAT_EQ(0.099975586f, floats[2]);
+    EXPECT_TRUE(std::isinf(floats[3]));
+}
+
+TEST_F(OpenDDLParserTest, parseInvalidHexHalfTest) {
+    static const char *invalid[] = {
+        "Normals { half { 1, 0x3C0G } }",
+        "Normals { half { 0xgp } }",
+        "Normals { half { 0x } }",
+        "Normals { half { 0x13C00 } }",
+        "Normals { half[2] { {1, 2}, {0x3C00, 0x00003C00} } }",
+        "Normals { float { 0x3F8000000 } }"
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        OpenDDLParser parser(invalid[i], strlen(invalid[i]));
+        EXPECT_FALSE(parser.parse()) << invalid[i];
+        ASSERT_EQ(1U, parser.getDiagnostics().size()) << invalid[i];
+        const ParseDiagnostic &diagnostic(parser.getDiagnostics()[0]);
+        EXPECT_EQ(ddl_invalid_literal, diagnostic.m_code);
+        EXPECT_EQ('0', invalid[i][diagnostic.m_offset]);
+        EXPECT_EQ(0u, parser.formatDiagnostic(diagnostic).find("Invalid literal"));
+    }
+
+    static const char valid[] = "Normals { half { 0x3c00, 0xFBFF, 0x1 } }";
+    OpenDDLParser parser(valid, strlen(valid));
+    ASSERT_TRUE(parser.parse());
+    EXPECT_TRUE(parser.getDiagnostics().empty());
+    float floats[3] = {};
+    ASSERT_EQ(3U, parser.getRoot()->getChildNodeList()[0]->getValue()->copyTo(floats, 3));
+    EXPECT_FLOAT_EQ(1.0f, floats[0]);
+    EXPECT_FLOAT_EQ(-65504.0f, floats[1]);
+    EXPECT_FLOAT_EQ(5.9604645e-8f, floats[2]);
+}
+
 END_ODDLPARSER_NS
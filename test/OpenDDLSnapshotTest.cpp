@@ -0,0 +1,240 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLExport.h>
+#include <openddlparser/OpenDDLParser.h>
+#include <openddlparser/OpenDDLSnapshot.h>
+
+#include "UnitTestCommon.h"
+
+#include <algorithm>
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLSnapshotTest : public testing::Test {
+public:
+    static bool compareValues(Value *lhs, Value *rhs) {
+        while (nullptr != lhs && nullptr != rhs) {
+            if (lhs->m_type != rhs->m_type || lhs->m_size != rhs->m_size) {
+                return false;
+            }
+            if (0 != lhs->m_size && 0 != ::memcmp(lhs->m_data, rhs->m_data, lhs->m_size)) {
+                return false;
+            }
+            lhs = lhs->getNext();
+            rhs = rhs->getNext();
+        }
+
+        return lhs == rhs;
+    }
+
+    static bool compareReferences(Reference *lhs, Reference *rhs) {
+        if (nullptr == lhs || nullptr == rhs) {
+            return lhs == rhs;
+        }
+        if (lhs->m_numRefs != rhs->m_numRefs) {
+            return false;
+        }
+        for (size_t i = 0; i < lhs->m_numRefs; ++i) {
+            if (lhs->m_referencedName[i]->m_type != rhs->m_referencedName[i]->m_type ||
+                    !(*lhs->m_referencedName[i]->m_id == *rhs->m_referencedName[i]->m_id)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool compareNodes(DDLNode *lhs, DDLNode *rhs) {
+        if (lhs->getType() != rhs->getType() || lhs->getName() != rhs->getName()) {
+            return false;
+        }
+
+        Property *lhsProp(lhs->getProperties()), *rhsProp(rhs->getProperties());
+        while (nullptr != lhsProp && nullptr != rhsProp) {
+            if (!(*lhsProp->m_key == *rhsProp->m_key) || !compareValues(lhsProp->m_value, rhsProp->m_value) ||
+                    !compareReferences(lhsProp->m_ref, rhsProp->m_ref)) {
+                return false;
+            }
+            lhsProp = lhsProp->m_next;
+            rhsProp = rhsProp->m_next;
+        }
+        if (lhsProp != rhsProp) {
+            return false;
+        }
+
+        if (!compareValues(lhs->getValue(), rhs->getValue()) ||
+                !compareReferences(lhs->getReferences(), rhs->getReferences())) {
+            return false;
+        }
+
+        DataArrayList *lhsArray(lhs->getDataArrayList()), *rhsArray(rhs->getDataArrayList());
+        while (nullptr != lhsArray && nullptr != rhsArray) {
+            if (lhsArray->m_numItems != rhsArray->m_numItems || !compareValues(lhsArray->m_dataList, rhsArray->m_dataList)) {
+                return false;
+            }
+            lhsArray = lhsArray->m_next;
+            rhsArray = rhsArray->m_next;
+        }
+        if (lhsArray != rhsArray) {
+            return false;
+        }
+
+        const DDLNode::DllNodeList &lhsChildren(lhs->getChildNodeList()), &rhsChildren(rhs->getChildNodeList());
+        if (lhsChildren.size() != rhsChildren.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < lhsChildren.size(); ++i) {
+            if (!compareNodes(lhsChildren[i], rhsChildren[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+protected:
+    void SetUp() override {
+        static const char token[] =
+                "Metric (key = \"distance\") {float {1.5}}\n"
+                "GeometryNode $node1 (parent = $node0)\n"
+                "{\n"
+                "    Name {string {\"Box001\"}}\n"
+                "    ObjectRef {ref {$geometry1}}\n"
+                "    Transform\n"
+                "    {\n"
+                "        float[3] {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}\n"
+                "    }\n"
+                "    Indices {unsigned_int16 {1, 2, 3, 4}}\n"
+                "}\n";
+        m_parser.setBuffer(token, strlen(token));
+        ASSERT_TRUE(m_parser.parse());
+    }
+
+    OpenDDLParser m_parser;
+};
+
+TEST_F(OpenDDLSnapshotTest, writeReadRoundtripTest) {
+    std::vector<char> buffer;
+    EXPECT_TRUE(OpenDDLSnapshot::write(m_parser.getContext(), buffer));
+    EXPECT_TRUE(OpenDDLSnapshot::isSnapshot(&buffer[0], buffer.size()));
+
+    Context *ctx(OpenDDLSnapshot::read(&buffer[0], buffer.size()));
+    ASSERT_NE(nullptr, ctx);
+    ASSERT_NE(nullptr, ctx->m_root);
+    EXPECT_TRUE(compareNodes(m_parser.getRoot(), ctx->m_root));
+    delete ctx;
+}
+
+TEST_F(OpenDDLSnapshotTest, writeInvalidContextTest) {
+    std::vector<char> buffer;
+    EXPECT_FALSE(OpenDDLSnapshot::write(nullptr, buffer));
+
+    Context ctx;
+    EXPECT_FALSE(OpenDDLSnapshot::write(&ctx, buffer));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST_F(OpenDDLSnapshotTest, readCorruptedSnapshotTest) {
+    std::vector<char> buffer;
+    ASSERT_TRUE(OpenDDLSnapshot::write(m_parser.getContext(), buffer));
+
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(nullptr, 0));
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(&buffer[0], buffer.size() - 1));
+
+    buffer[buffer.size() / 2] ^= 0x5a;
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(&buffer[0], buffer.size()));
+
+    static const char text[] = "Metric {float {1}}";
+    EXPECT_FALSE(OpenDDLSnapshot::isSnapshot(text, sizeof(text)));
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(text, sizeof(text)));
+}
+
+TEST_F(OpenDDLSnapshotTest, invalidItemCountTest) {
+    std::vector<char> buffer;
+    ASSERT_TRUE(OpenDDLSnapshot::write(m_parser.getContext(), buffer));
+
+    // the record of the first data array list: 3 items, no references, values, no reference list
+    char record[24] = {};
+    const uint64 numItems(3);
+    const uint32 hasValues(1);
+    ::memcpy(record, &numItems, sizeof(uint64));
+    ::memcpy(record + 16, &hasValues, sizeof(uint32));
+    std::vector<char>::iterator it(std::search(buffer.begin(), buffer.end(), record, record + sizeof(record)));
+    ASSERT_NE(buffer.end(), it);
+
+    // a wrong count with a valid checksum must be rejected as well
+    const uint64 wrongItems(4);
+    ::memcpy(&*it, &wrongItems, sizeof(uint64));
+    static const size_t ChecksumOffset = 24, HeaderSize = 80;
+    const uint64 checksum(computeHash(&buffer[HeaderSize], buffer.size() - HeaderSize));
+    ::memcpy(&buffer[ChecksumOffset], &checksum, sizeof(uint64));
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(&buffer[0], buffer.size()));
+
+    ::memcpy(&*it, &numItems, sizeof(uint64));
+    const uint64 validChecksum(computeHash(&buffer[HeaderSize], buffer.size() - HeaderSize));
+    ::memcpy(&buffer[ChecksumOffset], &validChecksum, sizeof(uint64));
+    Context *ctx(OpenDDLSnapshot::read(&buffer[0], buffer.size()));
+    EXPECT_NE(nullptr, ctx);
+    delete ctx;
+}
+
+TEST_F(OpenDDLSnapshotTest, sourceCheckTest) {
+    static const char source[] = "Metric {float {1}}";
+    static const char otherSource[] = "Metric {float {2}}";
+    std::vector<char> buffer;
+    ASSERT_TRUE(OpenDDLSnapshot::write(m_parser.getContext(), buffer, source, strlen(source)));
+
+    Context *ctx(OpenDDLSnapshot::read(&buffer[0], buffer.size(), source, strlen(source)));
+    EXPECT_NE(nullptr, ctx);
+    delete ctx;
+    ctx = OpenDDLSnapshot::read(&buffer[0], buffer.size());
+    EXPECT_NE(nullptr, ctx);
+    delete ctx;
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(&buffer[0], buffer.size(), otherSource, strlen(otherSource)));
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(&buffer[0], buffer.size(), source, strlen(source) - 1));
+
+    // a snapshot without a source never matches one
+    ASSERT_TRUE(OpenDDLSnapshot::write(m_parser.getContext(), buffer));
+    EXPECT_EQ(nullptr, OpenDDLSnapshot::read(&buffer[0], buffer.size(), source, strlen(source)));
+}
+
+TEST_F(OpenDDLSnapshotTest, exportAndLoadSnapshotFileTest) {
+    const std::string filename("OpenDDLSnapshotTest.ddlsnap");
+    OpenDDLExport theExporter;
+    EXPECT_FALSE(theExporter.exportSnapshot(nullptr, filename));
+    ASSERT_TRUE(theExporter.exportSnapshot(m_parser.getContext(), filename));
+
+    OpenDDLParser theParser;
+    ASSERT_TRUE(theParser.loadSnapshot(filename));
+    ASSERT_NE(nullptr, theParser.getRoot());
+    EXPECT_TRUE(compareNodes(m_parser.getRoot(), theParser.getRoot()));
+    ::remove(filename.c_str());
+
+    EXPECT_FALSE(theParser.loadSnapshot(filename));
+    EXPECT_EQ(nullptr, theParser.getContext());
+}
+
+END_ODDLPARSER_NS
@@ -21,15 +21,54 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "gtest/gtest.h"
+#include <openddlparser/OpenDDLExport.h>
 #include <openddlparser/OpenDDLStream.h>
 #include "UnitTestCommon.h"
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
 BEGIN_ODDLPARSER_NS
 
 class OpenDDLStreamTest : public testing::Test {
-    // empty
+protected:
+    static std::string readFile(const std::string &filename) {
+        std::string content;
+        FILE *file(::fopen(filename.c_str(), "rb"));
+        if (nullptr == file) {
+            return content;
+        }
+        char block[4096];
+        size_t readBytes(0);
+        while ((readBytes = ::fread(block, 1, sizeof(block), file)) > 0) {
+            content.append(block, readBytes);
+        }
+        ::fclose(file);
+
+        return content;
+    }
+
+    // writes blocks of changing sizes, small ones as well as ones bigger than the internal buffers
+    static std::string writeBlocks(IOStreamBase &stream) {
+        std::string expected;
+        std::string block;
+        for (size_t i = 0; i < 40; ++i) {
+            const size_t len((i % 4 == 3) ? 300 * 1024 + i : 17 * i + 1);
+            block.assign(len, static_cast<char>('a' + i % 26));
+            EXPECT_EQ(len, stream.write(block.c_str(), block.size()));
+            expected += block;
+        }
+
+        return expected;
+    }
 };
 
+static const char Document[] =
+        "Metric (key = \"distance\") { float { 1.5 } }\n"
+        "GeometryNode $node1 { Name { string { \"Box001\" } } }";
+
 TEST_F(OpenDDLStreamTest, createFormatter_success) {
     bool ok(true);
     try {
@@ -50,4 +89,178 @@ TEST_F( OpenDDLStreamTest, createStream_success ) {
     EXPECT_TRUE( ok );
 }
 
+TEST_F(OpenDDLStreamTest, memoryStreamTest) {
+    std::string text;
+    MemoryStream stream(&text);
+    EXPECT_TRUE(stream.isOpen());
+    EXPECT_EQ(5U, stream.write("hello", 5));
+    EXPECT_EQ(6U, stream.write(std::string(" world")));
+    EXPECT_EQ("hello world", text);
+    EXPECT_EQ(&text, &stream.getString());
+
+    EXPECT_TRUE(stream.open("ignored"));
+    EXPECT_TRUE(text.empty());
+    EXPECT_TRUE(stream.close());
+    EXPECT_EQ(0U, stream.write("hello", 5));
+}
+
+TEST_F(OpenDDLStreamTest, exportToMemoryTest) {
+    OpenDDLParser parser(Document, strlen(Document));
+    ASSERT_TRUE(parser.parse());
+
+    std::string text;
+    OpenDDLExport exporter(new MemoryStream(&text));
+    EXPECT_TRUE(exporter.exportContext(parser.getContext(), ""));
+    EXPECT_EQ(0U, text.find("Metric (key = \"distance\")\n{\n    float { 1.5 }\n}\n"));
+    EXPECT_NE(std::string::npos, text.find("string { \"Box001\" }"));
+}
+
+// a stream written against the old interface, which only knows the string version of write
+class StringOnlyStream : public IOStreamBase {
+public:
+    bool open(const std::string &) ddl_override {
+        return true;
+    }
+
+    bool isOpen() const ddl_override {
+        return true;
+    }
+
+    size_t write(const std::string &statement) ddl_override {
+        m_text += statement;
+        return statement.size();
+    }
+
+    std::string m_text;
+};
+
+TEST_F(OpenDDLStreamTest, stringOnlyStreamTest) {
+    StringOnlyStream stream;
+    IOStreamBase &base(stream);
+    EXPECT_EQ(5U, base.write("hello", 5));
+    EXPECT_EQ("hello", stream.m_text);
+
+    OpenDDLParser parser(Document, strlen(Document));
+    ASSERT_TRUE(parser.parse());
+
+    StringOnlyStream *exportStream(new StringOnlyStream);
+    OpenDDLExport exporter(exportStream);
+    EXPECT_TRUE(exporter.exportContext(parser.getContext(), ""));
+    EXPECT_EQ(0U, exportStream->m_text.find("Metric (key = \"distance\")\n{\n    float { 1.5 }\n}\n"));
+    EXPECT_NE(std::string::npos, exportStream->m_text.find("string { \"Box001\" }"));
+}
+
+class UpperCaseFormatter : public StreamFormatterBase {
+public:
+    std::string format(const std::string &statement) ddl_override {
+        std::string result(statement);
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = static_cast<char>(::toupper(result[i]));
+        }
+        return result;
+    }
+};
+
+TEST_F(OpenDDLStreamTest, fileStreamBlockWriteTest) {
+    const std::string filename("OpenDDLStreamTest_block.txt");
+    ::remove(filename.c_str());
+    {
+        IOStreamBase stream;
+        ASSERT_TRUE(stream.open(filename));
+        EXPECT_EQ(5U, stream.write("hello", 5));
+        EXPECT_TRUE(stream.close());
+    }
+    EXPECT_EQ("hello", readFile(filename));
+
+    // a user-defined formatter still sees the blocks
+    {
+        IOStreamBase stream(new UpperCaseFormatter);
+        ASSERT_TRUE(stream.open(filename));
+        EXPECT_EQ(6U, stream.write(" world", 6));
+        EXPECT_TRUE(stream.close());
+    }
+    EXPECT_EQ("hello WORLD", readFile(filename));
+    ::remove(filename.c_str());
+}
+
+TEST_F(OpenDDLStreamTest, callbackStreamTest) {
+    std::string received;
+    size_t numCalls(0);
+    CallbackStream stream([&](const char *data, size_t len) {
+        received.append(data, len);
+        ++numCalls;
+        return len;
+    });
+    EXPECT_TRUE(stream.isOpen());
+    EXPECT_EQ(3U, stream.write("abc", 3));
+    EXPECT_EQ(3U, stream.write("def", 3));
+    EXPECT_EQ("abcdef", received);
+    EXPECT_EQ(2U, numCalls);
+
+    CallbackStream empty(nullptr);
+    EXPECT_FALSE(empty.isOpen());
+}
+
+TEST_F(OpenDDLStreamTest, fileDescriptorStreamTest) {
+    const std::string filename("OpenDDLStreamTest_fd.txt");
+    std::string expected;
+    {
+        FileDescriptorStream stream;
+        EXPECT_FALSE(stream.isOpen());
+        ASSERT_TRUE(stream.open(filename));
+        expected = writeBlocks(stream);
+        EXPECT_TRUE(stream.close());
+    }
+    EXPECT_TRUE(expected == readFile(filename));
+    ::remove(filename.c_str());
+}
+
+TEST_F(OpenDDLStreamTest, mappedFileStreamTest) {
+    const std::string filename("OpenDDLStreamTest_mapped.txt");
+    std::string expected;
+    {
+        MappedFileStream stream;
+        EXPECT_FALSE(stream.isOpen());
+        ASSERT_TRUE(stream.open(filename));
+        expected = writeBlocks(stream);
+        EXPECT_TRUE(stream.close());
+    }
+    EXPECT_TRUE(expected == readFile(filename));
+    ::remove(filename.c_str());
+}
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+TEST_F(OpenDDLStreamTest, mappedFileStreamFullTest) {
+    // a file size limit stands in for a full disk, the write must fail instead of raising SIGBUS
+    struct rlimit limit;
+    ASSERT_EQ(0, ::getrlimit(RLIMIT_FSIZE, &limit));
+    const struct rlimit oldLimit(limit);
+    limit.rlim_cur = 3 * MappedFileStream::MinGrowSize / 2;
+    void (*oldHandler)(int)(::signal(SIGXFSZ, SIG_IGN));
+    ASSERT_EQ(0, ::setrlimit(RLIMIT_FSIZE, &limit));
+
+    const std::string filename("OpenDDLStreamTest_full.txt");
+    const std::string block(64 * 1024, 'x');
+    size_t written(0);
+    {
+        MappedFileStream stream;
+        ASSERT_TRUE(stream.open(filename));
+        for (size_t i = 0; i < 64; ++i) {
+            const size_t len(stream.write(block.c_str(), block.size()));
+            if (0 == len) {
+                break;
+            }
+            written += len;
+        }
+        EXPECT_TRUE(stream.close());
+    }
+    ::setrlimit(RLIMIT_FSIZE, &oldLimit);
+    ::signal(SIGXFSZ, oldHandler);
+
+    EXPECT_EQ(MappedFileStream::MinGrowSize, written);
+    EXPECT_EQ(written, readFile(filename).size());
+    ::remove(filename.c_str());
+}
+#endif
+
 END_ODDLPARSER_NS
@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/OpenDDLParser.h>
+#include <openddlparser/OpenDDLTrace.h>
+
+#include "UnitTestCommon.h"
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLTraceTest : public testing::Test {
+protected:
+    void TearDown() ddl_override {
+        OpenDDLTracer::install(nullptr);
+    }
+};
+
+static TraceRecord createRecord(TraceEvent event, const char *name, size_t offset) {
+    TraceRecord record;
+    record.m_event = event;
+    record.m_nanoseconds = offset;
+    record.m_offset = offset;
+    record.m_size = 0;
+    record.m_name = name;
+
+    return record;
+}
+
+TEST_F(OpenDDLTraceTest, ringBufferTest) {
+    RingBufferTracer tracer(3);
+    EXPECT_TRUE(tracer.getEntries().empty());
+
+    tracer.trace(createRecord(ddl_trace_structure_begin, "Metric", 1));
+    tracer.trace(createRecord(ddl_trace_structure_end, "Metric", 2));
+    std::vector<RingBufferTracer::Entry> entries(tracer.getEntries());
+    ASSERT_EQ(2U, entries.size());
+    EXPECT_EQ(ddl_trace_structure_begin, entries[0].m_event);
+    EXPECT_STREQ("Metric", entries[0].m_name);
+
+    // the oldest events will be overwritten
+    tracer.trace(createRecord(ddl_trace_error, "}", 3));
+    tracer.trace(createRecord(ddl_trace_error, "a name longer than the limit of the stored names", 4));
+    entries = tracer.getEntries();
+    ASSERT_EQ(3U, entries.size());
+    EXPECT_EQ(2U, entries[0].m_offset);
+    EXPECT_EQ(3U, entries[1].m_offset);
+    EXPECT_EQ(4U, entries[2].m_offset);
+    EXPECT_EQ(static_cast<size_t>(RingBufferTracer::MaxNameLen), strlen(entries[2].m_name));
+    EXPECT_EQ(4U, tracer.getNumTraced());
+
+    tracer.clear();
+    EXPECT_TRUE(tracer.getEntries().empty());
+    EXPECT_STREQ("data_list", OpenDDLTracer::getEventName(ddl_trace_data_list));
+}
+
+TEST_F(OpenDDLTraceTest, parseTraceTest) {
+    RingBufferTracer tracer(1024);
+    OpenDDLTracer::install(&tracer);
+    EXPECT_EQ(&tracer, OpenDDLTracer::getInstalled());
+
+    const std::string source =
+            "// the metric\n"
+            "Metric {float {1, 2}}\n"
+            "GeometryNode { Name { string {\"Box\"} } }";
+    OpenDDLParser parser(source.c_str(), source.size());
+    ASSERT_TRUE(parser.parse());
+    if (!OpenDDLTracer::isAvailable()) {
+        EXPECT_EQ(0U, tracer.getNumTraced());
+        return;
+    }
+
+    size_t numBegins(0), numEnds(0), numLists(0), numAllocations(0);
+    const std::vector<RingBufferTracer::Entry> entries(tracer.getEntries());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const RingBufferTracer::Entry &entry(entries[i]);
+        if (ddl_trace_structure_begin == entry.m_event) {
+            ++numBegins;
+            if (0 == strcmp("GeometryNode", entry.m_name)) {
+                // the offsets point into the source text, including the comment
+                EXPECT_EQ(source.find("GeometryNode"), entry.m_offset);
+            }
+        } else if (ddl_trace_structure_end == entry.m_event) {
+            ++numEnds;
+        } else if (ddl_trace_data_list == entry.m_event) {
+            ++numLists;
+            if (0 == strcmp("float", entry.m_name)) {
+                EXPECT_EQ(2U, entry.m_size);
+            }
+        } else if (ddl_trace_allocation == entry.m_event) {
+            ++numAllocations;
+        }
+        if (i > 0) {
+            EXPECT_LE(entries[i - 1].m_nanoseconds, entry.m_nanoseconds);
+        }
+    }
+    EXPECT_EQ(3U, numBegins);
+    EXPECT_EQ(3U, numEnds);
+    EXPECT_EQ(2U, numLists);
+    EXPECT_LE(6U, numAllocations);
+
+    tracer.clear();
+    const std::string invalid("Metric {float {1, 2}");
+    parser.setBuffer(invalid.c_str(), invalid.size());
+    EXPECT_FALSE(parser.parse());
+    bool hasError(false);
+    const std::vector<RingBufferTracer::Entry> errors(tracer.getEntries());
+    for (size_t i = 0; i < errors.size(); ++i) {
+        hasError |= ddl_trace_error == errors[i].m_event;
+    }
+    EXPECT_TRUE(hasError);
+}
+
+END_ODDLPARSER_NS
@@ -0,0 +1,161 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2014-2025 Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "gtest/gtest.h"
+
+#include <openddlparser/DDLNode.h>
+#include <openddlparser/OpenDDLExport.h>
+#include <openddlparser/OpenDDLStream.h>
+#include <openddlparser/OpenDDLWriter.h>
+
+#include "UnitTestCommon.h"
+
+BEGIN_ODDLPARSER_NS
+
+class OpenDDLWriterTest : public testing::Test {
+    // empty
+};
+
+TEST_F(OpenDDLWriterTest, sameAsExportTest) {
+    static const char Document[] =
+            "Metric (key = \"distance\") { float { 1.5 } }\n"
+            "GeometryNode $node1\n"
+            "{\n"
+            "    ObjectRef { ref { $geometry1 } }\n"
+            "    Transform { float[4] { { 1, 0, 0, 0 }, { 0, 1, 0, 0.25 } } }\n"
+            "    Name { string { \"Box001\" } }\n"
+            "}\n";
+    OpenDDLParser parser(Document, strlen(Document));
+    ASSERT_TRUE(parser.parse());
+    std::string expected;
+    {
+        OpenDDLExport exporter(new MemoryStream(&expected));
+        ASSERT_TRUE(exporter.exportContext(parser.getContext(), ""));
+    }
+
+    std::string text;
+    MemoryStream stream(&text);
+    {
+        OpenDDLWriter writer(&stream);
+        const float one(1.5f);
+        EXPECT_TRUE(writer.beginStructure("Metric", nullptr, { WriterProperty("key", "distance") }));
+        EXPECT_TRUE(writer.writeDataList(&one, 1));
+        EXPECT_TRUE(writer.endStructure());
+
+        EXPECT_TRUE(writer.beginStructure("GeometryNode", "node1"));
+        EXPECT_EQ(1U, writer.getLevel());
+        const char *refs[] = { "geometry1" };
+        EXPECT_TRUE(writer.beginStructure("ObjectRef"));
+        EXPECT_TRUE(writer.writeReferences(refs, 1));
+        EXPECT_TRUE(writer.endStructure());
+
+        const float transform[] = { 1, 0, 0, 0, 0, 1, 0, 0.25f };
+        EXPECT_TRUE(writer.beginStructure("Transform"));
+        EXPECT_TRUE(writer.writeDataArray(transform, 8, 4));
+        EXPECT_TRUE(writer.endStructure());
+
+        const char *name[] = { "Box001" };
+        EXPECT_TRUE(writer.beginStructure("Name"));
+        EXPECT_TRUE(writer.writeDataList(name, 1));
+        EXPECT_TRUE(writer.endStructure());
+        EXPECT_TRUE(writer.endStructure());
+        EXPECT_FALSE(writer.endStructure());
+    }
+    EXPECT_EQ(expected, text);
+}
+
+TEST_F(OpenDDLWriterTest, writeTypesTest) {
+    std::string text;
+    MemoryStream stream(&text);
+    {
+        OpenDDLWriter writer(&stream);
+        const int64 values[] = { -9223372036854775807LL, 0, 42 };
+        const uint8 bytes[] = { 0, 255 };
+        const double reals[] = { 0.1, -2.5 };
+        const bool flags[] = { true, false };
+        writer.beginStructure("Values", "values", { WriterProperty("count", 3), WriterProperty::reference("link", "%local") });
+        writer.writeDataList(values, 3);
+        writer.endStructure();
+        writer.beginStructure("Bytes");
+        writer.writeDataArray(bytes, 2, 2);
+        writer.endStructure();
+        writer.beginStructure("Reals");
+        writer.writeDataList(reals, 2);
+        writer.endStructure();
+        writer.beginStructure("Flags");
+        writer.writeDataList(flags, 2);
+        writer.endStructure();
+        EXPECT_FALSE(writer.writeDataArray(reals, 2, 3));
+    }
+
+    EXPECT_NE(std::string::npos, text.find("Values $values (count = 3, link = %local)\n{\n    int64 { -9223372036854775807, 0, 42 }\n}\n"));
+    EXPECT_NE(std::string::npos, text.find("unsigned_int8[2] { { 0, 255 } }"));
+    EXPECT_NE(std::string::npos, text.find("double { 0.1, -2.5 }"));
+    EXPECT_NE(std::string::npos, text.find("bool { true, false }"));
+
+    OpenDDLParser parser(text.c_str(), text.size());
+    ASSERT_TRUE(parser.parse());
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(4U, nodes.size());
+    ASSERT_NE(nullptr, nodes[0]->findPropertyByName("count"));
+    ASSERT_NE(nullptr, nodes[0]->findPropertyByName("link"));
+    EXPECT_EQ(3, nodes[0]->findPropertyByName("count")->m_value->getInt32());
+    ASSERT_NE(nullptr, nodes[0]->getValue());
+    EXPECT_EQ(-9223372036854775807LL, nodes[0]->getValue()->getInt64());
+    ASSERT_NE(nullptr, nodes[2]->getValue());
+    EXPECT_EQ(0.1, nodes[2]->getValue()->getDouble());
+}
+
+TEST_F(OpenDDLWriterTest, dataArrayRoundTripTest) {
+    std::string text;
+    MemoryStream stream(&text);
+    const float values[] = { 1, 2, 3, 4, 5, 6 };
+    {
+        OpenDDLWriter writer(&stream);
+        writer.beginStructure("Pairs");
+        EXPECT_TRUE(writer.writeDataArray(values, 6, 2));
+        writer.endStructure();
+        writer.beginStructure("Singles");
+        EXPECT_FALSE(writer.writeDataArray(values, 2, 1));
+        EXPECT_TRUE(writer.writeDataList(values, 2));
+        writer.endStructure();
+    }
+    EXPECT_EQ(std::string::npos, text.find("{ { 1 }"));
+
+    OpenDDLParser parser(text.c_str(), text.size());
+    ASSERT_TRUE(parser.parse());
+    const DDLNode::DllNodeList &nodes(parser.getRoot()->getChildNodeList());
+    ASSERT_EQ(2U, nodes.size());
+    const DataArrayList *list(nodes[0]->getDataArrayList());
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_NE(nullptr, list);
+        ASSERT_EQ(2U, list->m_numItems);
+        EXPECT_EQ(values[2 * i], list->m_dataList->getFloat());
+        EXPECT_EQ(values[2 * i + 1], list->m_dataList->getNext()->getFloat());
+        list = list->m_next;
+    }
+    EXPECT_EQ(nullptr, list);
+    ASSERT_NE(nullptr, nodes[1]->getValue());
+    EXPECT_EQ(1.0f, nodes[1]->getValue()->getFloat());
+}
+
+END_ODDLPARSER_NS
@@ -24,6 +24,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <openddlparser/Value.h>
 
+#include <cmath>
+#include <limits>
+
 BEGIN_ODDLPARSER_NS
 
 class ValueTest : public testing::Test {
@@ -207,6 +210,18 @@ TEST_F( ValueTest, accessUInt64Test ) {
     ValueAllocator::releasePrimData( &data );
 }
 
+TEST_F( ValueTest, accessDoubleTest ) {
+    Value *data = ValueAllocator::allocPrimData(Value::ValueType::ddl_double);
+    data->setDouble( 3.141592653589793 );
+    EXPECT_EQ( 3.141592653589793, data->getDouble() );
+    ValueAllocator::releasePrimData( &data );
+
+    data = ValueAllocator::allocPrimData(Value::ValueType::ddl_float);
+    data->setFloat( 0.1f );
+    EXPECT_EQ( static_cast<double>(0.1f), data->getDouble() );
+    ValueAllocator::releasePrimData( &data );
+}
+
 TEST_F( ValueTest, accessReferenceTest ) {
     Reference *ref = new Reference;
     Name *name = new Name( GlobalName, new Text( "hello", 4 ) );
@@ -241,4 +256,113 @@ TEST_F(ValueTest, sizeTest) {
     delete data1;
 }
 
+static Value *appendValue(Value *prev, Value::ValueType type) {
+    Value *value(ValueAllocator::allocPrimData(type));
+    if (nullptr != prev) {
+        prev->m_next = value;
+    }
+
+    return value;
+}
+
+TEST_F(ValueTest, copyToTest) {
+    m_start = appendValue(nullptr, Value::ValueType::ddl_int16);
+    m_start->setInt16(-3);
+    Value *current(appendValue(m_start, Value::ValueType::ddl_int16));
+    current->setInt16(7);
+    current = appendValue(current, Value::ValueType::ddl_double);
+    current->setDouble(0.5);
+    current = appendValue(current, Value::ValueType::ddl_unsigned_int16);
+    current->setUnsignedInt16(0x3c00);
+    current = appendValue(current, Value::ValueType::ddl_string);
+
+    float floats[8] = {};
+    EXPECT_EQ(4U, m_start->copyTo(floats, 8));
+    EXPECT_FLOAT_EQ(-3.0f, floats[0]);
+    EXPECT_FLOAT_EQ(7.0f, floats[1]);
+    EXPECT_FLOAT_EQ(0.5f, floats[2]);
+    EXPECT_FLOAT_EQ(15360.0f, floats[3]);
+    EXPECT_FLOAT_EQ(0.0f, floats[4]);
+
+    int32 ints[2] = {};
+    EXPECT_EQ(2U, m_start->copyTo(ints, 2));
+    EXPECT_EQ(-3, ints[0]);
+    EXPECT_EQ(7, ints[1]);
+    EXPECT_EQ(0U, m_start->copyTo(static_cast<double *>(nullptr), 2));
+}
+
+TEST_F(ValueTest, copyHalfToTest) {
+    static const uint16 bits[] = { 0x3c00, 0xc000, 0x7bff, 0x0001, 0x8000, 0x7c00 };
+    static const size_t numBits(sizeof(bits) / sizeof(bits[0]));
+    Value *current(nullptr);
+    for (size_t i = 0; i < numBits; ++i) {
+        current = appendValue(current, Value::ValueType::ddl_half);
+        ::memcpy(current->m_data, &bits[i], sizeof(uint16));
+        if (nullptr == m_start) {
+            m_start = current;
+        }
+    }
+
+    float floats[numBits] = {};
+    ASSERT_EQ(numBits, m_start->copyTo(floats, numBits));
+    EXPECT_FLOAT_EQ(1.0f, floats[0]);
+    EXPECT_FLOAT_EQ(-2.0f, floats[1]);
+    EXPECT_FLOAT_EQ(65504.0f, floats[2]);
+    EXPECT_FLOAT_EQ(5.9604645e-8f, floats[3]);
+    EXPECT_FLOAT_EQ(0.0f, floats[4]);
+    EXPECT_TRUE(std::signbit(floats[4]));
+    EXPECT_TRUE(std::isinf(floats[5]));
+}
+
+TEST_F(ValueTest, copyOutOfRangeToIntTest) {
+    static const double doubles[] = { 1e10, -1e10, std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 300.7, -1.5 };
+    static const size_t numDoubles(sizeof(doubles) / sizeof(doubles[0]));
+    Value *current(nullptr);
+    for (size_t i = 0; i < numDoubles; ++i) {
+        current = appendValue(current, Value::ValueType::ddl_double);
+        current->setDouble(doubles[i]);
+        if (nullptr == m_start) {
+            m_start = current;
+        }
+    }
+    static const uint16 halfInf(0xfc00);
+    current = appendValue(current, Value::ValueType::ddl_half);
+    ::memcpy(current->m_data, &halfInf, sizeof(uint16));
+
+    // out-of-range values saturate, NaN becomes 0
+    int8 int8s[numDoubles + 1] = {};
+    ASSERT_EQ(numDoubles + 1, m_start->copyTo(int8s, numDoubles + 1));
+    EXPECT_EQ(127, int8s[0]);
+    EXPECT_EQ(-128, int8s[1]);
+    EXPECT_EQ(0, int8s[2]);
+    EXPECT_EQ(127, int8s[3]);
+    EXPECT_EQ(-128, int8s[4]);
+    EXPECT_EQ(127, int8s[5]);
+    EXPECT_EQ(-1, int8s[6]);
+    EXPECT_EQ(-128, int8s[7]);
+
+    uint32 uint32s[numDoubles + 1] = {};
+    ASSERT_EQ(numDoubles + 1, m_start->copyTo(uint32s, numDoubles + 1));
+    EXPECT_EQ(std::numeric_limits<uint32>::max(), uint32s[0]);
+    EXPECT_EQ(0U, uint32s[1]);
+    EXPECT_EQ(0U, uint32s[2]);
+    EXPECT_EQ(300U, uint32s[5]);
+    EXPECT_EQ(0U, uint32s[6]);
+    EXPECT_EQ(0U, uint32s[7]);
+
+    int64 int64s[numDoubles + 1] = {};
+    ASSERT_EQ(numDoubles + 1, m_start->copyTo(int64s, numDoubles + 1));
+    EXPECT_EQ(10000000000LL, int64s[0]);
+    EXPECT_EQ(std::numeric_limits<int64>::max(), int64s[3]);
+    EXPECT_EQ(std::numeric_limits<int64>::min(), int64s[4]);
+    EXPECT_EQ(std::numeric_limits<int64>::min(), int64s[7]);
+
+    uint64 uint64s[numDoubles + 1] = {};
+    ASSERT_EQ(numDoubles + 1, m_start->copyTo(uint64s, numDoubles + 1));
+    EXPECT_EQ(10000000000ULL, uint64s[0]);
+    EXPECT_EQ(std::numeric_limits<uint64>::max(), uint64s[3]);
+    EXPECT_EQ(0U, uint64s[4]);
+}
+
 END_ODDLPARSER_NS